@@ -12,6 +12,11 @@
 
 UFlareResourceCatalog::UFlareResourceCatalog(const class FObjectInitializer& PCIP)
 	: Super(PCIP)
+	, Food(NULL)
+	, Fuel(NULL)
+	, Tools(NULL)
+	, Tech(NULL)
+	, FleetSupply(NULL)
 {
 }
 
@@ -101,6 +106,29 @@ void UFlareResourceCatalog::InitialSetup(AFlareGame* GameMode)
 	ConsumerResources.Sort(SortByResourceType);
 	MaintenanceResources.Sort(SortByResourceType);
 
+	// Dense indices, for per-resource tables
+	for (int32 Index = 0; Index < Resources.Num(); Index++)
+	{
+		Resources[Index]->Data.CatalogIndex = Index;
+	}
+
+	// Identifier index, first entry wins as with a linear search
+	ResourcesByIdentifier.Empty(Resources.Num());
+	for (UFlareResourceCatalogEntry* Resource : Resources)
+	{
+		if (Resource && !ResourcesByIdentifier.Contains(Resource->Data.Identifier))
+		{
+			ResourcesByIdentifier.Add(Resource->Data.Identifier, Resource);
+		}
+	}
+
+	// Well-known resources
+	Food = Get("food");
+	Fuel = Get("fuel");
+	Tools = Get("tools");
+	Tech = Get("tech");
+	FleetSupply = Get("fleet-supply");
+
 	if (GetModifiedResources().Num() > 0)
 	{
 // Due to resources being directly referenced in the data we must find and alter all their direct references to the current version of the resource
@@ -210,12 +238,7 @@ void UFlareResourceCatalog::ReplaceOldEntrySettings(UFlareResourceCatalogEntry*
 
 FFlareResourceDescription* UFlareResourceCatalog::Get(FName Identifier) const
 {
-	auto FindByName = [=](const UFlareResourceCatalogEntry* Candidate)
-	{
-		return Candidate->Data.Identifier == Identifier;
-	};
-
-	UFlareResourceCatalogEntry* const* Entry = Resources.FindByPredicate(FindByName);
+	UFlareResourceCatalogEntry* const* Entry = ResourcesByIdentifier.Find(Identifier);
 	if (Entry && *Entry)
 	{
 		return &((*Entry)->Data);
@@ -226,12 +249,9 @@ FFlareResourceDescription* UFlareResourceCatalog::Get(FName Identifier) const
 
 UFlareResourceCatalogEntry* UFlareResourceCatalog::GetEntry(FFlareResourceDescription* Resource) const
 {
-	for (int32 ResourceIndex = 0; ResourceIndex < Resources.Num(); ResourceIndex++)
+	if (Resource && Resources.IsValidIndex(Resource->CatalogIndex) && Resource == &Resources[Resource->CatalogIndex]->Data)
 	{
-		if(Resource == &Resources[ResourceIndex]->Data)
-		{
-			return Resources[ResourceIndex];
-		}
+		return Resources[Resource->CatalogIndex];
 	}
 	return NULL;
 }
\ No newline at end of file
@@ -32,6 +32,18 @@ public:
 	UPROPERTY(EditAnywhere, Category = Content)
 	TArray<UFlareResourceCatalogEntry*> MaintenanceResources;
 
+	/** Well-known resources, resolved once at setup */
+	FFlareResourceDescription*          Food;
+	FFlareResourceDescription*          Fuel;
+	FFlareResourceDescription*          Tools;
+	FFlareResourceDescription*          Tech;
+	FFlareResourceDescription*          FleetSupply;
+
+protected:
+
+	/** Resources by identifier */
+	TMap<FName, UFlareResourceCatalogEntry*> ResourcesByIdentifier;
+
 public:
 
 	/*----------------------------------------------------
@@ -43,8 +55,6 @@ public:
 		return ModifiedResources;
 	}
 
-	/** Get a resource from identifier */
-
 	void InitialSetup(AFlareGame* GameMode);
 
 	void ReplaceOldEntrySettings(UFlareResourceCatalogEntry* OldResourceEntry, UFlareResourceCatalogEntry* NewResource);
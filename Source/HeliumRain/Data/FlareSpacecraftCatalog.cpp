@@ -215,6 +215,23 @@ void UFlareSpacecraftCatalog::InitialSetup(AFlareGame* GameMode)
 
 	StationCatalog.Sort(FSortByEntrySize());
 	ShipCatalog.Sort(FSortByEntrySize());
+
+	// Identifier index, ships first as with a linear search
+	SpacecraftsByIdentifier.Empty(ShipCatalog.Num() + StationCatalog.Num());
+	for (UFlareSpacecraftCatalogEntry* Spacecraft : ShipCatalog)
+	{
+		if (Spacecraft && !SpacecraftsByIdentifier.Contains(Spacecraft->Data.Identifier))
+		{
+			SpacecraftsByIdentifier.Add(Spacecraft->Data.Identifier, Spacecraft);
+		}
+	}
+	for (UFlareSpacecraftCatalogEntry* Spacecraft : StationCatalog)
+	{
+		if (Spacecraft && !SpacecraftsByIdentifier.Contains(Spacecraft->Data.Identifier))
+		{
+			SpacecraftsByIdentifier.Add(Spacecraft->Data.Identifier, Spacecraft);
+		}
+	}
 }
 
 void UFlareSpacecraftCatalog::ReplaceOldEntrySettings(FFlareSpacecraftDescription* OldEntryDesc, UFlareSpacecraftCatalogEntry* Spacecraft)
@@ -315,18 +332,7 @@ const void UFlareSpacecraftCatalog::GetStationList(TArray<FFlareSpacecraftDescri
 
 FFlareSpacecraftDescription* UFlareSpacecraftCatalog::Get(FName Identifier) const
 {
-	auto FindByName = [=](const UFlareSpacecraftCatalogEntry* Candidate)
-	{
-		return Candidate->Data.Identifier == Identifier;
-	};
-
-	UFlareSpacecraftCatalogEntry* const* Entry = ShipCatalog.FindByPredicate(FindByName);
-	if (Entry && *Entry)
-	{
-		return &((*Entry)->Data);
-	}
-
-	Entry = StationCatalog.FindByPredicate(FindByName);
+	UFlareSpacecraftCatalogEntry* const* Entry = SpacecraftsByIdentifier.Find(Identifier);
 	if (Entry && *Entry)
 	{
 		return &((*Entry)->Data);
@@ -26,6 +26,11 @@ public:
 	UPROPERTY(EditAnywhere, Category = Content)
 	TArray<UFlareSpacecraftCatalogEntry*> StationCatalog;
 
+protected:
+
+	/** Ships then stations, by identifier */
+	TMap<FName, UFlareSpacecraftCatalogEntry*> SpacecraftsByIdentifier;
+
 public:
 
 	/*----------------------------------------------------
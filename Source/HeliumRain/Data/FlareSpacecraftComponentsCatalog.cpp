@@ -125,6 +125,19 @@ void UFlareSpacecraftComponentsCatalog::InitialSetup(AFlareGame* GameMode)
 	EngineCatalog.Sort(SortByCost);
 	RCSCatalog.Sort(SortByCost);
 	WeaponCatalog.Sort(SortByWeaponType);
+
+	// Identifier index, in the order of a linear search
+	ComponentsByIdentifier.Empty();
+	for (TArray<UFlareSpacecraftComponentsCatalogEntry*>* Catalog : { &EngineCatalog, &RCSCatalog, &WeaponCatalog, &InternalComponentsCatalog, &MetaCatalog })
+	{
+		for (UFlareSpacecraftComponentsCatalogEntry* Component : *Catalog)
+		{
+			if (Component && !ComponentsByIdentifier.Contains(Component->Data.Identifier))
+			{
+				ComponentsByIdentifier.Add(Component->Data.Identifier, Component);
+			}
+		}
+	}
 }
 
 void UFlareSpacecraftComponentsCatalog::SetupModArrays(TArray<UFlareSpacecraftComponentsCatalogEntry*>& PassedArray)
@@ -340,56 +353,13 @@ void UFlareSpacecraftComponentsCatalog::ReplaceOldEntrySettings(FFlareSpacecraft
 
 FFlareSpacecraftComponentDescription* UFlareSpacecraftComponentsCatalog::Get(FName Identifier) const
 {
-	FFlareSpacecraftComponentDescription* Part = NULL;
-
-	auto FindByName = [=](const UFlareSpacecraftComponentsCatalogEntry* Candidate)
+	UFlareSpacecraftComponentsCatalogEntry* const* Entry = ComponentsByIdentifier.Find(Identifier);
+	if (Entry && *Entry)
 	{
-		return Candidate && Candidate->Data.Identifier == Identifier;
-	};
-
-	UFlareSpacecraftComponentsCatalogEntry* const* Temp = EngineCatalog.FindByPredicate(FindByName);
-	if (Temp)
-	{
-		Part = &(*Temp)->Data;
-	}
-
-	if (!Part)
-	{
-		Temp = RCSCatalog.FindByPredicate(FindByName);
-		if (Temp)
-		{
-			Part = &(*Temp)->Data;
-		}
-	}
-
-	if (!Part)
-	{
-		Temp = WeaponCatalog.FindByPredicate(FindByName);
-		if (Temp)
-		{
-			Part = &(*Temp)->Data;
-		}
-	}
-
-	if (!Part)
-	{
-		Temp = InternalComponentsCatalog.FindByPredicate(FindByName);
-		if (Temp)
-		{
-			Part = &(*Temp)->Data;
-		}
-	}
-	
-	if (!Part)
-	{
-		Temp = MetaCatalog.FindByPredicate(FindByName);
-		if (Temp)
-		{
-			Part = &(*Temp)->Data;
-		}
+		return &((*Entry)->Data);
 	}
 
-	return Part;
+	return NULL;
 }
 
 const void UFlareSpacecraftComponentsCatalog::GetEngineList(TArray<FFlareSpacecraftComponentDescription*>& OutData, TEnumAsByte<EFlarePartSize::Type> Size, UFlareCompany* FilterCompany, UFlareSimulatedSpacecraft* FilterShip, FFlareSpacecraftComponentDescription* IgnoreDescription)
@@ -35,6 +35,11 @@ public:
 	UPROPERTY(EditAnywhere, Category = Content)
 	TArray<UFlareSpacecraftComponentsCatalogEntry*> MetaCatalog;
 
+protected:
+
+	/** All components, by identifier */
+	TMap<FName, UFlareSpacecraftComponentsCatalogEntry*> ComponentsByIdentifier;
+
 public:
 
 	/*----------------------------------------------------
@@ -54,6 +54,15 @@ UFlareTechnologyCatalog::UFlareTechnologyCatalog(const class FObjectInitializer&
 			}
 		}
 	}
+
+	// Identifier index, first entry wins as with a linear search
+	for (UFlareTechnologyCatalogEntry* Technology : TechnologyCatalog)
+	{
+		if (Technology && !TechnologiesByIdentifier.Contains(Technology->Data.Identifier))
+		{
+			TechnologiesByIdentifier.Add(Technology->Data.Identifier, Technology);
+		}
+	}
 }
 
 
@@ -63,12 +72,7 @@ UFlareTechnologyCatalog::UFlareTechnologyCatalog(const class FObjectInitializer&
 
 FFlareTechnologyDescription* UFlareTechnologyCatalog::Get(FName Identifier) const
 {
-	auto FindByName = [=](const UFlareTechnologyCatalogEntry* Candidate)
-	{
-		return Candidate->Data.Identifier == Identifier;
-	};
-
-	UFlareTechnologyCatalogEntry* const* Entry = TechnologyCatalog.FindByPredicate(FindByName);
+	UFlareTechnologyCatalogEntry* const* Entry = TechnologiesByIdentifier.Find(Identifier);
 	if (Entry && *Entry)
 	{
 		return &((*Entry)->Data);
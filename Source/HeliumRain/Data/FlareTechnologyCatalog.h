@@ -23,6 +23,11 @@ public:
 	//First is what tech level
 	TMap<int32, TArray<FFlareTechnologyDescription*>> TechnologiesByLevel;
 
+protected:
+
+	/** Technologies by identifier */
+	TMap<FName, UFlareTechnologyCatalogEntry*> TechnologiesByIdentifier;
+
 public:
 
 	/*----------------------------------------------------
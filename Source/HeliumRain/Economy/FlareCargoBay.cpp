@@ -7,6 +7,8 @@
 #include "../Data/FlareResourceCatalog.h"
 
 #include "../Game/FlareGame.h"
+#include "../Game/FlareWorld.h"
+#include "../Game/FlareSimulatedSector.h"
 #include "../Quests/FlareQuestManager.h"
 
 #include "../Spacecrafts/FlareSimulatedSpacecraft.h"
@@ -194,6 +196,8 @@ int32 UFlareCargoBay::TakeResources(FFlareResourceDescription* Resource, int32 Q
 		return 0;
 	}
 
+	OnCargoChanged();
+
 	// First pass: take resource from the less full cargo
 	int32 MinQuantity = 0;
 	FFlareCargo* MinQuantityCargo = NULL;
@@ -275,6 +279,8 @@ void UFlareCargoBay::DumpCargo(FFlareCargo* Cargo)
 	{
 		Cargo->Resource = NULL;
 	}
+
+	OnCargoChanged();
 }
 
 int32 UFlareCargoBay::GiveResources(FFlareResourceDescription* Resource, int32 Quantity, UFlareCompany* Client, uint8 CheckRestrictionContext, bool IgnoresRestrictionNobody)
@@ -286,6 +292,8 @@ int32 UFlareCargoBay::GiveResources(FFlareResourceDescription* Resource, int32 Q
 		return Quantity;
 	}
 
+	OnCargoChanged();
+
 	// First pass, fill already existing slots
 	for (int CargoIndex = 0 ; CargoIndex < CargoBay.Num() ; CargoIndex++)
 	{
@@ -565,6 +573,7 @@ bool UFlareCargoBay::LockSlot(FFlareResourceDescription* Resource, EFlareResourc
 		{
 			Cargo.Lock = LockType;
 			Cargo.ManualLock = ManualLock;
+			OnLocksChanged();
 			return true;
 		}
 	}
@@ -578,6 +587,7 @@ bool UFlareCargoBay::LockSlot(FFlareResourceDescription* Resource, EFlareResourc
 			Cargo.ManualLock = ManualLock;
 			Cargo.Resource = Resource;
 			Cargo.Quantity = 0;
+			OnLocksChanged();
 			return true;
 		}
 	}
@@ -599,6 +609,8 @@ void UFlareCargoBay::HideUnlockedSlots()
 
 void UFlareCargoBay::UnlockAll(bool IgnoreManualLock)
 {
+	bool LocksChanged = false;
+
 	for (int CargoIndex = 0; CargoIndex < CargoBay.Num() ; CargoIndex++)
 	{
 		FFlareCargo& Cargo = CargoBay[CargoIndex];
@@ -612,6 +624,7 @@ void UFlareCargoBay::UnlockAll(bool IgnoreManualLock)
 
 			Cargo.Lock = EFlareResourceLock::NoLock;
 			Cargo.ManualLock = false;
+			LocksChanged = true;
 
 			if (Cargo.Quantity == 0)
 			{
@@ -619,6 +632,29 @@ void UFlareCargoBay::UnlockAll(bool IgnoreManualLock)
 			}
 		}
 	}
+
+	if (LocksChanged)
+	{
+		OnLocksChanged();
+	}
+}
+
+void UFlareCargoBay::OnLocksChanged()
+{
+	if (Parent->IsStation() && Parent->GetCurrentSector())
+	{
+		Parent->GetCurrentSector()->InvalidateTradeStationIndex();
+	}
+
+	OnCargoChanged();
+}
+
+void UFlareCargoBay::OnCargoChanged()
+{
+	if (Game->GetGameWorld())
+	{
+		Game->GetGameWorld()->InvalidateEconomySnapshot();
+	}
 }
 
 TEnumAsByte<EFlareResourceRestriction::Type> UFlareCargoBay::RotateSlotRestriction(int32 SlotIndex)
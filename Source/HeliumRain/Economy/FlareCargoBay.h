@@ -65,6 +65,12 @@ public:
 
 protected:
 
+	/** Slot locks changed, hubs may now trade other resources */
+	void OnLocksChanged();
+
+	/** Stock or slot resources changed, world economy stats are outdated */
+	void OnCargoChanged();
+
 	/*----------------------------------------------------
 	   Protected data
 	----------------------------------------------------*/
@@ -282,6 +282,7 @@ void UFlareFactory::Start()
 	}
 
 	FactoryData.Active = true;
+	Game->GetGameWorld()->InvalidateEconomySnapshot();
 }
 
 void UFlareFactory::StartShipBuilding(FFlareShipyardOrderSave& Order)
@@ -300,11 +301,13 @@ void UFlareFactory::StartShipBuilding(FFlareShipyardOrderSave& Order)
 void UFlareFactory::Pause()
 {
 	FactoryData.Active = false;
+	Game->GetGameWorld()->InvalidateEconomySnapshot();
 }
 
 void UFlareFactory::Stop()
 {
 	FactoryData.Active = false;
+	Game->GetGameWorld()->InvalidateEconomySnapshot();
 	CancelProduction();
 }
 
@@ -177,10 +177,10 @@ void UFlarePeople::Simulate()
 
 void UFlarePeople::SimulateResourcePurchase()
 {
-	FFlareResourceDescription* Food = Game->GetResourceCatalog()->Get("food");
-	FFlareResourceDescription* Fuel = Game->GetResourceCatalog()->Get("fuel");
-	FFlareResourceDescription* Tool = Game->GetResourceCatalog()->Get("tools");
-	FFlareResourceDescription* Tech = Game->GetResourceCatalog()->Get("tech");
+	FFlareResourceDescription* Food = Game->GetResourceCatalog()->Food;
+	FFlareResourceDescription* Fuel = Game->GetResourceCatalog()->Fuel;
+	FFlareResourceDescription* Tool = Game->GetResourceCatalog()->Tools;
+	FFlareResourceDescription* Tech = Game->GetResourceCatalog()->Tech;
 
 	bool LockNext = false;
 
@@ -514,10 +514,10 @@ uint32 UFlarePeople::BuyInStationForCompany(FFlareResourceDescription* Resource,
 
 float UFlarePeople::GetRessourceConsumption(FFlareResourceDescription* Resource, bool WithStock)
 {
-	FFlareResourceDescription* Food = Game->GetResourceCatalog()->Get("food");
-	FFlareResourceDescription* Fuel = Game->GetResourceCatalog()->Get("fuel");
-	FFlareResourceDescription* Tools = Game->GetResourceCatalog()->Get("tools");
-	FFlareResourceDescription* Tech = Game->GetResourceCatalog()->Get("tech");
+	FFlareResourceDescription* Food = Game->GetResourceCatalog()->Food;
+	FFlareResourceDescription* Fuel = Game->GetResourceCatalog()->Fuel;
+	FFlareResourceDescription* Tools = Game->GetResourceCatalog()->Tools;
+	FFlareResourceDescription* Tech = Game->GetResourceCatalog()->Tech;
 
 	if (PeopleData.Population == 0)
 	{
@@ -778,21 +778,31 @@ void UFlarePeople::Pay(uint32 Amount)
 {
 	//FLOGV("Pay to people for sector %s Amount=%f", *Parent->GetSectorName().ToString(), Amount/100.)
 
+	PayTo(PeopleData.Money, PeopleData.Dept, Amount);
+}
+
+void UFlarePeople::TakeMoney(uint32 Amount)
+{
+	TakeMoneyFrom(PeopleData.Money, PeopleData.Dept, Amount);
+}
+
+void UFlarePeople::PayTo(uint32& Money, uint32& Dept, uint32 Amount)
+{
 	uint32 Repayment = 0;
-	if(PeopleData.Dept > 0)
+	if(Dept > 0)
 	{
-		Repayment = FMath::Min(PeopleData.Dept, Amount / 10);
-		PeopleData.Dept -= Repayment;
+		Repayment = FMath::Min(Dept, Amount / 10);
+		Dept -= Repayment;
 	}
-	PeopleData.Money += Amount - Repayment;
+	Money += Amount - Repayment;
 }
 
-void UFlarePeople::TakeMoney(uint32 Amount)
+void UFlarePeople::TakeMoneyFrom(uint32& Money, uint32& Dept, uint32 Amount)
 {
-	uint32 TakenMoney = FMath::Min(PeopleData.Money, Amount);
-	PeopleData.Money -=  TakenMoney;
+	uint32 TakenMoney = FMath::Min(Money, Amount);
+	Money -=  TakenMoney;
 
-	PeopleData.Dept += Amount - TakenMoney;
+	Dept += Amount - TakenMoney;
 }
 
 void UFlarePeople::ResetPeople()
@@ -810,10 +820,10 @@ void UFlarePeople::ResetPeople()
 
 void UFlarePeople::PrintInfo()
 {
-	FFlareResourceDescription* Food = Game->GetResourceCatalog()->Get("food");
-	FFlareResourceDescription* Fuel = Game->GetResourceCatalog()->Get("fuel");
-	FFlareResourceDescription* Tools = Game->GetResourceCatalog()->Get("tools");
-	FFlareResourceDescription* Tech = Game->GetResourceCatalog()->Get("tech");
+	FFlareResourceDescription* Food = Game->GetResourceCatalog()->Food;
+	FFlareResourceDescription* Fuel = Game->GetResourceCatalog()->Fuel;
+	FFlareResourceDescription* Tools = Game->GetResourceCatalog()->Tools;
+	FFlareResourceDescription* Tech = Game->GetResourceCatalog()->Tech;
 
 
 
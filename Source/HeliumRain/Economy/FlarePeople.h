@@ -131,6 +131,11 @@ public:
 
 	void TakeMoney(uint32 Amount);
 
+	/** Pay and take money on raw values, for batch updates outside of a people object */
+	static void PayTo(uint32& Money, uint32& Dept, uint32 Amount);
+
+	static void TakeMoneyFrom(uint32& Money, uint32& Dept, uint32 Amount);
+
 	void ResetPeople();
 
 	void PrintInfo();
@@ -67,6 +67,9 @@ struct FFlareResourceDescription
 
 	/** Higher numbers override older numbers in the event of a conflict*/
 	UPROPERTY(EditAnywhere, Category = Content) int ModLoadPriority;
+
+	/** Index in UFlareResourceCatalog::Resources, set when the catalog is loaded */
+	int32 CatalogIndex = INDEX_NONE;
 };
 
 /** Spacecraft cargo data */
@@ -4,6 +4,7 @@
 #include "../FlareCompany.h"
 #include "../FlareSectorHelper.h"
 #include "../FlareScenarioTools.h"
+#include "../FlareGameTools.h"
 
 #include "../../Data/FlareResourceCatalog.h"
 
@@ -17,6 +18,7 @@
 #include "../../Spacecrafts/Subsystems/FlareSimulatedSpacecraftDamageSystem.h"
 
 #include "FlareAIBehavior.h"
+#include "Async/ParallelFor.h"
 #include <functional>
 
 
@@ -25,6 +27,9 @@ DECLARE_CYCLE_STAT(TEXT("AITradeHelper FindBestDealForShip"), STAT_AITradeHelper
 DECLARE_CYCLE_STAT(TEXT("AITradeHelper FindBestDealForShip Sectors"), STAT_AITradeHelper_FindBestDealForShip_Sectors, STATGROUP_Flare);
 DECLARE_CYCLE_STAT(TEXT("AITradeHelper FindBestDealForShip Loop"), STAT_AITradeHelper_FindBestDealForShip_Loop, STATGROUP_Flare);
 DECLARE_CYCLE_STAT(TEXT("AITradeHelper ApplyDeal"), STAT_AITradeHelper_ApplyDeal, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("AITradeHelper GenerateTradingNeeds"), STAT_AITradeHelper_GenerateTradingNeeds, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("AITradeHelper GenerateTradingSources"), STAT_AITradeHelper_GenerateTradingSources, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("AITradeHelper GenerateIdleShips"), STAT_AITradeHelper_GenerateIdleShips, STATGROUP_Flare);
 
 
 
@@ -50,11 +55,41 @@ DECLARE_CYCLE_STAT(TEXT("AITradeHelper ApplyDeal"), STAT_AITradeHelper_ApplyDeal
 
 #define LOCTEXT_NAMESPACE "AITradeHelper"
 
+/*----------------------------------------------------
+	World variation
+----------------------------------------------------*/
+
+void WorldVariation::Init(UFlareWorld* World)
+{
+	SectorVariations.Reset();
+	SectorVariations.SetNum(World->GetSectors().Num());
+}
+
+void WorldVariation::Add(UFlareSimulatedSector* Sector, SectorVariation const& Variation)
+{
+	SectorVariations[Sector->GetWorldIndex()] = Variation;
+}
+
+SectorVariation& WorldVariation::operator[](UFlareSimulatedSector* Sector)
+{
+	return SectorVariations[Sector->GetWorldIndex()];
+}
+
+SectorVariation const& WorldVariation::operator[](UFlareSimulatedSector* Sector) const
+{
+	return SectorVariations[Sector->GetWorldIndex()];
+}
+
+
+/*----------------------------------------------------
+	Auto trade
+----------------------------------------------------*/
+
 void AITradeHelper::CompanyAutoTrade(UFlareCompany* Company)
 {
 	Company->GetAI()->GetBehavior()->Load(Company);
-	TMap<UFlareSimulatedSector*, SectorVariation> WorldResourceVariation;
-	WorldResourceVariation.Reserve(Company->GetVisitedSectors().Num());
+	WorldVariation WorldResourceVariation;
+	WorldResourceVariation.Init(Company->GetGame()->GetGameWorld());
 	for (int32 SectorIndex = 0; SectorIndex < Company->GetVisitedSectors().Num(); SectorIndex++)
 	{
 		UFlareSimulatedSector* Sector = Company->GetVisitedSectors()[SectorIndex];
@@ -130,7 +165,7 @@ UFlareSimulatedSpacecraft* AITradeHelper::FindBestMasterShip(int32& UsableShipCo
 	return MasterShip;
 }
 
-void AITradeHelper::FleetAutoTrade(UFlareFleet* Fleet, TMap<UFlareSimulatedSector*, SectorVariation>& WorldResourceVariation)
+void AITradeHelper::FleetAutoTrade(UFlareFleet* Fleet, WorldVariation& WorldResourceVariation)
 {
 	if(Fleet->IsTrading() || Fleet->IsTraveling())
 	{
@@ -283,7 +318,7 @@ TArray<UFlareSimulatedSpacecraft*> AITradeHelper::FindIdleCargos(UFlareCompany*
 	return IdleCargos;
 }
 
-SectorDeal AITradeHelper::FindBestDealForShipFromSector(UFlareSimulatedSpacecraft* Ship, UFlareSimulatedSector* SectorA, SectorDeal* DealToBeat, TMap<UFlareSimulatedSector*, SectorVariation> const& WorldResourceVariation, UFlareSimulatedSector* SectorBRestiction)
+SectorDeal AITradeHelper::FindBestDealForShipFromSector(UFlareSimulatedSpacecraft* Ship, UFlareSimulatedSector* SectorA, SectorDeal* DealToBeat, WorldVariation const& WorldResourceVariation, UFlareSimulatedSector* SectorBRestiction)
 {
 	SCOPE_CYCLE_COUNTER(STAT_AITradeHelper_FindBestDealForShipFromSector);
 
@@ -318,7 +353,7 @@ SectorDeal AITradeHelper::FindBestDealForShipFromSector(UFlareSimulatedSpacecraf
 }
 
 
-SectorDeal AITradeHelper::FindBestDealForShipToSector(UFlareSimulatedSpacecraft* Ship, UFlareSimulatedSector* SectorA, UFlareSimulatedSector* SectorB, SectorDeal* DealToBeat, TMap<UFlareSimulatedSector*, SectorVariation> const& WorldResourceVariation, UFlareSimulatedSector* SectorBRestiction)
+SectorDeal AITradeHelper::FindBestDealForShipToSector(UFlareSimulatedSpacecraft* Ship, UFlareSimulatedSector* SectorA, UFlareSimulatedSector* SectorB, SectorDeal* DealToBeat, WorldVariation const& WorldResourceVariation, UFlareSimulatedSector* SectorBRestiction)
 {
 	UFlareCompany* Company = Ship->GetCompany();
 	AFlareGame* Game = Ship->GetGame();
@@ -378,8 +413,8 @@ SectorDeal AITradeHelper::FindBestDealForShipToSector(UFlareSimulatedSpacecraft*
 	for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 	{
 		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-		struct ResourceVariation const* VariationA = &SectorVariationA->ResourceVariations[Resource];
-		struct ResourceVariation const* VariationB = &SectorVariationB->ResourceVariations[Resource];
+		struct ResourceVariation const* VariationA = &SectorVariationA->ResourceVariations[ResourceIndex];
+		struct ResourceVariation const* VariationB = &SectorVariationB->ResourceVariations[ResourceIndex];
 
 		//FLOGV("- Check for %s", *Resource->Name.ToString());
 
@@ -690,7 +725,7 @@ SectorDeal AITradeHelper::FindBestDealForShipToSector(UFlareSimulatedSpacecraft*
 	return BestDeal;
 }
 
-SectorDeal AITradeHelper::FindBestDealForShip(UFlareSimulatedSpacecraft* Ship, TMap<UFlareSimulatedSector*, SectorVariation>& WorldResourceVariation, UFlareSimulatedSector* SectorARestiction, UFlareSimulatedSector* SectorBRestiction)
+SectorDeal AITradeHelper::FindBestDealForShip(UFlareSimulatedSpacecraft* Ship, WorldVariation& WorldResourceVariation, UFlareSimulatedSector* SectorARestiction, UFlareSimulatedSector* SectorBRestiction)
 {
 	SCOPE_CYCLE_COUNTER(STAT_AITradeHelper_FindBestDealForShip);
 
@@ -744,7 +779,7 @@ SectorDeal AITradeHelper::FindBestDealForShip(UFlareSimulatedSpacecraft* Ship, T
 				int32 UsedIncomingCapacity = FMath::Min(SectorBestDeal.BuyQuantity, SectorVariationA->IncomingCapacity);
 
 				SectorVariationA->IncomingCapacity -= UsedIncomingCapacity;
-				struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[SectorBestDeal.Resource];
+				struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[SectorBestDeal.Resource->CatalogIndex];
 				VariationA->OwnedStock -= UsedIncomingCapacity;
 			}
 			else
@@ -762,7 +797,7 @@ SectorDeal AITradeHelper::FindBestDealForShip(UFlareSimulatedSpacecraft* Ship, T
 	return BestDeal;
 }
 
-void AITradeHelper::ApplyDeal(UFlareSimulatedSpacecraft* Ship, SectorDeal const&Deal, TMap<UFlareSimulatedSector*, SectorVariation>* WorldResourceVariation, bool AllowTravel, bool AllowUseNoTradeForMe)
+void AITradeHelper::ApplyDeal(UFlareSimulatedSpacecraft* Ship, SectorDeal const&Deal, WorldVariation* WorldResourceVariation, bool AllowTravel, bool AllowUseNoTradeForMe)
 {
 	SCOPE_CYCLE_COUNTER(STAT_AITradeHelper_ApplyDeal);
 
@@ -880,7 +915,7 @@ void AITradeHelper::ApplyDeal(UFlareSimulatedSpacecraft* Ship, SectorDeal const&
 				{
 					// Virtualy decrease the stock for other ships in sector A
 					SectorVariation* SectorVariationA = &(*WorldResourceVariation)[Deal.SectorA];
-					struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[Deal.Resource];
+					struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[Deal.Resource->CatalogIndex];
 					VariationA->OwnedStock -= BroughtResource;
 
 
@@ -889,14 +924,14 @@ void AITradeHelper::ApplyDeal(UFlareSimulatedSpacecraft* Ship, SectorDeal const&
 					SectorVariationB->IncomingCapacity += BroughtResource;
 
 					// Virtualy decrease the capacity for other ships in sector B
-					struct ResourceVariation* VariationB = &SectorVariationB->ResourceVariations[Deal.Resource];
+					struct ResourceVariation* VariationB = &SectorVariationB->ResourceVariations[Deal.Resource->CatalogIndex];
 					VariationB->OwnedCapacity -= BroughtResource;
 				}
 				else if (BroughtResource == 0)
 				{
 					// Failed to buy the promised resources, remove the deal from the list
 					SectorVariation* SectorVariationA = &(*WorldResourceVariation)[Deal.SectorA];
-					struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[Deal.Resource];
+					struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[Deal.Resource->CatalogIndex];
 					VariationA->FactoryStock = 0;
 					VariationA->OwnedStock = 0;
 					VariationA->StorageStock = 0;
@@ -943,14 +978,14 @@ void AITradeHelper::ApplyDeal(UFlareSimulatedSpacecraft* Ship, SectorDeal const&
 		{
 			// Reserve the deal by virtualy decrease the stock for other ships
 			SectorVariation* SectorVariationA = &(*WorldResourceVariation)[Deal.SectorA];
-			struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[Deal.Resource];
+			struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[Deal.Resource->CatalogIndex];
 			VariationA->OwnedStock -= Deal.BuyQuantity;
 			// Virtualy say some capacity arrive in sector B
 			SectorVariation* SectorVariationB = &(*WorldResourceVariation)[Deal.SectorB];
 			SectorVariationB->IncomingCapacity += Deal.BuyQuantity;
 
 			// Virtualy decrease the capacity for other ships in sector B
-			struct ResourceVariation* VariationB = &SectorVariationB->ResourceVariations[Deal.Resource];
+			struct ResourceVariation* VariationB = &SectorVariationB->ResourceVariations[Deal.Resource->CatalogIndex];
 			VariationB->OwnedCapacity -= Deal.BuyQuantity;
 		}
 	}
@@ -1035,11 +1070,10 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 #endif
 
 	SectorVariation SectorVariation;
-	SectorVariation.ResourceVariations.Reserve(Game->GetResourceCatalog()->Resources.Num());
+	SectorVariation.ResourceVariations.SetNumUninitialized(Game->GetResourceCatalog()->Resources.Num());
 	for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 	{
-		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-		struct ResourceVariation ResourceVariation;
+		struct ResourceVariation& ResourceVariation = SectorVariation.ResourceVariations[ResourceIndex];
 		ResourceVariation.OwnedFlow = 0;
 		ResourceVariation.FactoryFlow = 0;
 		ResourceVariation.OwnedStock = 0;
@@ -1055,8 +1089,6 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 		ResourceVariation.ConsumerMaxStock = 0;
 		ResourceVariation.MaintenanceMaxStock = 0;
 		ResourceVariation.HighPriority = 0;
-
-		SectorVariation.ResourceVariations.Add(Resource, ResourceVariation);
 	}
 
 	int32 OwnedCustomerStation = 0;
@@ -1088,7 +1120,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 		for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 		{
 			FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-			struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+			struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->CatalogIndex];
 
 			int32 Stock = 0;
 			int32 Capacity = 0;
@@ -1190,7 +1222,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 			for (int32 ResourceIndex = 0; ResourceIndex < Factory->GetInputResourcesCount(); ResourceIndex++)
 			{
 				FFlareResourceDescription* Resource = Factory->GetInputResource(ResourceIndex);
-				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->CatalogIndex];
 
 				int64 ProductionDuration = Factory->GetProductionDuration();
 				if (ProductionDuration == 0)
@@ -1236,7 +1268,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 			for (int32 ResourceIndex = 0; ResourceIndex < Factory->GetOutputResourcesCount(); ResourceIndex++)
 			{
 				FFlareResourceDescription* Resource = Factory->GetOutputResource(ResourceIndex);
-				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->CatalogIndex];
 
 				int64 ProductionDuration = Factory->GetProductionDuration();
 				if (ProductionDuration == 0)
@@ -1285,7 +1317,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 				for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->ConsumerResources.Num(); ResourceIndex++)
 				{
 					FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->ConsumerResources[ResourceIndex]->Data;
-					struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+					struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->CatalogIndex];
 
 					Variation->ConsumerMaxStock += Station->GetActiveCargoBay()->GetSlotCapacity();
 				}
@@ -1297,7 +1329,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 				for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->MaintenanceResources.Num(); ResourceIndex++)
 				{
 					FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->MaintenanceResources[ResourceIndex]->Data;
-					struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+					struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->CatalogIndex];
 
 
 					Variation->MaintenanceMaxStock += Station->GetActiveCargoBay()->GetSlotCapacity();
@@ -1310,7 +1342,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 				for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 				{
 					FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-					struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+					struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->CatalogIndex];
 
 					int32 ResourceQuantity = Station->GetActiveCargoBay()->GetResourceQuantity(Resource, ClientCompany);
 					int32 MaxCapacity = Station->GetActiveCargoBay()->GetFreeSpaceForResource(Resource, ClientCompany);
@@ -1349,7 +1381,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 		for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->ConsumerResources.Num(); ResourceIndex++)
 		{
 			FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->ConsumerResources[ResourceIndex]->Data;
-			struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+			struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->CatalogIndex];
 
 
 			int32 Consumption = Sector->GetPeople()->GetRessourceConsumption(Resource, false);
@@ -1400,7 +1432,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 						{
 							continue;
 						}
-						struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Cargo.Resource];
+						struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Cargo.Resource->CatalogIndex];
 
 						Variation->IncomingResources += Cargo.Quantity / (RemainingTravelDuration * 0.5);
 					}
@@ -1413,7 +1445,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 	for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->MaintenanceResources.Num(); ResourceIndex++)
 	{
 		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->MaintenanceResources[ResourceIndex]->Data;
-		struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+		struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->CatalogIndex];
 
 		for (int CompanyIndex = 0; CompanyIndex < Game->GetGameWorld()->GetCompanies().Num(); CompanyIndex++)
 		{
@@ -1477,483 +1509,703 @@ inline static int32 NeedComparatorComparator(const AITradeNeed& n1, const AITrad
 		return n1.HighPriority > n2.HighPriority;
 }
 
-// New trading
-void AITradeHelper::GenerateTradingNeeds(AITradeNeeds& Needs, AITradeNeeds& MaintenanceNeeds, AITradeNeeds& StorageNeeds, UFlareWorld* World)
+/*----------------------------------------------------
+	Trading setup jobs
+----------------------------------------------------*/
+
+/* Buffers filled by one trading setup job, merged in job order */
+struct AITradeGenerationBuffer
 {
-	// Trading needs
-	UFlareScenarioTools* ST = World->GetGame()->GetScenarioTools();
+	TArray<AITradeNeed> Needs;
+	TArray<AITradeNeed> StorageNeeds;
+	TArray<AITradeNeed> MaintenanceNeeds;
+	TArray<AITradeSource> Sources;
+	TArray<AITradeSource> MaintenanceSources;
+	TArray<AIIdleShip> IdleShips;
+};
+
+/* Same generated entry, cache slots are not compared */
+static bool IsSameTradeEntry(const AITradeNeed& A, const AITradeNeed& B)
+{
+	return A.Ratio == B.Ratio
+		&& A.Quantity == B.Quantity
+		&& A.TotalCapacity == B.TotalCapacity
+		&& A.Resource == B.Resource
+		&& A.Company == B.Company
+		&& A.Sector == B.Sector
+		&& A.Station == B.Station
+		&& A.SourceFunctionIndex == B.SourceFunctionIndex
+		&& A.SourceFunctionIndexIterationsPerTry == B.SourceFunctionIndexIterationsPerTry
+		&& A.Maintenance == B.Maintenance
+		&& A.HighPriority == B.HighPriority;
+}
 
-	int32 GameDifficulty = -1;
-	GameDifficulty = World->GetGame()->GetPC()->GetPlayerData()->DifficultyId;
-	
-	int32 PlayerPriority = 0 - GameDifficulty;
+static bool IsSameTradeEntry(const AITradeSource& A, const AITradeSource& B)
+{
+	return A == B
+		&& A.Resource == B.Resource
+		&& A.Quantity == B.Quantity
+		&& A.Stranded == B.Stranded
+		&& A.Traveling == B.Traveling;
+}
 
-	for(UFlareCompany* Company : World->GetCompanies())
+static bool IsSameTradeEntry(const AIIdleShip& A, const AIIdleShip& B)
+{
+	return A.Ship == B.Ship
+		&& A.Company == B.Company
+		&& A.Sector == B.Sector
+		&& A.Capacity == B.Capacity
+		&& A.Traveling == B.Traveling
+		&& A.Stranded == B.Stranded;
+}
+
+template<typename ElementType>
+static int32 CountTradeEntryMismatches(const TArray<ElementType>& Parallel, const TArray<ElementType>& Serial)
+{
+	int32 Mismatches = FMath::Abs(Parallel.Num() - Serial.Num());
+	for (int32 Index = 0; Index < FMath::Min(Parallel.Num(), Serial.Num()); Index++)
+	{
+		if (!IsSameTradeEntry(Parallel[Index], Serial[Index]))
+		{
+			Mismatches++;
+		}
+	}
+	return Mismatches;
+}
+
+/* Run the jobs again on this thread and log entries that differ from the parallel buffers */
+template<typename JobType>
+static void CompareTradeGeneration(const TCHAR* Name, const TArray<AITradeGenerationBuffer>& Buffers, JobType Job)
+{
+	if (!UFlareGameTools::ParallelTradeGeneration || !UFlareGameTools::CompareTradeGeneration)
+	{
+		return;
+	}
+
+	int32 Mismatches = 0;
+	for (int32 Index = 0; Index < Buffers.Num(); Index++)
+	{
+		const AITradeGenerationBuffer& Parallel = Buffers[Index];
+		AITradeGenerationBuffer Serial;
+		Job(Index, Serial);
+
+		Mismatches += CountTradeEntryMismatches(Parallel.Needs, Serial.Needs);
+		Mismatches += CountTradeEntryMismatches(Parallel.StorageNeeds, Serial.StorageNeeds);
+		Mismatches += CountTradeEntryMismatches(Parallel.MaintenanceNeeds, Serial.MaintenanceNeeds);
+		Mismatches += CountTradeEntryMismatches(Parallel.Sources, Serial.Sources);
+		Mismatches += CountTradeEntryMismatches(Parallel.MaintenanceSources, Serial.MaintenanceSources);
+		Mismatches += CountTradeEntryMismatches(Parallel.IdleShips, Serial.IdleShips);
+	}
+
+	if (Mismatches > 0)
 	{
-		for(UFlareSimulatedSpacecraft* Station : Company->GetCompanyStations())
+		FLOGV("AITradeHelper::%s : parallel generation differs from serial generation on %d entries", Name, Mismatches);
+	}
+	else
+	{
+		FLOGV("AITradeHelper::%s : parallel generation matches serial generation", Name);
+	}
+}
+
+static void GenerateCompanyTradingNeeds(UFlareCompany* Company, UFlareWorld* World, UFlareCompany* PlayerCompany, int32 PlayerPriority, TArray<AITradeNeed>& Needs, TArray<AITradeNeed>& StorageNeeds)
+{
+	UFlareScenarioTools* ST = World->GetGame()->GetScenarioTools();
+
+	for(UFlareSimulatedSpacecraft* Station : Company->GetCompanyStations())
+	{
+		bool IsConstruction = Station->IsUnderConstruction();
+		bool IsShipyard = Station->IsShipyardAllFactories();
+		bool HasLicense = Station->GetOwnerHasStationLicense();
+
+		for(UFlareResourceCatalogEntry* ResourceEntry : World->GetGame()->GetResourceCatalog()->Resources)
 		{
-			bool IsConstruction = Station->IsUnderConstruction();
-			bool IsShipyard = Station->IsShipyardAllFactories();
-			bool HasLicense = Station->GetOwnerHasStationLicense();
+			FFlareResourceDescription* Resource = &ResourceEntry->Data;
 
-			for(UFlareResourceCatalogEntry* ResourceEntry : World->GetGame()->GetResourceCatalog()->Resources)
+			if(Station->GetActiveCargoBay()->WantBuy(Resource, nullptr))
 			{
-				FFlareResourceDescription* Resource = &ResourceEntry->Data;
+				int32 Quantity = 0;
+				bool QuantityAboveTradingMinQuantity = false;
 
-				if(Station->GetActiveCargoBay()->WantBuy(Resource, nullptr))
+				if (!IsConstruction && Station->IsComplex())
 				{
-					int32 Quantity = 0;
-					bool QuantityAboveTradingMinQuantity = false;
-
-					if (!IsConstruction && Station->IsComplex())
+					if(Station->GetActiveCargoBay()->WantBuy(Resource, Company) && Station->GetActiveCargoBay()->WantSell(Resource, Company))
 					{
-						if(Station->GetActiveCargoBay()->WantBuy(Resource, Company) && Station->GetActiveCargoBay()->WantSell(Resource, Company))
-						{
-							int32 TotalCapacity = Station->GetActiveCargoBay()->GetTotalCapacityForResource(Resource, Company);
-							Quantity = FMath::Max(0, Quantity - TotalCapacity / 2);
-						}
-						else
-						{
-							Quantity = Station->GetActiveCargoBay()->GetFreeSpaceForResource(Resource, nullptr);
-						}
+						int32 TotalCapacity = Station->GetActiveCargoBay()->GetTotalCapacityForResource(Resource, Company);
+						Quantity = FMath::Max(0, Quantity - TotalCapacity / 2);
 					}
 					else
 					{
 						Quantity = Station->GetActiveCargoBay()->GetFreeSpaceForResource(Resource, nullptr);
 					}
+				}
+				else
+				{
+					Quantity = Station->GetActiveCargoBay()->GetFreeSpaceForResource(Resource, nullptr);
+				}
 
-					if (Quantity > TRADING_MIN_NEED_QUANTITY)
-					{
-						QuantityAboveTradingMinQuantity = true;
-					}			
+				if (Quantity > TRADING_MIN_NEED_QUANTITY)
+				{
+					QuantityAboveTradingMinQuantity = true;
+				}			
+
+				if(QuantityAboveTradingMinQuantity || (IsConstruction && Quantity > 0) || (IsShipyard && Quantity > 0 && float(Station->GetActiveCargoBay()->GetResourceQuantity(Resource, Company) / Station->GetActiveCargoBay()->GetTotalCapacityForResource(Resource, Company)) <= 0.95))
+				{
+					AITradeNeed Need;
+					Need.Resource = Resource;
+					Need.Quantity = Quantity;
+					Need.TotalCapacity = Station->GetActiveCargoBay()->GetTotalCapacityForResource(Resource, nullptr);
+					Need.Company = Station->GetCompany();
+					Need.Sector = Station->GetCurrentSector();
+					Need.Station = Station;
+					Need.SourceFunctionIndex = 0;
+					Need.SourceFunctionIndexIterationsPerTry = 1;
+					Need.HighPriority = 0;
+					Need.Maintenance = false;
+					Need.Consume(0); // Generate ratio
 
-					if(QuantityAboveTradingMinQuantity || (IsConstruction && Quantity > 0) || (IsShipyard && Quantity > 0 && float(Station->GetActiveCargoBay()->GetResourceQuantity(Resource, Company) / Station->GetActiveCargoBay()->GetTotalCapacityForResource(Resource, Company)) <= 0.95))
+					if (Company == PlayerCompany)
 					{
-						AITradeNeed Need;
-						Need.Resource = Resource;
-						Need.Quantity = Quantity;
-						Need.TotalCapacity = Station->GetActiveCargoBay()->GetTotalCapacityForResource(Resource, nullptr);
-						Need.Company = Station->GetCompany();
-						Need.Sector = Station->GetCurrentSector();
-						Need.Station = Station;
-						Need.SourceFunctionIndex = 0;
-						Need.SourceFunctionIndexIterationsPerTry = 1;
-						Need.HighPriority = 0;
-						Need.Maintenance = false;
-						Need.Consume(0); // Generate ratio
-
-						if (Company == World->GetGame()->GetPC()->GetCompany())
+						Need.HighPriority = PlayerPriority;
+						if (IsConstruction && HasLicense)
+						{
+							Need.HighPriority += 15;
+						}
+
+						if (IsShipyard && Station->IsAllowExternalOrder())
 						{
-							Need.HighPriority = PlayerPriority;
-							if (IsConstruction && HasLicense)
+							Need.HighPriority += 15;
+							if (QuantityAboveTradingMinQuantity)
 							{
-								Need.HighPriority += 15;
+								Need.SourceFunctionIndexIterationsPerTry += 1;
 							}
+						}
+					}
 
-							if (IsShipyard && Station->IsAllowExternalOrder())
+					else
+					{
+						if (IsConstruction)
+						{
+							Need.HighPriority += 20;
+							if (HasLicense)
 							{
-								Need.HighPriority += 15;
-								if (QuantityAboveTradingMinQuantity)
-								{
-									Need.SourceFunctionIndexIterationsPerTry += 1;
-								}
+								Need.SourceFunctionIndexIterationsPerTry += 2;
+							}
+							else
+							{
+								Need.SourceFunctionIndexIterationsPerTry += 1;
 							}
 						}
 
-						else
+						if (IsShipyard && Station->IsAllowExternalOrder())
 						{
-							if (IsConstruction)
+							if (Company == ST->Pirates)
 							{
 								Need.HighPriority += 20;
-								if (HasLicense)
-								{
-									Need.SourceFunctionIndexIterationsPerTry += 2;
-								}
-								else
+								if (QuantityAboveTradingMinQuantity)
 								{
 									Need.SourceFunctionIndexIterationsPerTry += 1;
 								}
 							}
-
-							if (IsShipyard && Station->IsAllowExternalOrder())
+							else
 							{
-								if (Company == ST->Pirates)
-								{
-									Need.HighPriority += 20;
-									if (QuantityAboveTradingMinQuantity)
-									{
-										Need.SourceFunctionIndexIterationsPerTry += 1;
-									}
-								}
-								else
+								Need.HighPriority += 30;
+								if (QuantityAboveTradingMinQuantity)
 								{
-									Need.HighPriority += 30;
-									if (QuantityAboveTradingMinQuantity)
-									{
-										Need.SourceFunctionIndexIterationsPerTry += 2;
-									}
+									Need.SourceFunctionIndexIterationsPerTry += 2;
 								}
 							}
 						}
+					}
 
-						if (Company != World->GetGame()->GetPC()->GetCompany() && !IsConstruction && !IsShipyard)
+					if (Company != PlayerCompany && !IsConstruction && !IsShipyard)
+					{
+						int32 FactoriesAtMinimumEfficiency = 0;
+						uint32 SeekingCycles = 14;
+						if (!HasLicense)
 						{
-							int32 FactoriesAtMinimumEfficiency = 0;
-							uint32 SeekingCycles = 14;
-							if (!HasLicense)
-							{
-								SeekingCycles /= 2;
-							}
+							SeekingCycles /= 2;
+						}
 
-							for (int32 FactoryIndex = 0; FactoryIndex < Station->GetFactories().Num(); FactoryIndex++)
+						for (int32 FactoryIndex = 0; FactoryIndex < Station->GetFactories().Num(); FactoryIndex++)
+						{
+							UFlareFactory* Factory = Station->GetFactories()[FactoryIndex];
+							if (Factory->OwnerCompanyHasRequiredTechnologies())
 							{
-								UFlareFactory* Factory = Station->GetFactories()[FactoryIndex];
-								if (Factory->OwnerCompanyHasRequiredTechnologies())
+								uint32 InputQuantityCycles = Factory->GetInputResourceQuantityCycles(Resource);
+								if (InputQuantityCycles >= 0 && InputQuantityCycles < SeekingCycles)
 								{
-									uint32 InputQuantityCycles = Factory->GetInputResourceQuantityCycles(Resource);
-									if (InputQuantityCycles >= 0 && InputQuantityCycles < SeekingCycles)
 									{
-										{
-											Need.HighPriority += (SeekingCycles - InputQuantityCycles);
-										}
-
-										// If the factory is down to minimum efficiency that indicates it may have been without resources for some time
-										if (Factory->GetFactoryEfficiency() >= Factory->GetFactoryEfficiency_Minimum())
-										{
-											FactoriesAtMinimumEfficiency++;
-										}
+										Need.HighPriority += (SeekingCycles - InputQuantityCycles);
+									}
+
+									// If the factory is down to minimum efficiency that indicates it may have been without resources for some time
+									if (Factory->GetFactoryEfficiency() >= Factory->GetFactoryEfficiency_Minimum())
+									{
+										FactoriesAtMinimumEfficiency++;
 									}
 								}
 							}
+						}
 
-							Need.HighPriority *= float(1 + (FactoriesAtMinimumEfficiency * 0.50));
+						Need.HighPriority *= float(1 + (FactoriesAtMinimumEfficiency * 0.50));
 
-							if (HasLicense)
+						if (HasLicense)
+						{
+							if (FactoriesAtMinimumEfficiency > 0 ||
+								Need.Quantity >= Need.TotalCapacity*0.90)
 							{
-								if (FactoriesAtMinimumEfficiency > 0 ||
-									Need.Quantity >= Need.TotalCapacity*0.90)
-								{
-									Need.SourceFunctionIndexIterationsPerTry += 1;
-								}
-
-								//have absolutely no resources in the slot, increase priority
-								if (Need.Quantity == Need.TotalCapacity)
-								{
-									Need.HighPriority += Station->GetLevel();
-								}
+								Need.SourceFunctionIndexIterationsPerTry += 1;
 							}
-							/*
-							if (Station->HasCapability(EFlareSpacecraftCapability::Consumer))
+
+							//have absolutely no resources in the slot, increase priority
+							if (Need.Quantity == Need.TotalCapacity)
 							{
+								Need.HighPriority += Station->GetLevel();
 							}
-							*/
-						}
-
-						if(Station->HasCapability(EFlareSpacecraftCapability::Storage) && !IsConstruction)
-						{
-							StorageNeeds.List.Add(Need);
 						}
-						else
+						/*
+						if (Station->HasCapability(EFlareSpacecraftCapability::Consumer))
 						{
-							Needs.List.Add(Need);
 						}
+						*/
+					}
+
+					if(Station->HasCapability(EFlareSpacecraftCapability::Storage) && !IsConstruction)
+					{
+						StorageNeeds.Add(Need);
+					}
+					else
+					{
+						Needs.Add(Need);
 					}
 				}
 			}
 		}
 	}
+}
 
-	// Maintenance needs
-	for(UFlareSimulatedSector* Sector : World->GetSectors())
+static void GenerateSectorMaintenanceNeeds(UFlareSimulatedSector* Sector, UFlareWorld* World, TArray<AITradeNeed>& MaintenanceNeeds)
+{
+	for(UFlareCompany* Company : World->GetCompanies())
 	{
-		for(UFlareCompany* Company : World->GetCompanies())
-		{
-			int32 CurrentNeededFleetSupply = 0;
-			int32 RepairTotalNeededFleetSupply = 0;
-			int32 RefillTotalNeededFleetSupply = 0;
-			int64 MaxDuration = 0;
+		int32 CurrentNeededFleetSupply = 0;
+		int32 RepairTotalNeededFleetSupply = 0;
+		int32 RefillTotalNeededFleetSupply = 0;
+		int64 MaxDuration = 0;
 
-			SectorHelper::GetRepairFleetSupplyNeeds(Sector, Company, CurrentNeededFleetSupply, RepairTotalNeededFleetSupply, MaxDuration, true);
-			SectorHelper::GetRefillFleetSupplyNeeds(Sector, Company, CurrentNeededFleetSupply, RefillTotalNeededFleetSupply, MaxDuration, true);
+		SectorHelper::GetRepairFleetSupplyNeeds(Sector, Company, CurrentNeededFleetSupply, RepairTotalNeededFleetSupply, MaxDuration, true);
+		SectorHelper::GetRefillFleetSupplyNeeds(Sector, Company, CurrentNeededFleetSupply, RefillTotalNeededFleetSupply, MaxDuration, true);
 
-			int32 TotalNeededFleetSupply = RepairTotalNeededFleetSupply + RefillTotalNeededFleetSupply;
-
-			if(TotalNeededFleetSupply > 0)
-			{
-				AITradeNeed Need;
-				Need.Resource = World->GetGame()->GetScenarioTools()->FleetSupply;
-				Need.Quantity = TotalNeededFleetSupply;
-				Need.TotalCapacity = TotalNeededFleetSupply * (MaxDuration +1);
-				Need.Company = Company;
-				Need.Sector = Sector;
-				Need.Station = nullptr;
-				Need.SourceFunctionIndex = 0;
-				Need.SourceFunctionIndexIterationsPerTry = 1;
-				Need.Maintenance = true;
-				Need.HighPriority = true;
-				Need.Consume(0); // Generate ratio
-				MaintenanceNeeds.List.Add(Need);
-			}
+		int32 TotalNeededFleetSupply = RepairTotalNeededFleetSupply + RefillTotalNeededFleetSupply;
 
+		if(TotalNeededFleetSupply > 0)
+		{
+			AITradeNeed Need;
+			Need.Resource = World->GetGame()->GetScenarioTools()->FleetSupply;
+			Need.Quantity = TotalNeededFleetSupply;
+			Need.TotalCapacity = TotalNeededFleetSupply * (MaxDuration +1);
+			Need.Company = Company;
+			Need.Sector = Sector;
+			Need.Station = nullptr;
+			Need.SourceFunctionIndex = 0;
+			Need.SourceFunctionIndexIterationsPerTry = 1;
+			Need.Maintenance = true;
+			Need.HighPriority = true;
+			Need.Consume(0); // Generate ratio
+			MaintenanceNeeds.Add(Need);
 		}
+
 	}
-#if DEBUG_NEW_AI_TRADING
-//	Needs.List.Sort(&NeedComparatorComparator);
-#endif
 }
 
-void AITradeHelper::GenerateTradingSources(AITradeSources& Sources, AITradeSources& MaintenanceSources, UFlareWorld* World)
+static void GenerateCompanyTradingSources(UFlareCompany* Company, UFlareWorld* World, TArray<AITradeSource>& Sources, TArray<AITradeSource>& MaintenanceSources)
 {
-	for(UFlareCompany* Company : World->GetCompanies())
+	for(UFlareSimulatedSpacecraft* Station : Company->GetCompanyStations())
 	{
-		for(UFlareSimulatedSpacecraft* Station : Company->GetCompanyStations())
+		bool Construction = Station->IsUnderConstruction();
+		bool Complex = Station->IsComplex();
+
+		for(UFlareResourceCatalogEntry* ResourceEntry : World->GetGame()->GetResourceCatalog()->Resources)
 		{
-			bool Construction = Station->IsUnderConstruction();
-			bool Complex = Station->IsComplex();
+			FFlareResourceDescription* Resource = &ResourceEntry->Data;
+			bool MaintenanceSource = false;
 
-			for(UFlareResourceCatalogEntry* ResourceEntry : World->GetGame()->GetResourceCatalog()->Resources)
+			if(Station->GetActiveCargoBay()->WantSell(Resource, nullptr))
 			{
-				FFlareResourceDescription* Resource = &ResourceEntry->Data;
-				bool MaintenanceSource = false;
-
-				if(Station->GetActiveCargoBay()->WantSell(Resource, nullptr))
+				if(Station->GetActiveCargoBay()->WantBuy(Resource, nullptr) && !Station->HasCapability(EFlareSpacecraftCapability::Storage))
 				{
-					if(Station->GetActiveCargoBay()->WantBuy(Resource, nullptr) && !Station->HasCapability(EFlareSpacecraftCapability::Storage))
+					if(Resource->IsMaintenanceResource)
 					{
-						if(Resource->IsMaintenanceResource)
-						{
-							MaintenanceSource = true;
-						}
-						else
-						{
-							FLOGV("DEBUG : %d", Station->IsComplex());
-							check(Station->IsComplex() == true);
-							// Trade to not use as source
-						}
+						MaintenanceSource = true;
+					}
+					else
+					{
+						FLOGV("DEBUG : %d", Station->IsComplex());
+						check(Station->IsComplex() == true);
+						// Trade to not use as source
 					}
+				}
 
-					int32 Quantity = Station->GetActiveCargoBay()->GetResourceQuantity(Resource, nullptr);
+				int32 Quantity = Station->GetActiveCargoBay()->GetResourceQuantity(Resource, nullptr);
 
-					if (!Construction && Complex)
+				if (!Construction && Complex)
+				{
+					if(Station->GetActiveCargoBay()->WantBuy(Resource, Company) && Station->GetActiveCargoBay()->WantSell(Resource, Company))
 					{
-						if(Station->GetActiveCargoBay()->WantBuy(Resource, Company) && Station->GetActiveCargoBay()->WantSell(Resource, Company))
-						{
-							int32 TotalCapacity = Station->GetActiveCargoBay()->GetTotalCapacityForResource(Resource, Company);
-							Quantity = FMath::Max(0, Quantity - TotalCapacity / 2);
-						}
+						int32 TotalCapacity = Station->GetActiveCargoBay()->GetTotalCapacityForResource(Resource, Company);
+						Quantity = FMath::Max(0, Quantity - TotalCapacity / 2);
 					}
+				}
 
-					if(Quantity > 0)
+				if(Quantity > 0)
+				{
+					AITradeSource Source;
+					Source.Resource = Resource;
+					Source.Quantity = Quantity;
+					Source.Company = Station->GetCompany();
+					Source.Sector = Station->GetCurrentSector();
+					Source.Station = Station;
+					Source.Ship = nullptr;
+					if(MaintenanceSource)
 					{
-						AITradeSource Source;
-						Source.Resource = Resource;
-						Source.Quantity = Quantity;
-						Source.Company = Station->GetCompany();
-						Source.Sector = Station->GetCurrentSector();
-						Source.Station = Station;
-						Source.Ship = nullptr;
-						if(MaintenanceSource)
-						{
-							MaintenanceSources.Add(Source);
-						}
-						else
-						{
-							Sources.Add(Source);
-						}
+						MaintenanceSources.Add(Source);
+					}
+					else
+					{
+						Sources.Add(Source);
 					}
 				}
 			}
 		}
+	}
 
-		if (Company->IsPlayerCompany())
-		{
-			continue;
-		}
+	if (Company->IsPlayerCompany())
+	{
+		return;
+	}
 
-		for (UFlareSimulatedSpacecraft* Ship : Company->GetCompanyShips())
+	for (UFlareSimulatedSpacecraft* Ship : Company->GetCompanyShips())
+	{
+		if (Ship->IsMilitary())
 		{
-			if (Ship->IsMilitary())
-			{
-				if (Company->GetWarCount(Company) > 0)
-				{
-					continue;
-				}
-				else if (Ship->GetActiveCargoBay()->GetCapacity() == 0)
-				{
-					continue;
-				}
-			}
-
-			if (Ship->GetDescription()->IsDroneCarrier || Ship->GetDescription()->IsDroneShip)
+			if (Company->GetWarCount(Company) > 0)
 			{
 				continue;
 			}
-
-			if (Ship->GetDamageSystem()->IsUncontrollable() || Ship->IsTrading())
+			else if (Ship->GetActiveCargoBay()->GetCapacity() == 0)
 			{
 				continue;
 			}
-
-			for (UFlareResourceCatalogEntry* ResourceEntry : World->GetGame()->GetResourceCatalog()->Resources)
-			{
-				FFlareResourceDescription* Resource = &ResourceEntry->Data;
-				int32 Quantity = Ship->GetActiveCargoBay()->GetResourceQuantity(Resource, nullptr);
-				if (Quantity > 0)
-				{
-					bool Traveling = Ship->GetCurrentFleet()->IsTraveling();
-					AITradeSource Source;
-					Source.Resource = Resource;
-					Source.Quantity = Quantity;
-					Source.Company = Ship->GetCompany();
-					Source.Sector = Traveling ? Ship->GetCurrentFleet()->GetCurrentTravel()->GetDestinationSector() : Ship->GetCurrentSector();
-					Source.Station = nullptr;
-					Source.Ship = Ship;
-					Source.Stranded = Ship->GetDamageSystem()->IsStranded();
-					Source.Traveling = Traveling;
-					Sources.Add(Source);
-				}
-			}
 		}
-	}
 
-	Sources.GenerateCache();
-	MaintenanceSources.GenerateCache();
-}
+		if (Ship->GetDescription()->IsDroneCarrier || Ship->GetDescription()->IsDroneShip)
+		{
+			continue;
+		}
 
-void AITradeHelper::GenerateIdleShips(AITradeIdleShips& Ships, UFlareWorld* World)
-{
-	for(UFlareCompany* Company : World->GetCompanies())
-	{
-		if(Company->IsPlayerCompany())
+		if (Ship->GetDamageSystem()->IsUncontrollable() || Ship->IsTrading())
 		{
 			continue;
 		}
 
-		for(UFlareSimulatedSpacecraft* Ship : Company->GetCompanyShips())
+		for (UFlareResourceCatalogEntry* ResourceEntry : World->GetGame()->GetResourceCatalog()->Resources)
 		{
-			if (Ship->IsMilitary())
+			FFlareResourceDescription* Resource = &ResourceEntry->Data;
+			int32 Quantity = Ship->GetActiveCargoBay()->GetResourceQuantity(Resource, nullptr);
+			if (Quantity > 0)
 			{
-				if (Ship->GetActiveCargoBay()->GetCapacity() == 0)
-				{
-					continue;
-				}
-				else if (Company->GetWarCount(Company) > 0)
-				{
-					continue;
-				}
+				bool Traveling = Ship->GetCurrentFleet()->IsTraveling();
+				AITradeSource Source;
+				Source.Resource = Resource;
+				Source.Quantity = Quantity;
+				Source.Company = Ship->GetCompany();
+				Source.Sector = Traveling ? Ship->GetCurrentFleet()->GetCurrentTravel()->GetDestinationSector() : Ship->GetCurrentSector();
+				Source.Station = nullptr;
+				Source.Ship = Ship;
+				Source.Stranded = Ship->GetDamageSystem()->IsStranded();
+				Source.Traveling = Traveling;
+				Sources.Add(Source);
 			}
+		}
+	}
+}
 
-			if (Ship->GetDescription()->IsDroneCarrier || Ship->GetDescription()->IsDroneShip)
-			{
-				continue;
-			}
+static void GenerateCompanyIdleShips(UFlareCompany* Company, TArray<AIIdleShip>& Ships)
+{
+	if(Company->IsPlayerCompany())
+	{
+		return;
+	}
 
-			if(Ship->GetDamageSystem()->IsUncontrollable() || Ship->IsTrading())
+	for(UFlareSimulatedSpacecraft* Ship : Company->GetCompanyShips())
+	{
+		if (Ship->IsMilitary())
+		{
+			if (Ship->GetActiveCargoBay()->GetCapacity() == 0)
 			{
 				continue;
 			}
-
-			if(Ship->GetActiveCargoBay()->GetUsedCargoSpace() > 0)
+			else if (Company->GetWarCount(Company) > 0)
 			{
 				continue;
 			}
+		}
+
+		if (Ship->GetDescription()->IsDroneCarrier || Ship->GetDescription()->IsDroneShip)
+		{
+			continue;
+		}
 
-			bool Traveling = Ship->GetCurrentFleet()->IsTraveling();
-			AIIdleShip IdleShip;
-			IdleShip.Company = Ship->GetCompany();
-			IdleShip.Capacity = Ship->GetActiveCargoBay()->GetCapacity();
-			IdleShip.Ship = Ship;
-			IdleShip.Sector = Traveling ? Ship->GetCurrentFleet()->GetCurrentTravel()->GetDestinationSector() : Ship->GetCurrentSector();
-			IdleShip.Stranded = Ship->GetDamageSystem()->IsStranded();
-			IdleShip.Traveling = Traveling;
-			Ships.Add(IdleShip);
+		if(Ship->GetDamageSystem()->IsUncontrollable() || Ship->IsTrading())
+		{
+			continue;
+		}
+
+		if(Ship->GetActiveCargoBay()->GetUsedCargoSpace() > 0)
+		{
+			continue;
 		}
+
+		bool Traveling = Ship->GetCurrentFleet()->IsTraveling();
+		AIIdleShip IdleShip;
+		IdleShip.Company = Ship->GetCompany();
+		IdleShip.Capacity = Ship->GetActiveCargoBay()->GetCapacity();
+		IdleShip.Ship = Ship;
+		IdleShip.Sector = Traveling ? Ship->GetCurrentFleet()->GetCurrentTravel()->GetDestinationSector() : Ship->GetCurrentSector();
+		IdleShip.Stranded = Ship->GetDamageSystem()->IsStranded();
+		IdleShip.Traveling = Traveling;
+		Ships.Add(IdleShip);
 	}
+}
 
-	Ships.GenerateCache();
 
+/*----------------------------------------------------
+	Trading setup
+----------------------------------------------------*/
+
+void AITradeHelper::GenerateTradingNeeds(AITradeNeeds& Needs, AITradeNeeds& MaintenanceNeeds, AITradeNeeds& StorageNeeds, UFlareWorld* World)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AITradeHelper_GenerateTradingNeeds);
+
+	int32 GameDifficulty = -1;
+	GameDifficulty = World->GetGame()->GetPC()->GetPlayerData()->DifficultyId;
+	
+	int32 PlayerPriority = 0 - GameDifficulty;
+	UFlareCompany* PlayerCompany = World->GetGame()->GetPC()->GetCompany();
+
+	// Trading needs, one job per company
+	const TArray<UFlareCompany*>& Companies = World->GetCompanies();
+	TArray<AITradeGenerationBuffer> CompanyBuffers;
+	CompanyBuffers.SetNum(Companies.Num());
+
+	auto CompanyNeedsJob = [&](int32 CompanyIndex, AITradeGenerationBuffer& Buffer)
+	{
+		GenerateCompanyTradingNeeds(Companies[CompanyIndex], World, PlayerCompany, PlayerPriority, Buffer.Needs, Buffer.StorageNeeds);
+	};
+
+	ParallelFor(Companies.Num(), [&](int32 CompanyIndex)
+	{
+		CompanyNeedsJob(CompanyIndex, CompanyBuffers[CompanyIndex]);
+	}, !UFlareGameTools::ParallelTradeGeneration);
+	CompareTradeGeneration(TEXT("GenerateTradingNeeds"), CompanyBuffers, CompanyNeedsJob);
+
+	for (AITradeGenerationBuffer& Buffer : CompanyBuffers)
+	{
+		Needs.List.Append(Buffer.Needs);
+		StorageNeeds.List.Append(Buffer.StorageNeeds);
+	}
+
+	// Maintenance needs, one job per sector
+	const TArray<UFlareSimulatedSector*>& Sectors = World->GetSectors();
+	TArray<AITradeGenerationBuffer> SectorBuffers;
+	SectorBuffers.SetNum(Sectors.Num());
+
+	auto SectorNeedsJob = [&](int32 SectorIndex, AITradeGenerationBuffer& Buffer)
+	{
+		GenerateSectorMaintenanceNeeds(Sectors[SectorIndex], World, Buffer.MaintenanceNeeds);
+	};
+
+	ParallelFor(Sectors.Num(), [&](int32 SectorIndex)
+	{
+		SectorNeedsJob(SectorIndex, SectorBuffers[SectorIndex]);
+	}, !UFlareGameTools::ParallelTradeGeneration);
+	CompareTradeGeneration(TEXT("GenerateTradingNeeds (maintenance)"), SectorBuffers, SectorNeedsJob);
+
+	for (AITradeGenerationBuffer& Buffer : SectorBuffers)
+	{
+		MaintenanceNeeds.List.Append(Buffer.MaintenanceNeeds);
+	}
+
+#if DEBUG_NEW_AI_TRADING
+//	Needs.List.Sort(&NeedComparatorComparator);
+#endif
+}
+
+void AITradeHelper::GenerateTradingSources(AITradeSources& Sources, AITradeSources& MaintenanceSources, UFlareWorld* World)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AITradeHelper_GenerateTradingSources);
+
+	const TArray<UFlareCompany*>& Companies = World->GetCompanies();
+	TArray<AITradeGenerationBuffer> CompanyBuffers;
+	CompanyBuffers.SetNum(Companies.Num());
+
+	auto CompanySourcesJob = [&](int32 CompanyIndex, AITradeGenerationBuffer& Buffer)
+	{
+		GenerateCompanyTradingSources(Companies[CompanyIndex], World, Buffer.Sources, Buffer.MaintenanceSources);
+	};
+
+	ParallelFor(Companies.Num(), [&](int32 CompanyIndex)
+	{
+		CompanySourcesJob(CompanyIndex, CompanyBuffers[CompanyIndex]);
+	}, !UFlareGameTools::ParallelTradeGeneration);
+	CompareTradeGeneration(TEXT("GenerateTradingSources"), CompanyBuffers, CompanySourcesJob);
+
+	for (AITradeGenerationBuffer& Buffer : CompanyBuffers)
+	{
+		Sources.Sources.Append(Buffer.Sources);
+		MaintenanceSources.Sources.Append(Buffer.MaintenanceSources);
+	}
 
+	Sources.GenerateCache();
+	MaintenanceSources.GenerateCache();
 }
 
+void AITradeHelper::GenerateIdleShips(AITradeIdleShips& Ships, UFlareWorld* World)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AITradeHelper_GenerateIdleShips);
+
+	const TArray<UFlareCompany*>& Companies = World->GetCompanies();
+	TArray<AITradeGenerationBuffer> CompanyBuffers;
+	CompanyBuffers.SetNum(Companies.Num());
+
+	auto CompanyIdleShipsJob = [&](int32 CompanyIndex, AITradeGenerationBuffer& Buffer)
+	{
+		GenerateCompanyIdleShips(Companies[CompanyIndex], Buffer.IdleShips);
+	};
 
+	ParallelFor(Companies.Num(), [&](int32 CompanyIndex)
+	{
+		CompanyIdleShipsJob(CompanyIndex, CompanyBuffers[CompanyIndex]);
+	}, !UFlareGameTools::ParallelTradeGeneration);
+	CompareTradeGeneration(TEXT("GenerateIdleShips"), CompanyBuffers, CompanyIdleShipsJob);
 
+	for (AITradeGenerationBuffer& Buffer : CompanyBuffers)
+	{
+		Ships.Ships.Append(Buffer.IdleShips);
+	}
 
+	Ships.GenerateCache();
+}
 
 #define SourceFunctionCount 18
 #define IdleShipFunctionCount 12
 
-void AITradeHelper::ComputeGlobalTrading(UFlareWorld* World, AITradeNeeds& Needs, AITradeSources& Sources, AITradeSources& MaintenanceSources, AITradeIdleShips& IdleShips, AICompaniesMoney& CompaniesMoney)
+/* Need waiting in the trading queue. Needs kept after a try are processed again in the next pass */
+struct AITradeNeedQueueEntry
 {
-	while(Needs.List.Num() > 0)
-	{
-		Needs.List.Sort(&NeedComparatorComparator);
+	int32 Pass;
+	int32 NeedIndex;
+};
 
-		TArray<AITradeNeed> KeepList;
+void AITradeHelper::ComputeGlobalTrading(UFlareWorld* World, AITradeNeeds& Needs, AITradeSources& Sources, AITradeSources& MaintenanceSources, AITradeIdleShips& IdleShips, AICompaniesMoney& CompaniesMoney)
+{
+	TArray<AITradeNeed>& List = Needs.List;
 
-		for(AITradeNeed& Need : Needs.List)
+	// Earliest pass first, then same order as NeedComparatorComparator. The index keeps the order deterministic.
+	auto QueuePredicate = [&List](const AITradeNeedQueueEntry& A, const AITradeNeedQueueEntry& B)
+	{
+		if (A.Pass != B.Pass)
 		{
-			bool Keep = ProcessNeed(Need, Sources, MaintenanceSources, IdleShips, CompaniesMoney, Need.SourceFunctionIndexIterationsPerTry);
+			return A.Pass < B.Pass;
+		}
 
-			if(Keep)
-			{
-				KeepList.Add(Need);
-			}
+		const AITradeNeed& NeedA = List[A.NeedIndex];
+		const AITradeNeed& NeedB = List[B.NeedIndex];
+		if (NeedA.HighPriority != NeedB.HighPriority)
+		{
+			return NeedA.HighPriority > NeedB.HighPriority;
 		}
+		if (NeedA.Ratio != NeedB.Ratio)
+		{
+			return NeedA.Ratio > NeedB.Ratio;
+		}
+		return A.NeedIndex < B.NeedIndex;
+	};
 
-		Needs.List = KeepList;
+	TArray<AITradeNeedQueueEntry> Queue;
+	Queue.Reserve(List.Num());
+	for (int32 NeedIndex = 0; NeedIndex < List.Num(); NeedIndex++)
+	{
+		Queue.Add({0, NeedIndex});
 	}
+	Queue.Heapify(QueuePredicate);
+
+	// Only the processed need changes, so the others keep their place in the heap
+	while (Queue.Num() > 0)
+	{
+		AITradeNeedQueueEntry Entry;
+		Queue.HeapPop(Entry, QueuePredicate, false);
+
+		AITradeNeed& Need = List[Entry.NeedIndex];
+		bool Keep = ProcessNeed(Need, Sources, MaintenanceSources, IdleShips, CompaniesMoney, Need.SourceFunctionIndexIterationsPerTry);
+
+		if (Keep)
+		{
+			Entry.Pass++;
+			Queue.HeapPush(Entry, QueuePredicate);
+		}
+	}
+
+	List.Empty();
 }
 
 
 bool AITradeHelper::ProcessNeed(AITradeNeed& Need, AITradeSources& Sources, AITradeSources& MaintenanceSources, AITradeIdleShips& IdleShips, AICompaniesMoney& CompaniesMoney, int32 SourceFunctionIndexIterationsPerTry)
 {
 	bool MaintenanceSource = false;
-	AITradeSource* Source = FindBestSource(Sources, Need, CompaniesMoney);
+	AITradeSource* Source = nullptr;
 
-	if(Source == nullptr && Need.Maintenance)
+	// Try the source functions in order, up to the number of tries allowed for this pass
+	while(true)
 	{
-		Source = FindBestSource(MaintenanceSources, Need, CompaniesMoney);
-		MaintenanceSource = true;
-	}
+		MaintenanceSource = false;
+		Source = FindBestSource(Sources, Need, CompaniesMoney);
+
+		if(Source == nullptr && Need.Maintenance)
+		{
+			Source = FindBestSource(MaintenanceSources, Need, CompaniesMoney);
+			MaintenanceSource = true;
+		}
+
+		if(Source != nullptr)
+		{
+			break;
+		}
 
-	if(Source == nullptr)
-	{
 		//FLOG("No best source");
 		// No possible source, don't keep
 		SourceFunctionIndexIterationsPerTry--;
 		Need.SourceFunctionIndex++;
 
-		if(Need.SourceFunctionIndex < SourceFunctionCount)
+		if(Need.SourceFunctionIndex >= SourceFunctionCount)
 		{
-			if (SourceFunctionIndexIterationsPerTry > 0)
-			{
-/*
-				FLOGV("Need still has more attempts before moving to others : %s %s in %s: %d/%d %s. Remaining SourceFunctionIndexIterationsPerTry %d.",
-					*Need.Company->GetCompanyName().ToString(),
-					*Need.Station->GetImmatriculation().ToString(),
-					*Need.Sector->GetSectorName().ToString(),
-					Need.Quantity,
-					Need.TotalCapacity,
-					*Need.Resource->Name.ToString(),
-					SourceFunctionIndexIterationsPerTry);
-*/
-
-				return ProcessNeed(Need, Sources, MaintenanceSources, IdleShips, CompaniesMoney, SourceFunctionIndexIterationsPerTry);
-			}
-			return true;
-		}
 #if DEBUG_NEW_AI_TRADING
-		FLOGV("No source found for need : %s %s in %s: %d/%d %s",
-			  *Need.Company->GetCompanyName().ToString(),
-			  *Need.Station->GetImmatriculation().ToString(),
-			  *Need.Sector->GetSectorName().ToString(),
-			  Need.Quantity,
-			  Need.TotalCapacity,
-			  *Need.Resource->Name.ToString()
-			  );
+			FLOGV("No source found for need : %s %s in %s: %d/%d %s",
+				  *Need.Company->GetCompanyName().ToString(),
+				  *Need.Station->GetImmatriculation().ToString(),
+				  *Need.Sector->GetSectorName().ToString(),
+				  Need.Quantity,
+				  Need.TotalCapacity,
+				  *Need.Resource->Name.ToString()
+				  );
 #endif
+			return false;
+		}
 
-		return false;
+		if (SourceFunctionIndexIterationsPerTry <= 0)
+		{
+			return true;
+		}
 	}
 
 	//FLOGV("Best source %p Ship=%p Station=%p", Source, Source->Ship, Source->Station);
@@ -4097,11 +4349,14 @@ void AITradeSources::Print()
 
 void AITradeSources::ConsumeSource(AITradeSource* Source)
 {
-	for(auto& SourcePerResource : SourcesPerResource)
+	if (Source->Slots[AITradeSlot::Global] == INDEX_NONE)
 	{
-		SourcePerResource.Value.ConsumeSource(Source);
+		// Already consumed
+		return;
 	}
 
+	SourcesPerResource[Source->Resource].ConsumeSource(Source);
+
 #if DEBUG_NEW_AI_TRADING
 	SourcesPtr.Remove(Source);
 #endif
@@ -4129,6 +4384,7 @@ void AITradeSources::GenerateCache()
 	for(AITradeSource& Source : Sources)
 	{
 		SourceCount++;
+		AITradeSlotList::Reset(&Source);
 		SourcesPerResource[Source.Resource].Add(&Source);
 #if DEBUG_NEW_AI_TRADING
 		SourcesPtr.Add(&Source);
@@ -4142,13 +4398,13 @@ AITradeSourcesByResource::AITradeSourcesByResource(UFlareWorld* World)
 	SourcesPerSector.Reserve(World->GetSectors().Num());
 	for(UFlareSimulatedSector* Sector : World->GetSectors())
 	{
-		SourcesPerSector.Add(Sector, AITradeSourcesByResourceLocation(World));
+		SourcesPerSector.Add(Sector, AITradeSourcesByResourceLocation(World, AITradeSlot::Sector));
 
 		FName Moon = Sector->GetOrbitParameters()->CelestialBodyIdentifier;
 
 		if(!SourcesPerMoon.Contains(Moon))
 		{
-			SourcesPerMoon.Add(Moon, AITradeSourcesByResourceLocation(World));
+			SourcesPerMoon.Add(Moon, AITradeSourcesByResourceLocation(World, AITradeSlot::Moon));
 		}
 	}
 
@@ -4170,9 +4426,9 @@ void AITradeSourcesByResource::Add(AITradeSource* Source)
 	FName Moon = Source->Sector->GetOrbitParameters()->CelestialBodyIdentifier;
 	SourcesPerMoon[Moon].Add(Source);
 
-	SourcesPerCompany[Source->Company].Add(Source);
+	AITradeSlotList::Add(SourcesPerCompany[Source->Company], Source, AITradeSlot::Company);
 
-	Sources.Add(Source);
+	AITradeSlotList::Add(Sources, Source, AITradeSlot::Global);
 }
 
 AITradeSourcesByResourceLocation& AITradeSourcesByResource::GetSourcesPerSector(UFlareSimulatedSector* Sector)
@@ -4198,25 +4454,18 @@ TArray<AITradeSource*>& AITradeSourcesByResource::GetSources()
 
 void AITradeSourcesByResource::ConsumeSource(AITradeSource* Source)
 {
-	for(auto& SourcePerSector : SourcesPerSector)
-	{
-		SourcePerSector.Value.ConsumeSource(Source);
-	}
+	SourcesPerSector[Source->Sector].ConsumeSource(Source);
 
-	for(auto& SourcePerSector : SourcesPerMoon)
-	{
-		SourcePerSector.Value.ConsumeSource(Source);
-	}
+	FName Moon = Source->Sector->GetOrbitParameters()->CelestialBodyIdentifier;
+	SourcesPerMoon[Moon].ConsumeSource(Source);
 
-	for(auto& SourcePerCompany : SourcesPerCompany)
-	{
-		SourcePerCompany.Value.Remove(Source);
-	}
+	AITradeSlotList::Remove(SourcesPerCompany[Source->Company], Source, AITradeSlot::Company);
 
-	Sources.Remove(Source);
+	AITradeSlotList::Remove(Sources, Source, AITradeSlot::Global);
 }
 
-AITradeSourcesByResourceLocation::AITradeSourcesByResourceLocation(UFlareWorld* World)
+AITradeSourcesByResourceLocation::AITradeSourcesByResourceLocation(UFlareWorld* World, AITradeSlot::Type Slot)
+	: ListSlot(Slot)
 {
 	for(UFlareCompany* Company : World->GetCompanies())
 	{
@@ -4227,9 +4476,9 @@ AITradeSourcesByResourceLocation::AITradeSourcesByResourceLocation(UFlareWorld*
 
 void AITradeSourcesByResourceLocation::Add(AITradeSource* Source)
 {
-	SourcesPerCompany[Source->Company].Add(Source);
+	AITradeSlotList::Add(SourcesPerCompany[Source->Company], Source, ListSlot + 1);
 
-	Sources.Add(Source);
+	AITradeSlotList::Add(Sources, Source, ListSlot);
 }
 
 
@@ -4247,12 +4496,9 @@ TArray<AITradeSource*>& AITradeSourcesByResourceLocation::GetSources()
 
 void AITradeSourcesByResourceLocation::ConsumeSource(AITradeSource* Source)
 {
-	for(auto& SourcePerCompany : SourcesPerCompany)
-	{
-		SourcePerCompany.Value.Remove(Source);
-	}
+	AITradeSlotList::Remove(SourcesPerCompany[Source->Company], Source, ListSlot + 1);
 
-	Sources.Remove(Source);
+	AITradeSlotList::Remove(Sources, Source, ListSlot);
 }
 
 AITradeIdleShips::AITradeIdleShips(UFlareWorld* World)
@@ -4260,13 +4506,13 @@ AITradeIdleShips::AITradeIdleShips(UFlareWorld* World)
 	ShipsPerSector.Reserve(World->GetSectors().Num());
 	for(UFlareSimulatedSector* Sector : World->GetSectors())
 	{
-		ShipsPerSector.Add(Sector, AITradeIdleShipsByLocation(World));
+		ShipsPerSector.Add(Sector, AITradeIdleShipsByLocation(World, AITradeSlot::Sector));
 
 		FName Moon = Sector->GetOrbitParameters()->CelestialBodyIdentifier;
 
 		if(!ShipsPerMoon.Contains(Moon))
 		{
-			ShipsPerMoon.Add(Moon, AITradeIdleShipsByLocation(World));
+			ShipsPerMoon.Add(Moon, AITradeIdleShipsByLocation(World, AITradeSlot::Moon));
 		}
 	}
 
@@ -4295,22 +4541,14 @@ void AITradeIdleShips::Print()
 
 void AITradeIdleShips::ConsumeShip(AIIdleShip* Ship)
 {
-	for(auto& ShipPerSector : ShipsPerSector)
-	{
-		ShipPerSector.Value.ConsumeShip(Ship);
-	}
+	ShipsPerSector[Ship->Sector].ConsumeShip(Ship);
 
-	for(auto& ShipPerSector : ShipsPerMoon)
-	{
-		ShipPerSector.Value.ConsumeShip(Ship);
-	}
+	FName Moon = Ship->Sector->GetOrbitParameters()->CelestialBodyIdentifier;
+	ShipsPerMoon[Moon].ConsumeShip(Ship);
 
-	for(auto& ShipPerCompany : ShipsPerCompany)
-	{
-		ShipPerCompany.Value.Remove(Ship);
-	}
+	AITradeSlotList::Remove(ShipsPerCompany[Ship->Company], Ship, AITradeSlot::Company);
 
-	ShipsPtr.Remove(Ship);
+	AITradeSlotList::Remove(ShipsPtr, Ship, AITradeSlot::Global);
 }
 
 void AITradeIdleShips::Add(AIIdleShip const& Ship)
@@ -4322,13 +4560,14 @@ void AITradeIdleShips::GenerateCache()
 {
 	for(AIIdleShip& Ship : Ships)
 	{
+		AITradeSlotList::Reset(&Ship);
 		ShipsPerSector[Ship.Sector].Add(&Ship);
 
 		FName Moon = Ship.Sector->GetOrbitParameters()->CelestialBodyIdentifier;
 		ShipsPerMoon[Moon].Add(&Ship);
 
-		ShipsPerCompany[Ship.Company].Add(&Ship);
-		ShipsPtr.Add(&Ship);
+		AITradeSlotList::Add(ShipsPerCompany[Ship.Company], &Ship, AITradeSlot::Company);
+		AITradeSlotList::Add(ShipsPtr, &Ship, AITradeSlot::Global);
 	}
 }
 
@@ -4362,7 +4601,8 @@ TArray<AIIdleShip*>& AITradeIdleShipsByLocation::GetShips()
 	return Ships;
 }
 
-AITradeIdleShipsByLocation::AITradeIdleShipsByLocation(UFlareWorld* World)
+AITradeIdleShipsByLocation::AITradeIdleShipsByLocation(UFlareWorld* World, AITradeSlot::Type Slot)
+	: ListSlot(Slot)
 {
 	for(UFlareCompany* Company : World->GetCompanies())
 	{
@@ -4374,19 +4614,16 @@ AITradeIdleShipsByLocation::AITradeIdleShipsByLocation(UFlareWorld* World)
 void AITradeIdleShipsByLocation::Add(AIIdleShip* Ship)
 {
 	//FLOGV("   - AITradeIdleShipsByLocation add ship from %s", *Ship->Company->GetIdentifier().ToString());
-	ShipsPerCompany[Ship->Company].Add(Ship);
+	AITradeSlotList::Add(ShipsPerCompany[Ship->Company], Ship, ListSlot + 1);
 
-	Ships.Add(Ship);
+	AITradeSlotList::Add(Ships, Ship, ListSlot);
 }
 
 void AITradeIdleShipsByLocation::ConsumeShip(AIIdleShip* Ship)
 {
-	for(auto& ShipPerCompany : ShipsPerCompany)
-	{
-		ShipPerCompany.Value.Remove(Ship);
-	}
+	AITradeSlotList::Remove(ShipsPerCompany[Ship->Company], Ship, ListSlot + 1);
 
-	Ships.Remove(Ship);
+	AITradeSlotList::Remove(Ships, Ship, ListSlot);
 }
 
 void AITradeNeed::Consume(int UsedQuantity)
@@ -48,7 +48,23 @@ struct ResourceVariation
 struct SectorVariation
 {
 	int32 IncomingCapacity;
-	TMap<FFlareResourceDescription*, ResourceVariation> ResourceVariations;
+
+	/* By FFlareResourceDescription::CatalogIndex */
+	TArray<ResourceVariation> ResourceVariations;
+};
+
+/* Resource flows of a company in every sector it knows, by UFlareSimulatedSector::GetWorldIndex */
+struct WorldVariation
+{
+	/* Reset to one empty entry per world sector */
+	void Init(UFlareWorld* World);
+
+	void Add(UFlareSimulatedSector* Sector, SectorVariation const& Variation);
+
+	SectorVariation& operator[](UFlareSimulatedSector* Sector);
+	SectorVariation const& operator[](UFlareSimulatedSector* Sector) const;
+
+	TArray<SectorVariation> SectorVariations;
 };
 
 struct AITradeNeed
@@ -85,6 +101,58 @@ struct AITradeNeeds
 };
 
 
+/* Position of a source or idle ship in each of the indexes it belongs to */
+namespace AITradeSlot
+{
+	enum Type
+	{
+		Global,
+		Company,
+		Sector,
+		SectorCompany,
+		Moon,
+		MoonCompany,
+		Count
+	};
+}
+
+/* Pointer lists with constant time removal : each element keeps its index in every list */
+struct AITradeSlotList
+{
+	template<typename ElementType>
+	static void Add(TArray<ElementType*>& List, ElementType* Element, int32 Slot)
+	{
+		Element->Slots[Slot] = List.Add(Element);
+	}
+
+	template<typename ElementType>
+	static void Remove(TArray<ElementType*>& List, ElementType* Element, int32 Slot)
+	{
+		int32 Index = Element->Slots[Slot];
+		if (Index == INDEX_NONE)
+		{
+			return;
+		}
+
+		check(List[Index] == Element);
+		List.RemoveAtSwap(Index, 1, false);
+		if (Index < List.Num())
+		{
+			List[Index]->Slots[Slot] = Index;
+		}
+		Element->Slots[Slot] = INDEX_NONE;
+	}
+
+	template<typename ElementType>
+	static void Reset(ElementType* Element)
+	{
+		for (int32 Slot = 0; Slot < AITradeSlot::Count; Slot++)
+		{
+			Element->Slots[Slot] = INDEX_NONE;
+		}
+	}
+};
+
 struct AITradeSource
 {
 	UFlareSimulatedSpacecraft* Ship;
@@ -95,6 +163,8 @@ struct AITradeSource
 	int32 Quantity;
 	bool Stranded;
 	bool Traveling;
+
+	int32 Slots[AITradeSlot::Count];
 };
 
 inline bool operator==(const AITradeSource& lhs, const AITradeSource& rhs){
@@ -106,7 +176,7 @@ inline bool operator==(const AITradeSource& lhs, const AITradeSource& rhs){
 
 struct AITradeSourcesByResourceLocation
 {
-	AITradeSourcesByResourceLocation(UFlareWorld* World);
+	AITradeSourcesByResourceLocation(UFlareWorld* World, AITradeSlot::Type Slot);
 
 	TArray<AITradeSource*>& GetSourcePerCompany(UFlareCompany* Company);
 
@@ -118,6 +188,9 @@ struct AITradeSourcesByResourceLocation
 
 	TMap<UFlareCompany*, TArray<AITradeSource*>> SourcesPerCompany;
 	TArray<AITradeSource*> Sources;
+
+	// Sector or moon slot, followed by its company slot
+	AITradeSlot::Type ListSlot;
 };
 
 
@@ -179,13 +252,14 @@ struct AIIdleShip
 	bool Traveling;
 	bool Stranded;
 
+	int32 Slots[AITradeSlot::Count];
 };
 
 inline bool operator==(const AIIdleShip& lhs, const AIIdleShip& rhs){ return lhs.Ship == rhs.Ship;}
 
 struct AITradeIdleShipsByLocation
 {
-	AITradeIdleShipsByLocation(UFlareWorld* World);
+	AITradeIdleShipsByLocation(UFlareWorld* World, AITradeSlot::Type Slot);
 
 	TArray<AIIdleShip*>& GetShipsPerCompany(UFlareCompany* Company);
 
@@ -197,6 +271,9 @@ struct AITradeIdleShipsByLocation
 
 	TMap<UFlareCompany*, TArray<AIIdleShip*>> ShipsPerCompany;
 	TArray<AIIdleShip*> Ships;
+
+	// Sector or moon slot, followed by its company slot
+	AITradeSlot::Type ListSlot;
 };
 
 struct AITradeIdleShips
@@ -230,20 +307,20 @@ struct AITradeHelper
 {
 	static void CompanyAutoTrade(UFlareCompany* Company);
 
-	static void FleetAutoTrade(UFlareFleet* Fleet, TMap<UFlareSimulatedSector*, SectorVariation>& WorldResourceVariation);
+	static void FleetAutoTrade(UFlareFleet* Fleet, WorldVariation& WorldResourceVariation);
 
 	static TArray<UFlareSimulatedSpacecraft*> FindIdleCargos(UFlareCompany* Company);
 
-	static SectorDeal FindBestDealForShipFromSector(UFlareSimulatedSpacecraft* Ship, UFlareSimulatedSector* SectorA, SectorDeal* DealToBeat, TMap<UFlareSimulatedSector*, SectorVariation> const& WorldResourceVariation, UFlareSimulatedSector* SectorBRestiction);
+	static SectorDeal FindBestDealForShipFromSector(UFlareSimulatedSpacecraft* Ship, UFlareSimulatedSector* SectorA, SectorDeal* DealToBeat, WorldVariation const& WorldResourceVariation, UFlareSimulatedSector* SectorBRestiction);
 
-	static SectorDeal FindBestDealForShipToSector(UFlareSimulatedSpacecraft* Ship, UFlareSimulatedSector* SectorA, UFlareSimulatedSector* SectorB, SectorDeal* DealToBeat, TMap<UFlareSimulatedSector*, SectorVariation> const& WorldResourceVariation, UFlareSimulatedSector* SectorBRestiction);
+	static SectorDeal FindBestDealForShipToSector(UFlareSimulatedSpacecraft* Ship, UFlareSimulatedSector* SectorA, UFlareSimulatedSector* SectorB, SectorDeal* DealToBeat, WorldVariation const& WorldResourceVariation, UFlareSimulatedSector* SectorBRestiction);
 
-	static SectorDeal FindBestDealForShip(UFlareSimulatedSpacecraft* Ship, TMap<UFlareSimulatedSector*, SectorVariation>& WorldResourceVariation, UFlareSimulatedSector* SectorARestiction, UFlareSimulatedSector* SectorBRestiction);
+	static SectorDeal FindBestDealForShip(UFlareSimulatedSpacecraft* Ship, WorldVariation& WorldResourceVariation, UFlareSimulatedSector* SectorARestiction, UFlareSimulatedSector* SectorBRestiction);
 
 	static UFlareSimulatedSpacecraft* FindBestMasterShip(int32& UsableShipCount,UFlareFleet* Fleet, TArray<UFlareSimulatedSpacecraft*>& ExcludeList);
 
 
-	static void ApplyDeal(UFlareSimulatedSpacecraft* Ship, SectorDeal const&Deal, TMap<UFlareSimulatedSector*, SectorVariation>* WorldResourceVariation, bool AllowTravel, bool AllowUseNoTradeForMe);
+	static void ApplyDeal(UFlareSimulatedSpacecraft* Ship, SectorDeal const&Deal, WorldVariation* WorldResourceVariation, bool AllowTravel, bool AllowUseNoTradeForMe);
 
 	/** Get the resource flow in this sector */
 	static SectorVariation ComputeSectorResourceVariation(UFlareCompany* Company, UFlareSimulatedSector* Sector, bool AllowUseNoTradeForMe, bool FactorIncoming = true);
@@ -725,8 +725,7 @@ void UFlareCompanyAI::CreateWorldResourceVariations()
 	CreatedWorldResourceVariations = true;
 	// Compute input and output ressource equation (ex: 100 + 10/ day)
 // TODO
-	WorldResourceVariation.Empty();
-	WorldResourceVariation.Reserve(Company->GetKnownSectors().Num());
+	WorldResourceVariation.Init(Game->GetGameWorld());
 	for (int32 SectorIndex = 0; SectorIndex < Company->GetKnownSectors().Num(); SectorIndex++)
 	{
 		UFlareSimulatedSector* Sector = Company->GetKnownSectors()[SectorIndex];
@@ -5357,7 +5356,7 @@ float UFlareCompanyAI::ComputeConstructionScoreForStation(UFlareSimulatedSector*
 		for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->ConsumerResources.Num(); ResourceIndex++)
 		{
 			FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->ConsumerResources[ResourceIndex]->Data;
-			const struct ResourceVariation* Variation = &ThisSectorVariation->ResourceVariations[Resource];
+			const struct ResourceVariation* Variation = &ThisSectorVariation->ResourceVariations[Resource->CatalogIndex];
 
 
 			float Consumption = Sector->GetPeople()->GetRessourceConsumption(Resource, false);
@@ -5396,7 +5395,7 @@ float UFlareCompanyAI::ComputeConstructionScoreForStation(UFlareSimulatedSector*
 		for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->MaintenanceResources.Num(); ResourceIndex++)
 		{
 			FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->MaintenanceResources[ResourceIndex]->Data;
-			const struct ResourceVariation* Variation = &ThisSectorVariation->ResourceVariations[Resource];
+			const struct ResourceVariation* Variation = &ThisSectorVariation->ResourceVariations[Resource->CatalogIndex];
 
 
 			int32 Consumption = WorldStats[Resource].Consumption / Company->GetKnownSectors().Num();
@@ -5723,13 +5722,13 @@ float UFlareCompanyAI::ComputeStationPrice(UFlareSimulatedSector* Sector, FFlare
 
 
 
-void UFlareCompanyAI::DumpSectorResourceVariation(UFlareSimulatedSector* Sector, TMap<FFlareResourceDescription*, struct ResourceVariation>* SectorVariation) const
+void UFlareCompanyAI::DumpSectorResourceVariation(UFlareSimulatedSector* Sector, TArray<struct ResourceVariation>* SectorVariation) const
 {
 	FLOGV("DumpSectorResourceVariation : sector %s resource variation: ", *Sector->GetSectorName().ToString());
 	for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 	{
 		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-		struct ResourceVariation* Variation = &(*SectorVariation)[Resource];
+		struct ResourceVariation* Variation = &(*SectorVariation)[ResourceIndex];
 		if (Variation->OwnedFlow ||
 				Variation->FactoryFlow ||
 				Variation->OwnedStock ||
@@ -257,7 +257,7 @@ protected:
 	float ComputeStationPrice(UFlareSimulatedSector* Sector, FFlareSpacecraftDescription* StationDescription, UFlareSimulatedSpacecraft* Station) const;
 
 	/** Print the resource flow */
-	void DumpSectorResourceVariation(UFlareSimulatedSector* Sector, TMap<FFlareResourceDescription*, struct ResourceVariation>* Variation) const;
+	void DumpSectorResourceVariation(UFlareSimulatedSector* Sector, TArray<struct ResourceVariation>* Variation) const;
 
 
 protected:
@@ -281,7 +281,7 @@ protected:
 	TArray<UFlareSimulatedSpacecraft*>       UnderConstructionStations;
 
 
-	TMap<UFlareSimulatedSector*, SectorVariation> WorldResourceVariation;
+	WorldVariation WorldResourceVariation;
 
 	TArray<UFlareSimulatedSector*>            SectorWithBattle;
 
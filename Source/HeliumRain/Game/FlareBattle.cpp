@@ -36,6 +36,85 @@ struct BattleTargetPreferences
         float TargetStateWeight;
 };
 
+/** What makes a spacecraft more or less attractive as a target */
+namespace EFlareBattleTargetTrait
+{
+	enum Type
+	{
+		Excluded =                     1 << 0,
+		Large =                        1 << 1,
+		Small =                        1 << 2,
+		Station =                      1 << 3,
+		Military =                     1 << 4,
+		Dangerous =                    1 << 5,
+		Stranded =                     1 << 6,
+		UncontrollableDisarmed =       1 << 7,
+		Harpooned =                    1 << 8,
+		Uncapturable =                 1 << 9
+	};
+}
+
+static float GetTargetWeight(uint32 Traits, const BattleTargetPreferences& Preferences, bool HasSmallSalvager, bool HasLargeSalvager)
+{
+	float StateScore = Preferences.TargetStateWeight;
+
+	if (Traits & EFlareBattleTargetTrait::Large)
+	{
+		StateScore *= Preferences.IsLarge;
+	}
+	else if (Traits & EFlareBattleTargetTrait::Small)
+	{
+		StateScore *= Preferences.IsSmall;
+	}
+
+	StateScore *= (Traits & EFlareBattleTargetTrait::Station) ? Preferences.IsStation : Preferences.IsNotStation;
+	StateScore *= (Traits & EFlareBattleTargetTrait::Military) ? Preferences.IsMilitary : Preferences.IsNotMilitary;
+	StateScore *= (Traits & EFlareBattleTargetTrait::Dangerous) ? Preferences.IsDangerous : Preferences.IsNotDangerous;
+	StateScore *= (Traits & EFlareBattleTargetTrait::Stranded) ? Preferences.IsStranded : Preferences.IsNotStranded;
+
+	if (Traits & EFlareBattleTargetTrait::UncontrollableDisarmed)
+	{
+		if (Traits & EFlareBattleTargetTrait::Military)
+		{
+			if (Traits & EFlareBattleTargetTrait::Small)
+			{
+				StateScore *= Preferences.IsUncontrollableSmallMilitary;
+			}
+			else
+			{
+				StateScore *= Preferences.IsUncontrollableLargeMilitary;
+			}
+		}
+		else
+		{
+			StateScore *= Preferences.IsUncontrollableCivil;
+		}
+	}
+	else
+	{
+		StateScore *= Preferences.IsNotUncontrollable;
+	}
+
+	if (Traits & EFlareBattleTargetTrait::Harpooned)
+	{
+		StateScore *= Preferences.IsHarpooned;
+	}
+
+	if (Traits & EFlareBattleTargetTrait::Uncapturable)
+	{
+		if ((Traits & EFlareBattleTargetTrait::Large) && HasLargeSalvager)
+		{
+			StateScore *= 0.50f;
+		}
+		else if ((Traits & EFlareBattleTargetTrait::Small) && HasSmallSalvager)
+		{
+			StateScore *= 0.50f;
+		}
+	}
+
+	return StateScore;
+}
+
 /*----------------------------------------------------
 	Constructor
 ----------------------------------------------------*/
@@ -60,7 +139,13 @@ void UFlareBattle::Load(UFlareSimulatedSector* BattleSector)
 	PlayerAssetsFighting = false;
 	FoundFightingCompanies = false;
 	ShipDisabledPreviousTurn = false;
+	FightingCompaniesValid = false;
 	MaximumTurns = MAXIMUM_TURNS_SHIPBATTLE;
+	Events.Empty();
+	PendingCaptures.Empty();
+
+	// Same fight for the same day, whichever thread simulates it
+	RandomStream.Initialize(HashCombine(GetTypeHash(Game->GetGameWorld()->GetDate()), GetTypeHash(Sector->GetIdentifier())));
 
 	for (FFlareMeteoriteSave& Meteorite : Sector->GetData()->MeteoriteData)
 	{
@@ -95,6 +180,8 @@ void UFlareBattle::Load(UFlareSimulatedSector* BattleSector)
 		InitialSectorViableFightingShips.Add(Ship);
 		CurrentSectorViableFightingShips.Add(Ship);
 	}
+
+	BuildTargetIndex();
 }
 
 /*----------------------------------------------------
@@ -108,8 +195,6 @@ void UFlareBattle::Simulate()
     FLOGV("Simulate battle in %s", *Sector->GetSectorName().ToString());
 #endif
 
-	CombatLog::AutomaticBattleStarted(Sector);
-
 	while (HasBattle())
     {
 		CurrentBattleTurn++;
@@ -129,12 +214,45 @@ void UFlareBattle::Simulate()
         }
     }
 
-	CombatLog::AutomaticBattleEnded(Sector);
 #ifdef DEBUG_SIMULATE
 	FLOGV("Battle in %s finish after %d turns", *Sector->GetSectorName().ToString(), CurrentBattleTurn);
 #endif
 }
 
+void UFlareBattle::CommitResults()
+{
+	CombatLog::AutomaticBattleStarted(Sector);
+
+	for (FFlareBattleEvent& Event : Events)
+	{
+		switch (Event.Type)
+		{
+			case EFlareBattleEvent::Damage:
+				CombatLog::SpacecraftDamaged(Event.Target, Event.Damage.Energy, 0, FVector::ZeroVector, Event.Damage.DamageType, Event.Damage.DamageSource->GetCompany(), "SimulatedBattle");
+				Event.Target->GetDamageSystem()->ApplyDamageConsequences(Event.Damage);
+				break;
+
+			case EFlareBattleEvent::Capture:
+				Event.Company->StartCapture(Event.Target, false);
+				break;
+
+			case EFlareBattleEvent::MeteoriteDestroyed:
+				Game->GetQuestManager()->OnEvent(FFlareBundle().PutTag("meteorite-destroyed").PutName("sector", Sector->GetIdentifier()));
+				break;
+		}
+	}
+
+	for (UFlareSimulatedSpacecraft* Ship : InitialSectorViableFightingShips)
+	{
+		Ship->GetDamageSystem()->NotifyDamage();
+	}
+
+	CombatLog::AutomaticBattleEnded(Sector);
+
+	Events.Empty();
+	PendingCaptures.Empty();
+}
+
 bool UFlareBattle::HasBattle()
 {
     // Check if battle
@@ -150,21 +268,27 @@ bool UFlareBattle::HasBattle()
 
 void UFlareBattle::FindFightingCompanies()
 {
+	// Battle states only change when a ship stops fighting, meteorites only matter while there are some
+	bool HasMeteorites = LocalMeteorites.Num() > 0;
+	if (FightingCompaniesValid && !ShipDisabledPreviousTurn && HasMeteorites == FightingCompaniesWithMeteorites)
+	{
+		return;
+	}
+	FightingCompaniesValid = true;
+	FightingCompaniesWithMeteorites = HasMeteorites;
+
 	FightingCompanies.Empty();
 
 	FoundFightingCompanies = false;
+	if (ShipDisabledPreviousTurn)
+	{
+		Sector->UpdateSectorBattleStates();
+	}
+
 	for (int CompanyIndex = 0; CompanyIndex < Game->GetGameWorld()->GetCompanies().Num(); CompanyIndex++)
 	{
 		UFlareCompany* Company = Game->GetGameWorld()->GetCompanies()[CompanyIndex];
-		FFlareSectorBattleState BattleState;
-		if (ShipDisabledPreviousTurn)
-		{
-			BattleState = Sector->UpdateSectorBattleState(Company);
-		}
-		else
-		{
-			BattleState = Sector->GetSectorBattleState(Company);
-		}
+		FFlareSectorBattleState BattleState = Sector->GetSectorBattleState(Company);
 
 		if (!BattleState.WantFight())
 		{
@@ -191,16 +315,16 @@ bool UFlareBattle::SimulateTurn()
 	bool HasFight = false;
 	PlayerAssetsFighting = false;
 
-	// List all fighting ships
+	// List all fighting ships, keeping the viable ones in order
     TArray<UFlareSimulatedSpacecraft*> ShipToSimulate;
+	ShipToSimulate.Reserve(CurrentSectorViableFightingShips.Num());
+	int32 ViableShipCount = 0;
 	for (int32 ShipIndex = 0 ; ShipIndex < CurrentSectorViableFightingShips.Num(); ShipIndex++)
 	{
         UFlareSimulatedSpacecraft* Ship = CurrentSectorViableFightingShips[ShipIndex];
 		if(Ship->IsReserve() || Ship->GetDamageSystem()->IsDisarmed())
 		{
 			// Not actively participating in fight
-			CurrentSectorViableFightingShips.Remove(Ship);
-			ShipIndex--;
 			ShipDisabledPreviousTurn = true;
 #ifdef DEBUG_SIMULATE
 			FLOGV("%s removed from viable fighting ships", *Ship->GetImmatriculation().ToString());
@@ -208,6 +332,8 @@ bool UFlareBattle::SimulateTurn()
 			continue;
 		}
 
+		CurrentSectorViableFightingShips[ViableShipCount++] = Ship;
+
 		if (Ship->GetCompany() == PlayerCompany)
 		{
 			PlayerAssetsFighting = true;
@@ -215,11 +341,12 @@ bool UFlareBattle::SimulateTurn()
 		
 		ShipToSimulate.Add(Ship);
     }
+	CurrentSectorViableFightingShips.SetNum(ViableShipCount, false);
 
     // Play fighting ship in random order
     while(ShipToSimulate.Num())
     {
-        int32 Index = FMath::RandRange(0, ShipToSimulate.Num() - 1);
+        int32 Index = RandomStream.RandRange(0, ShipToSimulate.Num() - 1);
         if(SimulateShipTurn(ShipToSimulate[Index]))
         {
             HasFight = true;
@@ -227,11 +354,6 @@ bool UFlareBattle::SimulateTurn()
        ShipToSimulate.RemoveAtSwap(Index);
 	}
 
-	for (UFlareSimulatedSpacecraft* Ship : InitialSectorViableFightingShips)
-	{
-		Ship->GetDamageSystem()->NotifyDamage();
-	}
-
     return HasFight;
 }
 
@@ -462,156 +584,62 @@ FFlareMeteoriteSave* UFlareBattle::GetMeteoriteTarget()
 
 UFlareSimulatedSpacecraft* UFlareBattle::GetBestTarget(UFlareSimulatedSpacecraft* Ship, struct BattleTargetPreferences Preferences)
 {
-	UFlareSimulatedSpacecraft* BestTarget = NULL;
-	float BestScore = 0;
+	FFlareBattleTargetIndex* Index = TargetIndexes.Find(Ship->GetCompany());
+	if (!Index)
+	{
+		return NULL;
+	}
 
 	bool HasSmallSalvager = Ship->GetWeaponsSystem()->IsDamageTypeInAvailableWeaponDamageTypes(EFlareShellDamageType::LightSalvage);
 	bool HasLargeSalvager = Ship->GetWeaponsSystem()->IsDamageTypeInAvailableWeaponDamageTypes(EFlareShellDamageType::HeavySalvage);
 
-	for (int32 SpacecraftIndex = 0; SpacecraftIndex < Sector->GetSectorSpacecrafts().Num(); SpacecraftIndex++)
-	{
-		UFlareSimulatedSpacecraft* ShipCandidate = Sector->GetSectorSpacecrafts()[SpacecraftIndex];
-		if(ShipCandidate->IsReserve())
-		{
-			// No in fight
-			continue;
-		}
+	// Each target scores its weight times a random number, and the best score wins.
+	// In a bucket of N targets of the same weight, the best of N random numbers is the N-th root of a random number.
+	FFlareBattleTargetBucket* BestBucket = NULL;
+	UFlareSimulatedSpacecraft* BestTarget = NULL;
+	float BestScore = 0;
 
-		if (!ShipCandidate->IsHostile(Ship->GetCompany()))
+	for (FFlareBattleTargetBucket& Bucket : Index->Buckets)
+	{
+		if (Bucket.Ships.Num() == 0)
 		{
-			// Ignore not hostile ships
 			continue;
 		}
 
-		if (!ShipCandidate->GetDamageSystem()->IsAlive())
+		float Weight = GetTargetWeight(Bucket.Traits, Preferences, HasSmallSalvager, HasLargeSalvager);
+		if (Weight <= 0)
 		{
-			// Ignore destroyed ships
 			continue;
 		}
 
-		if (ShipCandidate->IsStation() && ShipCandidate->GetStationEfficiency() <= 0)
+		float Score = Weight * FMath::Pow(RandomStream.FRand(), 1.f / Bucket.Ships.Num());
+		if (Score > BestScore)
 		{
-			// Ignore damaged stations
-			continue;
+			BestBucket = &Bucket;
+			BestScore = Score;
 		}
+	}
 
-		if (ShipCandidate->IsStation() && (!ShipCandidate->GetCompany()->IsPlayerCompany() || ShipCandidate->GetCompany()->GetRetaliation() <= 0))
+	for (UFlareSimulatedSpacecraft* ShipCandidate : Index->ConditionalTargets)
+	{
+		uint32 Traits = TargetTraits.FindRef(ShipCandidate);
+		if ((Traits & EFlareBattleTargetTrait::Excluded) || !ShipCandidate->IsHostile(Ship->GetCompany()))
 		{
-			// Ignore company without retaliation
 			continue;
 		}
 
-		float Score;
-		float StateScore;
-		float DistanceScore;
-
-		StateScore = Preferences.TargetStateWeight;
-
-		if (ShipCandidate->GetSize() == EFlarePartSize::L)
-		{
-			StateScore *= Preferences.IsLarge;
-		}
-
-		else if (ShipCandidate->GetSize() == EFlarePartSize::S)
+		float Score = GetTargetWeight(Traits, Preferences, HasSmallSalvager, HasLargeSalvager) * RandomStream.FRand();
+		if (Score > BestScore)
 		{
-			StateScore *= Preferences.IsSmall;
+			BestBucket = NULL;
+			BestTarget = ShipCandidate;
+			BestScore = Score;
 		}
+	}
 
-		if (ShipCandidate->IsStation())
-		{
-			StateScore *= Preferences.IsStation;
-		}
-		else
-		{
-			StateScore *= Preferences.IsNotStation;
-		}
-
-		if (ShipCandidate->IsMilitary())
-		{
-			StateScore *= Preferences.IsMilitary;
-		}
-		else
-		{
-			StateScore *= Preferences.IsNotMilitary;
-		}
-
-		if(ShipCandidate->IsMilitaryArmed()  && !ShipCandidate->GetDamageSystem()->IsDisarmed())
-		{
-			StateScore *= Preferences.IsDangerous;
-		}
-		else
-		{
-			StateScore *= Preferences.IsNotDangerous;
-		}
-
-		if (ShipCandidate->GetDamageSystem()->IsStranded())
-		{
-			StateScore *= Preferences.IsStranded;
-		}
-		else
-		{
-			StateScore *= Preferences.IsNotStranded;
-		}
-
-		if (ShipCandidate->GetDamageSystem()->IsUncontrollable() && ShipCandidate->GetDamageSystem()->IsDisarmed())
-		{
-			if(ShipCandidate->IsMilitary())
-			{
-				if (ShipCandidate->GetSize() == EFlarePartSize::S)
-				{
-					StateScore *= Preferences.IsUncontrollableSmallMilitary;
-				}
-				else
-				{
-					StateScore *= Preferences.IsUncontrollableLargeMilitary;
-				}
-			}
-			else
-			{
-				StateScore *= Preferences.IsUncontrollableCivil;
-			}
-		}
-		else
-		{
-			StateScore *= Preferences.IsNotUncontrollable;
-		}
-
-//		if(ShipCandidate->IsHarpooned())
-		if(ShipCandidate->GetCapturePointsMap().Num() > 0)
-		{
-			if(ShipCandidate->GetDamageSystem()->IsUncontrollable())
-			{
-				// Never target harpooned uncontrollable ships
-				continue;
-			}
-			StateScore *=  Preferences.IsHarpooned;
-		}
-
-		if (ShipCandidate->GetDescription()->IsUncapturable)
-		{
-			if (ShipCandidate->GetSize() == EFlarePartSize::L && HasLargeSalvager)
-			{
-				StateScore *= 0.50f;
-			}
-
-			else if (ShipCandidate->GetSize() == EFlarePartSize::S && HasSmallSalvager)
-			{
-				StateScore *= 0.50f;
-			}
-		}
-
-		DistanceScore = FMath::FRand();
-
-		Score = StateScore * (DistanceScore);
-
-		if (Score > 0)
-		{
-			if (BestTarget == NULL || Score > BestScore)
-			{
-				BestTarget = ShipCandidate;
-				BestScore = Score;
-			}
-		}
+	if (BestBucket)
+	{
+		BestTarget = BestBucket->Ships[RandomStream.RandRange(0, BestBucket->Ships.Num() - 1)];
 	}
 
 	return BestTarget;
@@ -630,7 +658,7 @@ bool UFlareBattle::SimulateShipAttack(UFlareSimulatedSpacecraft* Ship, int32 Wea
 		FireProbability = 0.9f;
 	}
 
-	if(FMath::FRand() < FireProbability)
+	if(RandomStream.FRand() < FireProbability)
 	{
 		// Fire with all weapon
 		for (int32 WeaponIndex = 0; WeaponIndex <  WeaponGroup->Weapons.Num(); WeaponIndex++)
@@ -665,7 +693,7 @@ bool UFlareBattle::SimulateShipWeaponAttack(UFlareSimulatedSpacecraft* Ship, FFl
 	{
 		// Fire 5 s of ammo with a hit probability of 10% + precision * usage ratio
 		float FiringPeriod = 1.f / (WeaponDescription->WeaponCharacteristics.GunCharacteristics.AmmoRate / 60.f);
-		float DamageDelay = FMath::Square(1.f- UsageRatio) * 10 * FiringPeriod * FMath::FRandRange(0.f, 1.f);
+		float DamageDelay = FMath::Square(1.f- UsageRatio) * 10 * FiringPeriod * RandomStream.FRandRange(0.f, 1.f);
 		float Delay = DamageDelay + FiringPeriod;
 
 		int32 AmmoToFire = FMath::Max(1, (int32) (5.f * (1.f/Delay)));
@@ -709,7 +737,7 @@ bool UFlareBattle::SimulateShipWeaponAttack(UFlareSimulatedSpacecraft* Ship, FFl
 
 		for (int32 BulletIndex = 0; BulletIndex <  AmmoToFire; BulletIndex++)
 		{
-			if(FMath::FRand() < Precision)
+			if(RandomStream.FRand() < Precision)
 			{
 				// Apply bullet damage
 				SimulateBulletDamage(WeaponDescription, ShipTarget, MeteoriteTarget, Ship);
@@ -723,7 +751,7 @@ bool UFlareBattle::SimulateShipWeaponAttack(UFlareSimulatedSpacecraft* Ship, FFl
 		// Drop one bomb with a hit probability of (1 + usable ratio + isUncontrollable)/3
 		if (ShipTarget)
 		{
-			if (FMath::FRand() < (1 + UsageRatio + (ShipTarget->GetDamageSystem()->IsUncontrollable() ? 1.f : 0.f)))
+			if (RandomStream.FRand() < (1 + UsageRatio + (ShipTarget->GetDamageSystem()->IsUncontrollable() ? 1.f : 0.f)))
 			{
 				// Apply bomb damage
 				SimulateBombDamage(WeaponDescription, ShipTarget, Ship);
@@ -742,6 +770,9 @@ bool UFlareBattle::SimulateShipWeaponAttack(UFlareSimulatedSpacecraft* Ship, FFl
 		FLOGV("Not supported weapon %s", *WeaponDescription->Identifier.ToString());
 		return false;
 	}
+
+	// Out of ammo ships are no longer dangerous
+	UpdateTargetTraits(Ship);
 	return true;
 }
 
@@ -772,12 +803,12 @@ void UFlareBattle::SimulateBulletDamage(FFlareSpacecraftComponentDescription* We
 	else if(WeaponDescription->WeaponCharacteristics.DamageType == EFlareShellDamageType::HighExplosive)
 	{
 		// Generate fragments
-		float FragmentHitRatio = FMath::FRandRange(0.01f, 0.1f);
+		float FragmentHitRatio = RandomStream.FRandRange(0.01f, 0.1f);
 		int32 FragmentCount = WeaponDescription->WeaponCharacteristics.AmmoFragmentCount * FragmentHitRatio;
 
 		for(int FragmentIndex = 0; FragmentIndex < FragmentCount; FragmentIndex++)
 		{
-			float FragmentPowerEffect = FMath::FRandRange(0.f, 2.f);
+			float FragmentPowerEffect = RandomStream.FRandRange(0.f, 2.f);
 			if (ShipTarget)
 			{
 				ApplyDamage(ShipTarget, FragmentPowerEffect * WeaponDescription->WeaponCharacteristics.ExplosionPower, EFlareDamage::DAM_HighExplosive, DamageSource);
@@ -804,7 +835,16 @@ void UFlareBattle::SimulateBombDamage(FFlareSpacecraftComponentDescription* Weap
 	{
 		FLOGV("UFlareBattle::SimulateBombDamage : salvaging %s for %s", *Target->GetImmatriculation().ToString(), *DamageSource->GetCompany()->GetCompanyName().ToString());
 //		Target->SetHarpooned(DamageSource->GetCompany());
-		DamageSource->GetCompany()->StartCapture(Target, false);
+		if (!PendingCaptures.Contains(Target) && DamageSource->GetCompany()->CanStartCapture(Target, false))
+		{
+			FFlareBattleEvent Event;
+			Event.Type = EFlareBattleEvent::Capture;
+			Event.Target = Target;
+			Event.Company = DamageSource->GetCompany();
+			Events.Add(Event);
+			PendingCaptures.Add(Target);
+			UpdateTargetTraits(Target);
+		}
 	}
 }
 
@@ -818,7 +858,11 @@ void UFlareBattle::ApplyMeteoriteDamage(FFlareMeteoriteSave* MeteoriteTarget, fl
 		LocalMeteorites.RemoveSwap(MeteoriteTarget);
 		if (PlayerAssetsFighting)
 		{
-			Game->GetQuestManager()->OnEvent(FFlareBundle().PutTag("meteorite-destroyed").PutName("sector", Sector->GetIdentifier()));
+			FFlareBattleEvent Event;
+			Event.Type = EFlareBattleEvent::MeteoriteDestroyed;
+			Event.Target = NULL;
+			Event.Company = NULL;
+			Events.Add(Event);
 		}
 	}
 }
@@ -830,7 +874,7 @@ void UFlareBattle::ApplyDamage(UFlareSimulatedSpacecraft* Target, float Energy,
 	int32 ComponentIndex;
 	if(DamageType == EFlareDamage::DAM_HighExplosive)
 	{
-		ComponentIndex = FMath::RandRange(0,  Target->GetData().Components.Num()-1);
+		ComponentIndex = RandomStream.RandRange(0,  Target->GetData().Components.Num()-1);
 	}
 	else
 	{
@@ -839,8 +883,15 @@ void UFlareBattle::ApplyDamage(UFlareSimulatedSpacecraft* Target, float Energy,
 
 	FFlareSpacecraftComponentSave* TargetComponent = &Target->GetData().Components[ComponentIndex];
 	FFlareSpacecraftComponentDescription* ComponentDescription = Catalog->Get(TargetComponent->ComponentIdentifier);
-	CombatLog::SpacecraftDamaged(Target, Energy, 0, FVector::ZeroVector, DamageType, DamageSource->GetCompany(), "SimulatedBattle");
-	Target->GetDamageSystem()->ApplyDamage(ComponentDescription, TargetComponent, Energy, DamageType, DamageSource);
+
+	FFlareBattleEvent Event;
+	Event.Type = EFlareBattleEvent::Damage;
+	Event.Target = Target;
+	Event.Company = NULL;
+	Event.Damage = Target->GetDamageSystem()->ApplyComponentDamage(ComponentDescription, TargetComponent, Energy, DamageType, DamageSource);
+	Events.Add(Event);
+
+	UpdateTargetTraits(Target);
 }
 
 int32 UFlareBattle::GetBestTargetComponent(UFlareSimulatedSpacecraft* TargetSpacecraft)
@@ -935,8 +986,188 @@ int32 UFlareBattle::GetBestTargetComponent(UFlareSimulatedSpacecraft* TargetSpac
 		return 0;
 	}
 
-	int32 ComponentIndex = FMath::RandRange(0, ComponentSelection.Num() - 1);
+	int32 ComponentIndex = RandomStream.RandRange(0, ComponentSelection.Num() - 1);
 	return ComponentSelection[ComponentIndex];
 }
 
+
+/*----------------------------------------------------
+	Target index
+----------------------------------------------------*/
+
+void UFlareBattle::BuildTargetIndex()
+{
+	TargetIndexes.Empty();
+	TargetTraits.Empty();
+
+	for (UFlareSimulatedSpacecraft* Ship : InitialSectorViableFightingShips)
+	{
+		TargetIndexes.FindOrAdd(Ship->GetCompany());
+	}
+
+	for (UFlareSimulatedSpacecraft* Target : Sector->GetSectorSpacecrafts())
+	{
+		if (Target->IsReserve())
+		{
+			// No in fight
+			continue;
+		}
+
+		uint32 Traits = GetTargetTraits(Target);
+		TargetTraits.Add(Target, Traits);
+
+		for (auto& Entry : TargetIndexes)
+		{
+			UFlareCompany* Company = Entry.Key;
+			if (Target->GetCompany() == Company)
+			{
+				continue;
+			}
+
+			// War doesn't change during a battle, quest contracts and player ships can
+			if (Target->GetCompany()->GetWarState(Company) == EFlareHostility::Hostile)
+			{
+				AddToBucket(Entry.Value, Target, Traits);
+			}
+			else if (Target->GetCompany()->IsPlayerCompany() || Company->IsPlayerCompany())
+			{
+				Entry.Value.ConditionalTargets.Add(Target);
+			}
+		}
+	}
+}
+
+uint32 UFlareBattle::GetTargetTraits(UFlareSimulatedSpacecraft* Target) const
+{
+	UFlareSimulatedSpacecraftDamageSystem* DamageSystem = Target->GetDamageSystem();
+	uint32 Traits = 0;
+
+	if (!DamageSystem->IsAlive())
+	{
+		// Ignore destroyed ships
+		return EFlareBattleTargetTrait::Excluded;
+	}
+
+	if (Target->IsStation())
+	{
+		if (Target->GetStationEfficiency() <= 0 || !Target->GetCompany()->IsPlayerCompany() || Target->GetCompany()->GetRetaliation() <= 0)
+		{
+			// Ignore damaged stations and companies without retaliation
+			return EFlareBattleTargetTrait::Excluded;
+		}
+		Traits |= EFlareBattleTargetTrait::Station;
+	}
+
+	if (Target->GetData().CapturePoints.Num() > 0 || PendingCaptures.Contains(Target))
+	{
+		if (DamageSystem->IsUncontrollable())
+		{
+			// Never target harpooned uncontrollable ships
+			return EFlareBattleTargetTrait::Excluded;
+		}
+		Traits |= EFlareBattleTargetTrait::Harpooned;
+	}
+
+	if (Target->GetSize() == EFlarePartSize::L)
+	{
+		Traits |= EFlareBattleTargetTrait::Large;
+	}
+	else if (Target->GetSize() == EFlarePartSize::S)
+	{
+		Traits |= EFlareBattleTargetTrait::Small;
+	}
+
+	if (Target->IsMilitary())
+	{
+		Traits |= EFlareBattleTargetTrait::Military;
+	}
+
+	if (Target->IsMilitaryArmed() && !DamageSystem->IsDisarmed())
+	{
+		Traits |= EFlareBattleTargetTrait::Dangerous;
+	}
+
+	if (DamageSystem->IsStranded())
+	{
+		Traits |= EFlareBattleTargetTrait::Stranded;
+	}
+
+	if (DamageSystem->IsUncontrollable() && DamageSystem->IsDisarmed())
+	{
+		Traits |= EFlareBattleTargetTrait::UncontrollableDisarmed;
+	}
+
+	if (Target->GetDescription()->IsUncapturable)
+	{
+		Traits |= EFlareBattleTargetTrait::Uncapturable;
+	}
+
+	return Traits;
+}
+
+void UFlareBattle::UpdateTargetTraits(UFlareSimulatedSpacecraft* Target)
+{
+	uint32* Traits = TargetTraits.Find(Target);
+	if (!Traits)
+	{
+		return;
+	}
+
+	uint32 NewTraits = GetTargetTraits(Target);
+	if (NewTraits == *Traits)
+	{
+		return;
+	}
+
+	for (auto& Entry : TargetIndexes)
+	{
+		if (Target->GetCompany() != Entry.Key && Target->GetCompany()->GetWarState(Entry.Key) == EFlareHostility::Hostile)
+		{
+			RemoveFromBucket(Entry.Value, Target, *Traits);
+			AddToBucket(Entry.Value, Target, NewTraits);
+		}
+	}
+
+	*Traits = NewTraits;
+}
+
+void UFlareBattle::AddToBucket(FFlareBattleTargetIndex& Index, UFlareSimulatedSpacecraft* Target, uint32 Traits)
+{
+	if (Traits & EFlareBattleTargetTrait::Excluded)
+	{
+		return;
+	}
+
+	for (FFlareBattleTargetBucket& Bucket : Index.Buckets)
+	{
+		if (Bucket.Traits == Traits)
+		{
+			Bucket.Ships.Add(Target);
+			return;
+		}
+	}
+
+	FFlareBattleTargetBucket Bucket;
+	Bucket.Traits = Traits;
+	Bucket.Ships.Add(Target);
+	Index.Buckets.Add(Bucket);
+}
+
+void UFlareBattle::RemoveFromBucket(FFlareBattleTargetIndex& Index, UFlareSimulatedSpacecraft* Target, uint32 Traits)
+{
+	if (Traits & EFlareBattleTargetTrait::Excluded)
+	{
+		return;
+	}
+
+	for (FFlareBattleTargetBucket& Bucket : Index.Buckets)
+	{
+		if (Bucket.Traits == Traits)
+		{
+			Bucket.Ships.RemoveSwap(Target);
+			return;
+		}
+	}
+}
+
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
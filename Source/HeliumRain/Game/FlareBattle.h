@@ -2,11 +2,50 @@
 
 #include "Object.h"
 #include "FlareSimulatedSector.h"
+#include "../Spacecrafts/Subsystems/FlareSimulatedSpacecraftDamageSystem.h"
 #include "FlareBattle.generated.h"
 
 class UFlareSpacecraftComponentsCatalog;
 
 
+/** Battle result that reaches outside of the battle sector */
+namespace EFlareBattleEvent
+{
+	enum Type
+	{
+		Damage,
+		Capture,
+		MeteoriteDestroyed
+	};
+}
+
+/** Battle result waiting to be committed */
+struct FFlareBattleEvent
+{
+	EFlareBattleEvent::Type                 Type;
+	UFlareSimulatedSpacecraft*              Target;
+	UFlareCompany*                          Company;
+	FFlareComponentDamage                   Damage;
+};
+
+/** Ships that look the same to an attacker */
+struct FFlareBattleTargetBucket
+{
+	uint32                                  Traits;
+	TArray<UFlareSimulatedSpacecraft*>      Ships;
+};
+
+/** Ships a company can fire at */
+struct FFlareBattleTargetIndex
+{
+	/** Ships of companies at war with this one, by traits */
+	TArray<FFlareBattleTargetBucket>        Buckets;
+
+	/** Ships whose hostility depends on quests and damage, checked at each pick */
+	TArray<UFlareSimulatedSpacecraft*>      ConditionalTargets;
+};
+
+
 UCLASS()
 class HELIUMRAIN_API UFlareBattle : public UObject
 {
@@ -25,8 +64,12 @@ public:
 		Gameplay
 	----------------------------------------------------*/
 
+	/** Simulate the fight. Only the battle sector is modified, other results are kept for CommitResults */
 	void Simulate();
 
+	/** Apply the results of the fight to the rest of the world */
+	void CommitResults();
+
 	bool SimulateTurn();
 
 	bool SimulateShipTurn(UFlareSimulatedSpacecraft* Ship);
@@ -53,6 +96,28 @@ public:
 	void FindFightingCompanies();
 
 protected:
+
+	/*----------------------------------------------------
+		Target index
+	----------------------------------------------------*/
+
+	/** Sort the sector spacecrafts by hostility to each fighting company, and by traits */
+	void BuildTargetIndex();
+
+	/** Get the traits that decide how attractive a target is */
+	uint32 GetTargetTraits(UFlareSimulatedSpacecraft* Target) const;
+
+	/** Move a target to the bucket matching its traits after damage, disarm or capture */
+	void UpdateTargetTraits(UFlareSimulatedSpacecraft* Target);
+
+	void AddToBucket(FFlareBattleTargetIndex& Index, UFlareSimulatedSpacecraft* Target, uint32 Traits);
+	void RemoveFromBucket(FFlareBattleTargetIndex& Index, UFlareSimulatedSpacecraft* Target, uint32 Traits);
+
+
+	/*----------------------------------------------------
+		Data
+	----------------------------------------------------*/
+
 	UFlareSimulatedSector*                  Sector;
 	AFlareGame*                             Game;
 	UFlareCompany*                          PlayerCompany;
@@ -68,6 +133,23 @@ protected:
 	bool									PlayerAssetsFighting;
 	bool									FoundFightingCompanies;
 	bool									ShipDisabledPreviousTurn;
+	bool									FightingCompaniesValid;
+	bool									FightingCompaniesWithMeteorites;
+
+	/** Random stream for this battle, seeded from the date and sector */
+	FRandomStream                           RandomStream;
+
+	/** Results to commit, in the order they happened */
+	TArray<FFlareBattleEvent>               Events;
+
+	/** Ships that will be captured when committing */
+	TArray<UFlareSimulatedSpacecraft*>      PendingCaptures;
+
+	/** Targets of each fighting company */
+	TMap<UFlareCompany*, FFlareBattleTargetIndex> TargetIndexes;
+
+	/** Current traits of every spacecraft in the fight */
+	TMap<UFlareSimulatedSpacecraft*, uint32> TargetTraits;
 
 public:
 
@@ -80,5 +162,10 @@ public:
 		return Game;
 	}
 
+	UFlareSimulatedSector* GetSector() const
+	{
+		return Sector;
+	}
+
         bool HasBattle();
 };
@@ -1,171 +1,370 @@
-
 #include "FlareCache.h"
 #include "../Flare.h"
 #include "FlareGame.h"
+#include "FlareAsteroid.h"
+
+#include "../Quests/FlareMeteorite.h"
+#include "../Spacecrafts/FlareBomb.h"
+#include "../Spacecrafts/FlareShell.h"
+
+#include "Engine/StaticMeshActor.h"
 
 #define LOCTEXT_NAMESPACE "FlareCacheSystem"
 #define DEBUG_SPACECRAFT_CACHE
 
+DECLARE_CYCLE_STAT(TEXT("FlareCache Prewarm"), STAT_FlareCache_Prewarm, STATGROUP_Flare);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("FlareCache Pooled actors"), STAT_FlareCache_PooledActors, STATGROUP_Flare);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("FlareCache Pooled spacecraft"), STAT_FlareCache_PooledSpacecraft, STATGROUP_Flare);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("FlareCache Hit rate"), STAT_FlareCache_HitRate, STATGROUP_Flare);
+DECLARE_MEMORY_STAT(TEXT("FlareCache Pooled memory"), STAT_FlareCache_Memory, STATGROUP_Flare);
+
+// Pool capacities, by type
+#define CACHE_SHELL_CAPACITY 1000
+#define CACHE_BOMB_CAPACITY 100
+#define CACHE_ASTEROID_CAPACITY 300
+#define CACHE_METEORITE_CAPACITY 50
+#define CACHE_DEBRIS_CAPACITY 300
+
+
 /*----------------------------------------------------
 	Constructor
 ----------------------------------------------------*/
 
-//TODO: perhaps use TMap or multi-layered Array and more generic get/store for each type
-//Key would probably be a string
-
 UFlareCacheSystem::UFlareCacheSystem(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, StoreSerial(0)
+	, PooledActorCount(0)
+	, PooledSpacecraftCount(0)
+	, PooledMemory(0)
+	, TotalHits(0)
+	, TotalMisses(0)
 {
 }
+
 void UFlareCacheSystem::InitialSetup(AFlareGame* GameMode)
 {
 	FCHECK(GameMode);
 	Game = GameMode;
 
-	CachedShells.Empty();
-	CachedBombs.Empty();
-	CachedAsteroids.Empty();
-	CachedDebris.Empty();
-	CachedSpacecraft.Empty();
+	Pools.Empty();
+	StoreSerial = 0;
+	PooledActorCount = 0;
+	PooledSpacecraftCount = 0;
+	PooledMemory = 0;
+	TotalHits = 0;
+	TotalMisses = 0;
+	UpdateStats();
 }
 
-void UFlareCacheSystem::StoreCachedSpacecraft(AFlareSpacecraft* Spacecraft)
-{
-	//TODO: Investigate what is still running on loaded/cached spacecraft which leads to progressively slower FPS during a game.
-//	return;
 
-	if (CachedSpacecraft.Contains(Spacecraft->GetParent()->GetDescription()->SpacecraftTemplate))
-	{
-		CachedSpacecraft[Spacecraft->GetParent()->GetDescription()->SpacecraftTemplate].TrackedSpacecraft.Add(Spacecraft);
-
-#ifdef DEBUG_SPACECRAFT_CACHE
-		FLOGV("UFlareCacheSystem::StoreCachedSpacecraft Store '%s' (template '%s') as already existing cache entry",
-			*Spacecraft->GetParent()->GetImmatriculation().ToString(),
-			*Spacecraft->GetParent()->GetDescription()->SpacecraftTemplate->GetName())
-#endif
+/*----------------------------------------------------
+	Public interface
+----------------------------------------------------*/
 
-	}
-	else
-	{
-		FFlareSpacecraftCacheHelper NewCacheHelper;
-		NewCacheHelper.TrackedSpacecraft.Add(Spacecraft);
-		CachedSpacecraft.Add(Spacecraft->GetParent()->GetDescription()->SpacecraftTemplate, NewCacheHelper);
+void UFlareCacheSystem::StoreCachedSpacecraft(AFlareSpacecraft* Spacecraft)
+{
+	UClass* SpacecraftTemplate = Spacecraft->GetParent()->GetDescription()->SpacecraftTemplate;
 
 #ifdef DEBUG_SPACECRAFT_CACHE
-		FLOGV("UFlareCacheSystem::StoreCachedSpacecraft Store '%s' (template '%s') as NewCacheHelper",
-			*Spacecraft->GetParent()->GetImmatriculation().ToString(),
-			*Spacecraft->GetParent()->GetDescription()->SpacecraftTemplate->GetName())
+	FLOGV("UFlareCacheSystem::StoreCachedSpacecraft Store '%s' (template '%s'), %d cached",
+		*Spacecraft->GetParent()->GetImmatriculation().ToString(),
+		*SpacecraftTemplate->GetName(),
+		GetPool(SpacecraftTemplate).Actors.Num());
 #endif
 
-	}
+	StoreActor(Spacecraft, SpacecraftTemplate);
 }
 
 AFlareSpacecraft* UFlareCacheSystem::RetrieveCachedSpacecraft(UClass* SpacecraftType)
 {
-	//TODO:
-//	return nullptr;
-
-	if (CachedSpacecraft.Contains(SpacecraftType) && CachedSpacecraft[SpacecraftType].TrackedSpacecraft.Num() > 0)
-	{
+	AFlareSpacecraft* Spacecraft = Cast<AFlareSpacecraft>(RetrieveActor(SpacecraftType));
 
 #ifdef DEBUG_SPACECRAFT_CACHE
+	if (Spacecraft)
+	{
 		FLOGV("UFlareCacheSystem::RetrieveCachedSpacecraft Retrieve '%s' for 'new' ship",
 			*SpacecraftType->GetName())
+	}
 #endif
 
-			return CachedSpacecraft[SpacecraftType].TrackedSpacecraft.Pop();
-	}
-	return nullptr;
+	return Spacecraft;
 }
 
 void UFlareCacheSystem::StoreCachedShell(AFlareShell* Shell)
 {
-	if (Shell)
-	{
-		CachedShells.Add(Shell);
-	}
+	StoreActor(Shell, AFlareShell::StaticClass());
 }
 
 AFlareShell* UFlareCacheSystem::RetrieveCachedShell()
 {
-	if (CachedShells.Num() > 0)
-	{
-		AFlareShell* Shell = CachedShells.Pop();
-		return Shell;
-	}
-	return NULL;
+	return Cast<AFlareShell>(RetrieveActor(AFlareShell::StaticClass()));
 }
 
 void UFlareCacheSystem::StoreCachedBomb(AFlareBomb* Bomb)
 {
-	if (Bomb)
-	{
-		CachedBombs.Add(Bomb);
-	}
+	StoreActor(Bomb, AFlareBomb::StaticClass());
 }
 
 AFlareBomb* UFlareCacheSystem::RetrieveCachedBomb()
 {
-	if (CachedBombs.Num() > 0)
-	{
-		AFlareBomb* Bomb = CachedBombs.Pop();
-		return Bomb;
-	}
-	return NULL;
+	return Cast<AFlareBomb>(RetrieveActor(AFlareBomb::StaticClass()));
 }
 
 void UFlareCacheSystem::StoreCachedAsteroid(AFlareAsteroid* Asteroid)
 {
-	if (Asteroid)
+	StoreActor(Asteroid, AFlareAsteroid::StaticClass());
+}
+
+AFlareAsteroid* UFlareCacheSystem::RetrieveCachedAsteroid()
+{
+	return Cast<AFlareAsteroid>(RetrieveActor(AFlareAsteroid::StaticClass()));
+}
+
+void UFlareCacheSystem::StoreCachedMeteorite(AFlareMeteorite* Meteorite)
+{
+	StoreActor(Meteorite, AFlareMeteorite::StaticClass());
+}
+
+AFlareMeteorite* UFlareCacheSystem::RetrieveCachedMeteorite()
+{
+	return Cast<AFlareMeteorite>(RetrieveActor(AFlareMeteorite::StaticClass()));
+}
+
+void UFlareCacheSystem::StoreCachedDebris(AStaticMeshActor* Debris)
+{
+	StoreActor(Debris, AStaticMeshActor::StaticClass());
+}
+
+AStaticMeshActor* UFlareCacheSystem::RetrieveCachedDebris()
+{
+	return Cast<AStaticMeshActor>(RetrieveActor(AStaticMeshActor::StaticClass()));
+}
+
+void UFlareCacheSystem::PrewarmActors(UClass* ActorClass, int32 Count)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareCache_Prewarm);
+
+	FFlareActorPool& Pool = GetPool(ActorClass);
+	int32 TargetCount = FMath::Min(Count, Pool.Capacity);
+	int32 SpawnCount = 0;
+
+	FActorSpawnParameters Params;
+	Params.bNoFail = true;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	while (Pool.Actors.Num() < TargetCount)
+	{
+		AActor* Actor = Game->GetWorld()->SpawnActor<AActor>(ActorClass, FVector::ZeroVector, FRotator::ZeroRotator, Params);
+		if (!Actor)
+		{
+			break;
+		}
+
+		Actor->SetActorHiddenInGame(true);
+		Actor->SetActorEnableCollision(false);
+		StoreActor(Actor, ActorClass);
+		SpawnCount++;
+	}
+
+	if (SpawnCount > 0)
 	{
-		CachedAsteroids.Add(Asteroid);
+		FLOGV("UFlareCacheSystem::PrewarmActors : spawned %d '%s'", SpawnCount, *ActorClass->GetName());
 	}
 }
 
-AFlareAsteroid* UFlareCacheSystem::RetrieveCachedAsteroid()
+void UFlareCacheSystem::PrintStats() const
 {
-	if (CachedAsteroids.Num() > 0)
+	FLOGV("UFlareCacheSystem::PrintStats : %d actors, %d spacecraft, %lld KB, %d hits, %d misses",
+		PooledActorCount, PooledSpacecraftCount, PooledMemory / 1024, TotalHits, TotalMisses);
+
+	for (const TPair<UClass*, FFlareActorPool>& Entry : Pools)
 	{
-		AFlareAsteroid* Asteroid = CachedAsteroids.Pop();
-		return Asteroid;
+		const FFlareActorPool& Pool = Entry.Value;
+		int32 Requests = Pool.Hits + Pool.Misses;
+
+		FLOGV("UFlareCacheSystem::PrintStats : '%s' %d/%d, %lld KB, hit rate %.1f%% (%d requests), %d evictions",
+			Entry.Key ? *Entry.Key->GetName() : TEXT("None"),
+			Pool.Actors.Num(), Pool.Capacity,
+			Pool.Actors.Num() * Pool.ActorSize / 1024,
+			Requests > 0 ? 100.f * Pool.Hits / Requests : 0.f, Requests,
+			Pool.Evictions);
 	}
-	return NULL;
 }
 
-void UFlareCacheSystem::StoreCachedMeteorite(AFlareMeteorite* Meteorite)
+
+/*----------------------------------------------------
+	Internals
+----------------------------------------------------*/
+
+void UFlareCacheSystem::StoreActor(AActor* Actor, UClass* PoolClass)
 {
-	if (Meteorite)
+	if (!IsValid(Actor))
+	{
+		return;
+	}
+
+	FFlareActorPool& Pool = GetPool(PoolClass);
+
+	FFlarePooledActor Entry;
+	Entry.Actor = Actor;
+	Entry.StoreSerial = StoreSerial++;
+	Entry.TickEnabled = Actor->IsActorTickEnabled();
+	Entry.Hidden = Actor->bHidden;
+	Entry.CollisionEnabled = Actor->GetActorEnableCollision();
+
+	// Nothing should run on a pooled actor
+	FTimerManager& TimerManager = Actor->GetWorldTimerManager();
+	Actor->SetActorTickEnabled(false);
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+	TimerManager.ClearAllTimersForObject(Actor);
+
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		if (Component)
+		{
+			if (Component->IsComponentTickEnabled())
+			{
+				Entry.TickingComponents.Add(Component);
+				Component->SetComponentTickEnabled(false);
+			}
+			TimerManager.ClearAllTimersForObject(Component);
+		}
+	}
+
+	// Measure the first actor of each pool
+	if (Pool.ActorSize == 0)
 	{
-		CachedMeteorites.Add(Meteorite);
+		Pool.ActorSize = Actor->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
 	}
+
+	Pool.Actors.Add(Entry);
+	PooledActorCount++;
+	PooledMemory += Pool.ActorSize;
+
+	if (Pool.IsSpacecraft)
+	{
+		PooledSpacecraftCount++;
+	}
+
+	if (!Pool.IsSpacecraft && Pool.Actors.Num() > Pool.Capacity)
+	{
+		EvictOldest(Pool);
+	}
+
+	UpdateStats();
 }
 
-AFlareMeteorite* UFlareCacheSystem::RetrieveCachedMeteorite()
+AActor* UFlareCacheSystem::RetrieveActor(UClass* PoolClass)
 {
-	if (CachedMeteorites.Num() > 0)
+	FFlareActorPool& Pool = GetPool(PoolClass);
+
+	// Reuse the most recently stored actor
+	while (Pool.Actors.Num() > 0)
 	{
-		AFlareMeteorite* Meteorite = CachedMeteorites.Pop();
-		return Meteorite;
+		FFlarePooledActor Entry = Pool.Actors.Pop(false);
+		PooledActorCount--;
+		PooledMemory -= Pool.ActorSize;
+		if (Pool.IsSpacecraft)
+		{
+			PooledSpacecraftCount--;
+		}
+
+		// Destroyed while pooled
+		if (!IsValid(Entry.Actor))
+		{
+			continue;
+		}
+
+		AActor* Actor = Entry.Actor;
+		Actor->SetActorHiddenInGame(Entry.Hidden);
+		Actor->SetActorEnableCollision(Entry.CollisionEnabled);
+		Actor->SetActorTickEnabled(Entry.TickEnabled);
+
+		for (UActorComponent* Component : Entry.TickingComponents)
+		{
+			if (IsValid(Component))
+			{
+				Component->SetComponentTickEnabled(true);
+			}
+		}
+
+		Pool.Hits++;
+		TotalHits++;
+		UpdateStats();
+		return Actor;
 	}
+
+	Pool.Misses++;
+	TotalMisses++;
+	UpdateStats();
 	return NULL;
 }
 
-void UFlareCacheSystem::StoreCachedDebris(AStaticMeshActor* Debris)
+FFlareActorPool& UFlareCacheSystem::GetPool(UClass* PoolClass)
 {
-	if (Debris)
+	FFlareActorPool* Pool = Pools.Find(PoolClass);
+
+	if (!Pool)
 	{
-		CachedDebris.Add(Debris);
+		Pool = &Pools.Add(PoolClass);
+
+		if (PoolClass->IsChildOf(AFlareSpacecraft::StaticClass()))
+		{
+			// Pilots and target lists keep raw pointers to spacecraft, never destroy them
+			Pool->Capacity = MAX_int32;
+			Pool->IsSpacecraft = true;
+		}
+		else if (PoolClass->IsChildOf(AFlareShell::StaticClass()))
+		{
+			Pool->Capacity = CACHE_SHELL_CAPACITY;
+		}
+		else if (PoolClass->IsChildOf(AFlareBomb::StaticClass()))
+		{
+			Pool->Capacity = CACHE_BOMB_CAPACITY;
+		}
+		else if (PoolClass->IsChildOf(AFlareAsteroid::StaticClass()))
+		{
+			Pool->Capacity = CACHE_ASTEROID_CAPACITY;
+		}
+		else if (PoolClass->IsChildOf(AFlareMeteorite::StaticClass()))
+		{
+			Pool->Capacity = CACHE_METEORITE_CAPACITY;
+		}
+		else
+		{
+			Pool->Capacity = CACHE_DEBRIS_CAPACITY;
+		}
 	}
+
+	return *Pool;
 }
 
-AStaticMeshActor* UFlareCacheSystem::RetrieveCachedDebris()
+void UFlareCacheSystem::EvictOldest(FFlareActorPool& Pool)
 {
-	if (CachedDebris.Num() > 0)
+	FCHECK(Pool.Actors.Num() > 0);
+	FCHECK(!Pool.IsSpacecraft);
+
+	AActor* Actor = Pool.Actors[0].Actor;
+	Pool.Actors.RemoveAt(0, 1, false);
+	Pool.Evictions++;
+	PooledActorCount--;
+	PooledMemory -= Pool.ActorSize;
+
+	if (IsValid(Actor))
 	{
-		AStaticMeshActor* Debris = CachedDebris.Pop();
-		return Debris;
+		Actor->Destroy();
 	}
-	return NULL;
 }
 
-#undef LOCTEXT_NAMESPACE
\ No newline at end of file
+void UFlareCacheSystem::UpdateStats()
+{
+	int32 Requests = TotalHits + TotalMisses;
+
+	SET_DWORD_STAT(STAT_FlareCache_PooledActors, PooledActorCount);
+	SET_DWORD_STAT(STAT_FlareCache_PooledSpacecraft, PooledSpacecraftCount);
+	SET_FLOAT_STAT(STAT_FlareCache_HitRate, Requests > 0 ? (float) TotalHits / Requests : 0.f);
+	SET_MEMORY_STAT(STAT_FlareCache_Memory, PooledMemory);
+}
+
+#undef LOCTEXT_NAMESPACE
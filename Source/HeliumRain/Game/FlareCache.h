@@ -10,14 +10,65 @@ class AFlareBomb;
 class AFlareAsteroid;
 class AFlareMeteorite;
 
+
+/** Actor waiting in a pool, with the tick state it had when stored */
+USTRUCT()
+struct FFlarePooledActor
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	AActor*                                    Actor;
+
+	/** Order in which actors were stored, across all pools */
+	uint64                                     StoreSerial;
+
+	/** Actor state when stored, restored on retrieval */
+	bool                                       TickEnabled;
+	bool                                       Hidden;
+	bool                                       CollisionEnabled;
+
+	/** Components that were ticking when stored */
+	UPROPERTY()
+	TArray<UActorComponent*>                   TickingComponents;
+};
+
+/** Pool of actors of one class, oldest first */
 USTRUCT()
-struct FFlareSpacecraftCacheHelper
+struct FFlareActorPool
 {
 	GENERATED_USTRUCT_BODY()
 
-	TArray<AFlareSpacecraft*> TrackedSpacecraft;
+	FFlareActorPool()
+		: Capacity(0)
+		, IsSpacecraft(false)
+		, ActorSize(0)
+		, Hits(0)
+		, Misses(0)
+		, Evictions(0)
+	{}
+
+	UPROPERTY()
+	TArray<FFlarePooledActor>                  Actors;
+
+	/** Maximum number of pooled actors */
+	int32                                      Capacity;
+
+	/** Spacecraft pools are never evicted */
+	bool                                       IsSpacecraft;
+
+	/** Estimated memory used by one pooled actor */
+	int64                                      ActorSize;
+
+	int32                                      Hits;
+	int32                                      Misses;
+	int32                                      Evictions;
 };
 
+
+/** Pools of hidden actors, reused instead of spawning new ones.
+ *  Each pool has a capacity where the least recently stored are destroyed first. Spacecraft are kept until reused.
+ *  Pooled actors don't tick and have no timers. */
 UCLASS()
 class HELIUMRAIN_API UFlareCacheSystem : public UObject
 {
@@ -48,38 +99,51 @@ public:
 	void StoreCachedDebris(AStaticMeshActor* Debris);
 	AStaticMeshActor* RetrieveCachedDebris();
 
+	/** Spawn actors until the pool of this class holds Count of them */
+	void PrewarmActors(UClass* ActorClass, int32 Count);
 
-private:
+	/** Log the state of all pools */
+	void PrintStats() const;
 
-	/*----------------------------------------------------
-		Internals
-	----------------------------------------------------*/
 
 protected:
 
 	/*----------------------------------------------------
-		Protected data
+		Internals
 	----------------------------------------------------*/
 
-	/** Game reference */
-	UPROPERTY()
-	AFlareGame*                                Game;
+	/** Quiesce an actor and add it to the pool of PoolClass, evicting the oldest one if the pool is full */
+	void StoreActor(AActor* Actor, UClass* PoolClass);
 
-	UPROPERTY()
-	TArray<AFlareShell*>					   CachedShells;
+	/** Take the most recently stored actor of PoolClass and restore its tick state */
+	AActor* RetrieveActor(UClass* PoolClass);
 
-	UPROPERTY()
-	TArray<AFlareBomb*>						   CachedBombs;
+	/** Get or create the pool of a class */
+	FFlareActorPool& GetPool(UClass* PoolClass);
 
-	UPROPERTY()
-	TArray<AFlareAsteroid*>					   CachedAsteroids;
+	/** Destroy the oldest actor of a pool, spacecraft pools excluded */
+	void EvictOldest(FFlareActorPool& Pool);
+
+	/** Refresh the pool stats */
+	void UpdateStats();
 
-	UPROPERTY()
-	TArray<AFlareMeteorite*>				   CachedMeteorites;
 
+	/*----------------------------------------------------
+		Protected data
+	----------------------------------------------------*/
+
+	/** Game reference */
 	UPROPERTY()
-	TArray<AStaticMeshActor*>				   CachedDebris;
+	AFlareGame*                                Game;
 
+	/** Pools, by actor class or spacecraft template */
 	UPROPERTY()
-	TMap<UClass*, FFlareSpacecraftCacheHelper> CachedSpacecraft;
-};
\ No newline at end of file
+	TMap<UClass*, FFlareActorPool>             Pools;
+
+	uint64                                     StoreSerial;
+	int32                                      PooledActorCount;
+	int32                                      PooledSpacecraftCount;
+	int64                                      PooledMemory;
+	int32                                      TotalHits;
+	int32                                      TotalMisses;
+};
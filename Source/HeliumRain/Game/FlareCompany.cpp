@@ -884,6 +884,11 @@ void UFlareCompany::SetHostilityTo(UFlareCompany* TargetCompany, bool Hostile, b
 			Game->GetPC()->UpdateOrbitalBattleStatesIfOpen();
 		}
 
+		for (UFlareSimulatedSector* Sector : Game->GetGameWorld()->GetSectors())
+		{
+			Sector->InvalidateSectorBattleStates();
+		}
+
 		UFlareSector* ActiveSector = Game->GetActiveSector();
 		if (ActiveSector)
 		{
@@ -1006,6 +1011,7 @@ UFlareFleet* UFlareCompany::LoadFleet(const FFlareFleetSave& FleetData)
 	Fleet = NewObject<UFlareFleet>(this, UFlareFleet::StaticClass());
 	Fleet->Load(FleetData);
 	CompanyFleets.AddUnique(Fleet);
+	GetGame()->GetGameWorld()->RegisterFleet(Fleet);
 
 	//FLOGV("UFlareWorld::LoadFleet : loaded fleet '%s'", *Fleet->GetFleetName().ToString());
 
@@ -1015,6 +1021,7 @@ UFlareFleet* UFlareCompany::LoadFleet(const FFlareFleetSave& FleetData)
 void UFlareCompany::RemoveFleet(UFlareFleet* Fleet)
 {
 	CompanyFleets.Remove(Fleet);
+	GetGame()->GetGameWorld()->UnregisterFleet(Fleet);
 }
 
 void UFlareCompany::MoveFleetUp(UFlareFleet* Fleet)
@@ -1185,6 +1192,7 @@ UFlareTradeRoute* UFlareCompany::LoadTradeRoute(const FFlareTradeRouteSave& Trad
 	TradeRoute = NewObject<UFlareTradeRoute>(this, UFlareTradeRoute::StaticClass());
 	TradeRoute->Load(TradeRouteData);
 	CompanyTradeRoutes.AddUnique(TradeRoute);
+	GetGame()->GetGameWorld()->RegisterTradeRoute(TradeRoute);
 
 	//FLOGV("UFlareCompany::LoadTradeRoute : loaded trade route '%s'", *TradeRoute->GetTradeRouteName().ToString());
 
@@ -1194,6 +1202,7 @@ UFlareTradeRoute* UFlareCompany::LoadTradeRoute(const FFlareTradeRouteSave& Trad
 void UFlareCompany::RemoveTradeRoute(UFlareTradeRoute* TradeRoute)
 {
 	CompanyTradeRoutes.Remove(TradeRoute);
+	GetGame()->GetGameWorld()->UnregisterTradeRoute(TradeRoute);
 }
 
 void UFlareCompany::CreatedSpaceCraft(UFlareSimulatedSpacecraft* Spacecraft)
@@ -1284,6 +1293,8 @@ UFlareSimulatedSpacecraft* UFlareCompany::LoadSpacecraft(const FFlareSpacecraftS
 				}
 			}
 		}
+
+		GetGame()->GetGameWorld()->RegisterSpacecraft(Spacecraft);
 	}
 	else
 	{
@@ -1365,6 +1376,7 @@ void UFlareCompany::DestroySpacecraft(UFlareSimulatedSpacecraft* Spacecraft)
 	CompanyAI->DestroySpacecraft(Spacecraft);
 	Spacecraft->SetDestroyed(true);
 	CompanyDestroyedSpacecrafts.Add(Spacecraft);
+	GetGame()->GetGameWorld()->RegisterSpacecraft(Spacecraft);
 }
 
 void UFlareCompany::DiscoverSector(UFlareSimulatedSector* Sector, bool VisitedSector)
@@ -2943,6 +2955,11 @@ void UFlareCompany::UpdateFactoryRequiredTechnologiesState()
 			Factory->SetHascheckedforrequiredtechnologies(false);
 		}
 	}
+
+	if (Game->GetGameWorld())
+	{
+		Game->GetGameWorld()->InvalidateEconomySnapshot();
+	}
 }
 
 bool UFlareCompany::UnlockTechnology(FName Identifier, bool FromSave, bool Force, bool HideMessage,bool UpdateFactoryRequiredTechs)
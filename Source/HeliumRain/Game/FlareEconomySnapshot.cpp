@@ -0,0 +1,133 @@
+
+#include "FlareEconomySnapshot.h"
+#include "../Flare.h"
+
+#include "../Data/FlareResourceCatalog.h"
+
+#include "FlareGame.h"
+#include "FlareWorld.h"
+#include "FlareSectorHelper.h"
+#include "FlareSimulatedSector.h"
+
+DECLARE_CYCLE_STAT(TEXT("FlareEconomySnapshot Update"), STAT_FlareEconomySnapshot_Update, STATGROUP_Flare);
+
+
+/*----------------------------------------------------
+	Constructor
+----------------------------------------------------*/
+
+FFlareEconomySnapshot::FFlareEconomySnapshot(bool InIncludeStorage)
+	: SectorCount(0)
+	, ResourceCount(0)
+	, Date(0)
+	, IncludeStorage(InIncludeStorage)
+	, Valid(false)
+{
+	FMemory::Memzero(EmptyStats);
+}
+
+
+/*----------------------------------------------------
+	Interface
+----------------------------------------------------*/
+
+void FFlareEconomySnapshot::Invalidate()
+{
+	Valid = false;
+}
+
+void FFlareEconomySnapshot::Prepare(UFlareWorld* World)
+{
+	if (!Valid || Date != World->GetDate())
+	{
+		Update(World);
+	}
+}
+
+
+/*----------------------------------------------------
+	Getters
+----------------------------------------------------*/
+
+const FFlareResourceStats& FFlareEconomySnapshot::GetSectorStats(UFlareWorld* World, UFlareSimulatedSector* Sector, FFlareResourceDescription* Resource)
+{
+	Prepare(World);
+
+	int32 SectorIndex = Sector->GetWorldIndex();
+	if (SectorIndex < 0 || SectorIndex >= SectorCount || Resource->CatalogIndex < 0 || Resource->CatalogIndex >= ResourceCount)
+	{
+		return EmptyStats;
+	}
+
+	return SectorStats[SectorIndex * ResourceCount + Resource->CatalogIndex];
+}
+
+const FFlareResourceStats& FFlareEconomySnapshot::GetWorldStats(UFlareWorld* World, FFlareResourceDescription* Resource)
+{
+	Prepare(World);
+
+	if (Resource->CatalogIndex < 0 || Resource->CatalogIndex >= ResourceCount)
+	{
+		return EmptyStats;
+	}
+
+	return WorldStats[Resource->CatalogIndex];
+}
+
+TMap<FFlareResourceDescription*, FFlareResourceStats> FFlareEconomySnapshot::GetWorldStatsMap(UFlareWorld* World)
+{
+	Prepare(World);
+
+	TArray<UFlareResourceCatalogEntry*>& Resources = World->GetGame()->GetResourceCatalog()->Resources;
+	TMap<FFlareResourceDescription*, FFlareResourceStats> Stats;
+	Stats.Reserve(ResourceCount);
+
+	for (int32 ResourceIndex = 0; ResourceIndex < ResourceCount; ResourceIndex++)
+	{
+		Stats.Add(&Resources[ResourceIndex]->Data, WorldStats[ResourceIndex]);
+	}
+
+	return Stats;
+}
+
+
+/*----------------------------------------------------
+	Internals
+----------------------------------------------------*/
+
+void FFlareEconomySnapshot::Update(UFlareWorld* World)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareEconomySnapshot_Update);
+
+	TArray<UFlareSimulatedSector*>& Sectors = World->GetSectors();
+	SectorCount = Sectors.Num();
+	ResourceCount = World->GetGame()->GetResourceCatalog()->Resources.Num();
+
+	SectorStats.SetNumUninitialized(SectorCount * ResourceCount);
+	WorldStats.SetNumUninitialized(ResourceCount);
+	FMemory::Memzero(WorldStats.GetData(), ResourceCount * sizeof(FFlareResourceStats));
+
+	for (int32 SectorIndex = 0; SectorIndex < SectorCount; SectorIndex++)
+	{
+		FFlareResourceStats* Stats = SectorStats.GetData() + SectorIndex * ResourceCount;
+		SectorHelper::ComputeSectorResourceStats(Sectors[SectorIndex], IncludeStorage, Stats);
+
+		for (int32 ResourceIndex = 0; ResourceIndex < ResourceCount; ResourceIndex++)
+		{
+			FFlareResourceStats& ResourceStats = WorldStats[ResourceIndex];
+			ResourceStats.Production += Stats[ResourceIndex].Production;
+			ResourceStats.Consumption += Stats[ResourceIndex].Consumption;
+			ResourceStats.Stock += Stats[ResourceIndex].Stock;
+			ResourceStats.Capacity += Stats[ResourceIndex].Capacity;
+		}
+	}
+
+	// Balance
+	for (FFlareResourceStats& ResourceStats : WorldStats)
+	{
+		ResourceStats.Balance = ResourceStats.Production - ResourceStats.Consumption;
+	}
+
+	Date = World->GetDate();
+	Valid = true;
+}
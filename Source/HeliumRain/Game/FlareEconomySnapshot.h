@@ -0,0 +1,73 @@
+#pragma once
+
+#include "../Flare.h"
+
+class UFlareWorld;
+class UFlareSimulatedSector;
+struct FFlareResourceDescription;
+
+
+/** Production, consumption and storage of a resource */
+struct FFlareResourceStats
+{
+	float Production;
+	float Consumption;
+	float Balance;
+	int32 Stock;
+	int32 Capacity;
+};
+
+/** Resource stats of all world sectors, computed at most once per day.
+ *  Stats are stored as dense sector x resource arrays, by sector world index and resource catalog index. */
+class FFlareEconomySnapshot
+{
+public:
+
+	FFlareEconomySnapshot(bool IncludeStorage = true);
+
+	/*----------------------------------------------------
+		Interface
+	----------------------------------------------------*/
+
+	/** The economy changed, the stats will be computed again on next use */
+	void Invalidate();
+
+	/** Compute the stats now if they are not from the current day */
+	void Prepare(UFlareWorld* World);
+
+
+	/*----------------------------------------------------
+		Getters
+	----------------------------------------------------*/
+
+	/** Stats of a resource in a world sector */
+	const FFlareResourceStats& GetSectorStats(UFlareWorld* World, UFlareSimulatedSector* Sector, FFlareResourceDescription* Resource);
+
+	/** Stats of a resource in the whole world */
+	const FFlareResourceStats& GetWorldStats(UFlareWorld* World, FFlareResourceDescription* Resource);
+
+	/** Stats of all resources in the whole world */
+	TMap<FFlareResourceDescription*, FFlareResourceStats> GetWorldStatsMap(UFlareWorld* World);
+
+
+protected:
+
+	/** Fill the arrays */
+	void Update(UFlareWorld* World);
+
+	/** SectorCount x ResourceCount */
+	TArray<FFlareResourceStats>          SectorStats;
+
+	/** ResourceCount */
+	TArray<FFlareResourceStats>          WorldStats;
+
+	/** Returned for sectors or resources outside of the world */
+	FFlareResourceStats                  EmptyStats;
+
+	int32                                SectorCount;
+	int32                                ResourceCount;
+	int64                                Date;
+	bool                                 IncludeStorage;
+	bool                                 Valid;
+
+};
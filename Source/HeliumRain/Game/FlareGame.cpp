@@ -319,6 +319,41 @@ void AFlareGame::StartPlay()
 		}
 	}
 	GetWorldTimerManager().SetTimer(SlowTick, this, &AFlareGame::SlowerTickFunction, 60.f, true, 60.f);
+
+	// Headless simulation benchmark : -FlareBenchmarkSlot=1 -FlareBenchmarkDays=30 [-FlareBenchmarkReport=File.json]
+	int32 BenchmarkSlot = 0;
+	int32 BenchmarkDays = 0;
+	if (FParse::Value(FCommandLine::Get(), TEXT("FlareBenchmarkSlot="), BenchmarkSlot)
+	 && FParse::Value(FCommandLine::Get(), TEXT("FlareBenchmarkDays="), BenchmarkDays))
+	{
+		RunSimulationBenchmark(BenchmarkSlot, BenchmarkDays);
+	}
+}
+
+void AFlareGame::RunSimulationBenchmark(int32 SlotIndex, int32 Days)
+{
+	FLOGV("AFlareGame::RunSimulationBenchmark : slot %d, %d days", SlotIndex, Days);
+
+	AFlarePlayerController* PC = Cast<AFlarePlayerController>(GetWorld()->GetFirstPlayerController());
+	FString ReportFileName;
+	if (!FParse::Value(FCommandLine::Get(), TEXT("FlareBenchmarkReport="), ReportFileName))
+	{
+		ReportFileName = FFlareSimulationProfiler::GetDefaultReportFileName();
+	}
+
+	SetCurrentSlot(SlotIndex);
+	bool Success = PC && LoadGame(PC);
+	if (Success)
+	{
+		Success = FFlareSimulationProfiler::RunBenchmark(World, Days, ReportFileName);
+	}
+	else
+	{
+		FLOGV("AFlareGame::RunSimulationBenchmark : could not load slot %d", SlotIndex);
+	}
+
+	FLOGV("AFlareGame::RunSimulationBenchmark : %s, exiting", Success ? TEXT("done") : TEXT("failed"));
+	FPlatformMisc::RequestExit(false);
 }
 
 void AFlareGame::PostLogin(APlayerController* Player)
@@ -95,6 +95,9 @@ public:
 	UFUNCTION()
 	void SlowerTickFunction();
 
+	/** Load a save slot, fast-forward it and exit, for headless benchmarks */
+	void RunSimulationBenchmark(int32 SlotIndex, int32 Days);
+
 	virtual void Scrap(FName ShipImmatriculation, FName TargetStationImmatriculation);
 
 	virtual void ScrapStation(UFlareSimulatedSpacecraft* Station);
@@ -406,6 +409,11 @@ public:
 		return CacheSystem;
 	}
 
+	UFlareSaveGameSystem* GetSaveGameSystem() const
+	{
+		return SaveGameSystem;
+	}
+
 	const FFlareCompanyDescription* GetCompanyDescription(int32 Index) const;
 
 	const FFlareCompanyDescription* GetPlayerCompanyDescription() const;
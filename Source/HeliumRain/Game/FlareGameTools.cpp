@@ -3,9 +3,11 @@
 #include "../Flare.h"
 
 #include "FlareGame.h"
+#include "FlareCache.h"
 #include "FlareCompany.h"
 #include "FlarePlanetarium.h"
 #include "FlareSectorHelper.h"
+#include "FlareSimulationProfiler.h"
 
 #include "../Data/FlareFactoryCatalogEntry.h"
 #include "../Data/FlareResourceCatalog.h"
@@ -17,6 +19,8 @@
 #include "../Player/FlareMenuManager.h"
 #include "../Player/FlarePlayerController.h"
 
+#include "Save/FlareSaveGameSystem.h"
+
 #include "Quests/FlareQuest.h"
 #include "Quests/FlareQuestStep.h"
 #include "Quests/FlareQuestManager.h"
@@ -24,6 +28,15 @@
 #define LOCTEXT_NAMESPACE "FlareGameTools"
 
 bool UFlareGameTools::FastFastForward = false;
+bool UFlareGameTools::ParallelTradeGeneration = true;
+bool UFlareGameTools::CompareTradeGeneration = false;
+bool UFlareGameTools::BinarySaves = false;
+bool UFlareGameTools::StreamingSaves = true;
+bool UFlareGameTools::ParallelPilots = true;
+bool UFlareGameTools::ParallelShells = true;
+int32 UFlareGameTools::SectorSpawnBudget = 10;
+bool UFlareGameTools::ParallelBattles = true;
+int32 UFlareGameTools::FastForwardBatchDays = 30;
 
 /*----------------------------------------------------
 	Constructor
@@ -559,6 +572,109 @@ void UFlareGameTools::SetFastFastForward(bool FFF)
 	FastFastForward = FFF;
 }
 
+void UFlareGameTools::SetParallelTradeGeneration(bool Parallel)
+{
+	ParallelTradeGeneration = Parallel;
+	FLOGV("UFlareGameTools::SetParallelTradeGeneration : %d", ParallelTradeGeneration);
+}
+
+void UFlareGameTools::SetCompareTradeGeneration(bool Compare)
+{
+	CompareTradeGeneration = Compare;
+	FLOGV("UFlareGameTools::SetCompareTradeGeneration : %d", CompareTradeGeneration);
+}
+
+void UFlareGameTools::BenchmarkSimulation(int32 Days)
+{
+	if (!GetGameWorld())
+	{
+		FLOG("UFlareGameTools::BenchmarkSimulation failed: no loaded world");
+		return;
+	}
+
+	GetGame()->DeactivateSector();
+	FFlareSimulationProfiler::RunBenchmark(GetGameWorld(), Days, FFlareSimulationProfiler::GetDefaultReportFileName());
+	GetGame()->ActivateCurrentSector();
+}
+
+void UFlareGameTools::PrintSimulationProfile()
+{
+	if (!GetGameWorld())
+	{
+		FLOG("UFlareGameTools::PrintSimulationProfile failed: no loaded world");
+		return;
+	}
+
+	GetGameWorld()->GetProfiler().PrintSummary();
+}
+
+void UFlareGameTools::SetBinarySaves(bool Binary)
+{
+	BinarySaves = Binary;
+	FLOGV("UFlareGameTools::SetBinarySaves : %d", BinarySaves);
+}
+
+void UFlareGameTools::SetStreamingSaves(bool Streaming)
+{
+	StreamingSaves = Streaming;
+	FLOGV("UFlareGameTools::SetStreamingSaves : %d", StreamingSaves);
+}
+
+void UFlareGameTools::SetParallelPilots(bool Parallel)
+{
+	ParallelPilots = Parallel;
+	FLOGV("UFlareGameTools::SetParallelPilots : %d", ParallelPilots);
+}
+
+void UFlareGameTools::SetParallelShells(bool Parallel)
+{
+	ParallelShells = Parallel;
+	FLOGV("UFlareGameTools::SetParallelShells : %d", ParallelShells);
+}
+
+void UFlareGameTools::SetSectorSpawnBudget(int32 Budget)
+{
+	SectorSpawnBudget = FMath::Max(Budget, 0);
+	FLOGV("UFlareGameTools::SetSectorSpawnBudget : %d", SectorSpawnBudget);
+}
+
+void UFlareGameTools::SetParallelBattles(bool Parallel)
+{
+	ParallelBattles = Parallel;
+	FLOGV("UFlareGameTools::SetParallelBattles : %d", ParallelBattles);
+}
+
+void UFlareGameTools::SetFastForwardBatchDays(int32 Days)
+{
+	FastForwardBatchDays = FMath::Max(Days, 1);
+	FLOGV("UFlareGameTools::SetFastForwardBatchDays : %d", FastForwardBatchDays);
+}
+
+void UFlareGameTools::ConvertSave(FString SaveName, bool ToBinary)
+{
+	if (!GetGame())
+	{
+		FLOG("UFlareGameTools::ConvertSave failed: no game");
+		return;
+	}
+
+	if (!GetGame()->GetSaveGameSystem()->ConvertGame(SaveName, ToBinary))
+	{
+		FLOGV("UFlareGameTools::ConvertSave failed: can't convert '%s'", *SaveName);
+	}
+}
+
+void UFlareGameTools::PrintCacheStats()
+{
+	if (!GetGame())
+	{
+		FLOG("UFlareGameTools::PrintCacheStats failed: no game");
+		return;
+	}
+
+	GetGame()->GetCacheSystem()->PrintStats();
+}
+
 /*----------------------------------------------------
 	Company tools
 ----------------------------------------------------*/
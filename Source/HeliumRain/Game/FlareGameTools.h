@@ -95,6 +95,58 @@ public:
 	UFUNCTION(exec)
 	void SetFastFastForward(bool FFF);
 
+	/** Generate trading needs, sources and idle ships in parallel during the daily simulation */
+	UFUNCTION(exec)
+	void SetParallelTradeGeneration(bool Parallel);
+
+	/** Generate trading needs, sources and idle ships again serially after the parallel pass, and log any difference */
+	UFUNCTION(exec)
+	void SetCompareTradeGeneration(bool Compare);
+
+	/** Fast-forward a number of days and write a simulation profile report */
+	UFUNCTION(exec)
+	void BenchmarkSimulation(int32 Days);
+
+	/** Print the average time of each simulation phase */
+	UFUNCTION(exec)
+	void PrintSimulationProfile();
+
+	/** Write new saves in the binary format instead of JSON */
+	UFUNCTION(exec)
+	void SetBinarySaves(bool Binary);
+
+	/** Stream JSON saves to disk instead of building the whole document in memory */
+	UFUNCTION(exec)
+	void SetStreamingSaves(bool Streaming);
+
+	/** Search for ship pilot collisions on all cores before the ships tick */
+	UFUNCTION(exec)
+	void SetParallelPilots(bool Parallel);
+
+	/** Trace gun shell paths on all cores */
+	UFUNCTION(exec)
+	void SetParallelShells(bool Parallel);
+
+	/** Spawn at most this many actors per frame when a sector is activated, 0 to spawn everything at once. Stations and player ships always spawn at once */
+	UFUNCTION(exec)
+	void SetSectorSpawnBudget(int32 Budget);
+
+	/** Simulate the automatic battles of different sectors on all cores */
+	UFUNCTION(exec)
+	void SetParallelBattles(bool Parallel);
+
+	/** Number of days skipped by the batched fast-forward */
+	UFUNCTION(exec)
+	void SetFastForwardBatchDays(int32 Days);
+
+	/** Convert a save between the JSON and binary formats */
+	UFUNCTION(exec)
+	void ConvertSave(FString SaveName, bool ToBinary);
+
+	/** Log the size, hit rate and memory of the actor cache pools */
+	UFUNCTION(exec)
+	void PrintCacheStats();
+
 	/*----------------------------------------------------
 		Company tools
 	----------------------------------------------------*/
@@ -324,5 +376,14 @@ public:
 	UFlareSector* GetActiveSector() const;
 
 	static bool FastFastForward;
+	static bool ParallelTradeGeneration;
+	static bool CompareTradeGeneration;
+	static bool BinarySaves;
+	static bool StreamingSaves;
+	static bool ParallelPilots;
+	static bool ParallelShells;
+	static int32 SectorSpawnBudget;
+	static bool ParallelBattles;
+	static int32 FastForwardBatchDays;
 
 };
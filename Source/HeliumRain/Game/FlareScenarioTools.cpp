@@ -95,19 +95,19 @@ void UFlareScenarioTools::Init(UFlareCompany* Company, FFlarePlayerSave* Player)
 
 	// Resources
 	Water =    Game->GetResourceCatalog()->Get("h2o");
-	Food =     Game->GetResourceCatalog()->Get("food");
-	Fuel =     Game->GetResourceCatalog()->Get("fuel");
+	Food =     Game->GetResourceCatalog()->Food;
+	Fuel =     Game->GetResourceCatalog()->Fuel;
 	Plastics = Game->GetResourceCatalog()->Get("plastics");
 	Hydrogen = Game->GetResourceCatalog()->Get("h2");
 	Helium =   Game->GetResourceCatalog()->Get("he3");
 	Silica =   Game->GetResourceCatalog()->Get("sio2");
 	IronOxyde =Game->GetResourceCatalog()->Get("feo");
 	Steel =    Game->GetResourceCatalog()->Get("steel");
-	Tools =    Game->GetResourceCatalog()->Get("tools");
-	Tech =     Game->GetResourceCatalog()->Get("tech");
+	Tools =    Game->GetResourceCatalog()->Tools;
+	Tech =     Game->GetResourceCatalog()->Tech;
 	Carbon =     Game->GetResourceCatalog()->Get("carbon");
 	Methane =     Game->GetResourceCatalog()->Get("ch4");
-	FleetSupply =     Game->GetResourceCatalog()->Get("fleet-supply");
+	FleetSupply =     Game->GetResourceCatalog()->FleetSupply;
 
 	// Ships
 	ShipSolen = "ship-solen";
@@ -3,6 +3,7 @@
 #include "../Flare.h"
 
 #include "FlareGame.h"
+#include "FlareGameTools.h"
 #include "FlarePlanetarium.h"
 #include "FlareSimulatedSector.h"
 #include "FlareCollider.h"
@@ -11,6 +12,13 @@
 
 #include "../Spacecrafts/FlareShell.h"
 #include "../Spacecrafts/FlareSpacecraft.h"
+#include "../Spacecrafts/FlareShipPilot.h"
+
+#include "Async/ParallelFor.h"
+
+DECLARE_CYCLE_STAT(TEXT("FlareSector PredictPilotCollisions"), STAT_FlareSector_PredictPilotCollisions, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareSector UpdateTargetCandidates"), STAT_FlareSector_UpdateTargetCandidates, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareSector StreamActors"), STAT_FlareSector_StreamActors, STATGROUP_Flare);
 
 /*----------------------------------------------------
 	Constructor
@@ -24,8 +32,24 @@
 #define SHIP_SMALL_EXPLOSION_CHANCE 0.10f
 #define SHIP_DRONE_EXPLOSION_CHANCE 0.50f
 
+// Cached shells to spawn on sector load, per armed ship
+#define SECTOR_PREWARM_SHELLS_PER_SHIP 10
+
+// Streamed sector activation : priority offsets by kind, then distance to the player
+#define SECTOR_STREAMING_HOSTILE_PRIORITY 0.f
+#define SECTOR_STREAMING_SHIP_PRIORITY 1e9f
+
+// Asteroids closer than 10km to the player are never streamed
+#define SECTOR_STREAMING_SYNC_DISTANCE 1000000.f
+
+// Full target searches allowed per tick, pilots without a target are not counted
+#define SECTOR_TARGET_SEARCHES_PER_TICK 8
+
 UFlareSector::UFlareSector(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, BroadphaseValid(false)
+	, SectorCollidersValid(false)
+	, RemainingTargetSearches(SECTOR_TARGET_SEARCHES_PER_TICK)
 {
 	SectorRepartitionCache = false;
 	IsDestroyingSector = false;
@@ -48,12 +72,34 @@ void UFlareSector::Load(UFlareSimulatedSector* Parent)
 	CompanyShipsPerCompanyCache.Empty();
 	CompanySpacecraftsPerCompanyCache.Empty();
 	SectorRepartitionCache = false;
+	SectorCollidersValid = false;
+
+	// Spawn stations and player ships now, stream the other ships and far asteroids in priority order
+	AFlarePlayerController* PC = Parent->GetGame()->GetPC();
+	UFlareSimulatedSpacecraft* PlayerShip = PC->GetPlayerShip();
+	bool Streaming = UFlareGameTools::SectorSpawnBudget > 0;
+	FVector ViewLocation = FVector::ZeroVector;
+	if (PlayerShip && PlayerShip->GetCurrentSector() == Parent)
+	{
+		ViewLocation = PlayerShip->GetData().Location;
+	}
 
 	// Load asteroids
+	TArray<TPair<float, int32>> StreamedAsteroids;
 	SectorAsteroids.Reserve(ParentSector->GetData()->AsteroidData.Num());
 	for (int i = 0 ; i < ParentSector->GetData()->AsteroidData.Num(); i++)
 	{
-		LoadAsteroid(ParentSector->GetData()->AsteroidData[i]);
+		const FFlareAsteroidSave& Asteroid = ParentSector->GetData()->AsteroidData[i];
+		float Distance = FVector::Dist(Asteroid.Location, ViewLocation);
+
+		if (Streaming && Distance > SECTOR_STREAMING_SYNC_DISTANCE)
+		{
+			StreamedAsteroids.Add(TPair<float, int32>(Distance, i));
+		}
+		else
+		{
+			LoadAsteroid(Asteroid);
+		}
 	}
 
 	// Load meteorite
@@ -70,19 +116,37 @@ void UFlareSector::Load(UFlareSimulatedSector* Parent)
 	SectorStations.Reserve(ParentSector->GetSectorStations().Num());
 	SectorShips.Reserve(ParentSector->GetSectorShips().Num());
 
+	// Stations are always there : docking, quests and menus expect their active actor
 	for (int i = 0; i < ParentSector->GetSectorStations().Num(); i++)
 	{
-		UFlareSimulatedSpacecraft* Spacecraft = ParentSector->GetSectorStations()[i];
-		LoadSpacecraft(Spacecraft,true);
+		LoadSpacecraft(ParentSector->GetSectorStations()[i], true);
 	}
 
+	TArray<TPair<float, UFlareSimulatedSpacecraft*>> StreamedSpacecrafts;
+
 	for (int i = 0; i < ParentSector->GetSectorShips().Num(); i++)
 	{
 		UFlareSimulatedSpacecraft* Spacecraft = ParentSector->GetSectorShips()[i];
 		if ((!Spacecraft->IsReserve() && Spacecraft->GetData().SpawnMode != EFlareSpawnMode::InternalDocked)
-			|| Parent->GetGame()->GetPC()->GetPlayerShip() == Spacecraft)
+			|| PlayerShip == Spacecraft)
 		{
-			LoadSpacecraft(Spacecraft, false);
+			if (Streaming && Spacecraft->GetCompany() != PC->GetCompany())
+			{
+				// Free hostiles first
+				float Priority = SECTOR_STREAMING_SHIP_PRIORITY;
+				if (Spacecraft->GetData().DockedTo == NAME_None && Spacecraft->GetData().AttachActorName == NAME_None
+					&& Spacecraft->GetCompany()->GetPlayerHostility() == EFlareHostility::Hostile)
+				{
+					Priority = SECTOR_STREAMING_HOSTILE_PRIORITY;
+				}
+
+				float Distance = FVector::Dist(Spacecraft->GetData().Location, ViewLocation);
+				StreamedSpacecrafts.Add(TPair<float, UFlareSimulatedSpacecraft*>(Priority + Distance, Spacecraft));
+			}
+			else
+			{
+				LoadSpacecraft(Spacecraft, false);
+			}
 		}
 	}
 
@@ -90,7 +154,15 @@ void UFlareSector::Load(UFlareSimulatedSector* Parent)
 	SectorBombs.Reserve(ParentSector->GetData()->BombData.Num());
 	for (int i = 0; i < ParentSector->GetData()->BombData.Num(); i++)
 	{
-		LoadBomb(ParentSector->GetData()->BombData[i]);
+		const FFlareBombSave& Bomb = ParentSector->GetData()->BombData[i];
+		if (Streaming && !FindSpacecraft(Bomb.ParentSpacecraft))
+		{
+			PendingBombs.Add(Bomb);
+		}
+		else
+		{
+			LoadBomb(Bomb);
+		}
 	}
 
 	IsDestroyingSector = false;
@@ -105,9 +177,33 @@ void UFlareSector::Load(UFlareSimulatedSector* Parent)
 		FinishLoadSpacecraft(SectorSpacecrafts[i], true);
 	}
 
-	for (UFlareCompany* Company : UniqueCompanies)
+	// Queue the rest, highest priority last
+	StreamedSpacecrafts.Sort([](const TPair<float, UFlareSimulatedSpacecraft*>& A, const TPair<float, UFlareSimulatedSpacecraft*>& B)
 	{
-		Company->NewSectorLoaded();
+		return A.Key > B.Key;
+	});
+	for (const TPair<float, UFlareSimulatedSpacecraft*>& Entry : StreamedSpacecrafts)
+	{
+		PendingSpacecrafts.Add(Entry.Value);
+	}
+
+	StreamedAsteroids.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B)
+	{
+		return A.Key > B.Key;
+	});
+	for (const TPair<float, int32>& Entry : StreamedAsteroids)
+	{
+		PendingAsteroids.Add(ParentSector->GetData()->AsteroidData[Entry.Value]);
+	}
+
+	if (IsStreaming())
+	{
+		FLOGV("UFlareSector::Load : streaming %d spacecrafts, %d asteroids, %d bombs",
+			PendingSpacecrafts.Num(), PendingAsteroids.Num(), PendingBombs.Num());
+	}
+	else
+	{
+		FinishStreaming();
 	}
 
 #ifdef DEBUG_SECTORLOADTIME
@@ -128,6 +224,16 @@ void UFlareSector::Tick(float DeltaSeconds)
 		UpdateSectorBattleStates();
 		SignalLocalSectorUpdateSectorBattleStates = false;
 	}
+
+	if (IsStreaming())
+	{
+		StreamActors();
+	}
+
+	// Everything moved since the last tick
+	InvalidateBroadphase();
+	InvalidateTargetCandidates();
+	RemainingTargetSearches = SECTOR_TARGET_SEARCHES_PER_TICK;
 	
 	for (int i = 0; i < SectorBombs.Num(); i++)
 	{
@@ -159,6 +265,20 @@ void UFlareSector::Tick(float DeltaSeconds)
 		}
 	}
 
+	// Move shells
+	if (!IsDestroyingSector)
+	{
+		AFlarePlayerController* PC = GetGame()->GetPC();
+		AFlareSpacecraft* ViewShip = PC ? PC->GetShipPawn() : NULL;
+		ShellSimulation.Tick(DeltaSeconds, ViewShip != NULL, ViewShip ? ViewShip->GetActorLocation() : FVector::ZeroVector);
+	}
+
+	// Search for pilot collisions on all cores, pilots use the results when they tick
+	if (UFlareGameTools::ParallelPilots && !IsDestroyingSector)
+	{
+		PredictPilotCollisions(DeltaSeconds);
+	}
+
 	for (int i = 0; i < SectorSpacecrafts.Num(); i++)
 	{
 		if (IsDestroyingSector)
@@ -179,6 +299,65 @@ void UFlareSector::Tick(float DeltaSeconds)
 	}
 }
 
+void UFlareSector::PredictPilotCollisions(float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareSector_PredictPilotCollisions);
+
+	PredictingPilots.Reset();
+	PredictedHostilities.Reset();
+	TArray<UFlareCompany*> LargeShipCompanies;
+	for (AFlareSpacecraft* Spacecraft : SectorSpacecrafts)
+	{
+		if (IsValid(Spacecraft)
+		 && !Spacecraft->IsSafeDestroying()
+		 && Spacecraft->GetPilot()
+		 && Spacecraft->GetStateManager()->IsPilotMode()
+		 && Spacecraft->GetParent()->GetDamageSystem()->IsAlive()
+		 && Spacecraft->GetPilot()->IsCollisionPredictionNeeded(DeltaSeconds))
+		{
+			PredictingPilots.Add(Spacecraft->GetPilot());
+			if (Spacecraft->GetSize() == EFlarePartSize::L)
+			{
+				LargeShipCompanies.AddUnique(Spacecraft->GetCompany());
+			}
+		}
+	}
+
+	if (PredictingPilots.Num() == 0)
+	{
+		return;
+	}
+
+	// Large ships ignore dangerous hostile small ships. Hostility reads the quest manager caches, check it here.
+	if (LargeShipCompanies.Num() > 0)
+	{
+		for (AFlareSpacecraft* Spacecraft : SectorSpacecrafts)
+		{
+			if (IsValid(Spacecraft)
+			 && !Spacecraft->IsSafeDestroying()
+			 && Spacecraft->GetSize() == EFlarePartSize::S
+			 && PilotHelper::IsTargetDangerous(PilotHelper::PilotTarget(Spacecraft)))
+			{
+				for (UFlareCompany* Company : LargeShipCompanies)
+				{
+					if (Spacecraft->IsHostile(Company))
+					{
+						PredictedHostilities.Add(TPair<AFlareSpacecraft*, UFlareCompany*>(Spacecraft, Company));
+					}
+				}
+			}
+		}
+	}
+
+	// Build the broadphase here so that the workers only read it
+	GetBroadphase();
+
+	ParallelFor(PredictingPilots.Num(), [&](int32 PilotIndex)
+	{
+		PredictingPilots[PilotIndex]->PredictCollision();
+	});
+}
+
 void UFlareSector::UpdateSectorBattleStates()
 {
 	for (UFlareCompany* Company : UniqueCompanies)
@@ -252,12 +431,16 @@ void UFlareSector::Save()
 		SectorData->BombData.Add(*SectorBombs[i]->Save());
 	}
 
-	SectorData->AsteroidData.Reserve(SectorAsteroids.Num());
+	SectorData->AsteroidData.Reserve(SectorAsteroids.Num() + PendingAsteroids.Num());
 	for (int i = 0 ; i < SectorAsteroids.Num(); i++)
 	{
 		SectorData->AsteroidData.Add(*SectorAsteroids[i]->Save());
 	}
 
+	// Not streamed in yet
+	SectorData->AsteroidData.Append(PendingAsteroids);
+	SectorData->BombData.Append(PendingBombs);
+
 	for (AFlareMeteorite* Meteorite : SectorMeteorites)
 	{
 		if (IsValid(Meteorite) && !Meteorite->IsBroken())
@@ -349,6 +532,9 @@ void UFlareSector::RemoveSpacecraft(AFlareSpacecraft* Spacecraft, bool RemoveSec
 		{
 			CompanySpacecraftsPerCompanyCache[Company].Remove(Spacecraft);
 		}
+
+		InvalidateBroadphase();
+		InvalidateTargetCandidates();
 	}
 }
 
@@ -382,6 +568,18 @@ void UFlareSector::DestroySector()
 		SectorStations[SpacecraftIndex]->SafeDestroy();
 	}
 
+	// Return spacecraft actors to the cache, the player ship stays bound to be flown again
+	UFlareSimulatedSpacecraft* PlayerParent = GetGame()->GetPC() ? GetGame()->GetPC()->GetPlayerShip() : nullptr;
+	for (AFlareSpacecraft* Spacecraft : SectorSpacecrafts)
+	{
+		UFlareSimulatedSpacecraft* Parent = Spacecraft->GetParent();
+		if (Spacecraft != PlayerShip && Parent && Parent != PlayerParent && Parent->GetActive() == Spacecraft)
+		{
+			Parent->SetActiveSpacecraft(nullptr);
+			GetGame()->GetCacheSystem()->StoreCachedSpacecraft(Spacecraft);
+		}
+	}
+
 	for (int BombIndex = 0 ; BombIndex < SectorBombs.Num(); BombIndex++)
 	{
 		if (SectorBombs[BombIndex])
@@ -411,6 +609,8 @@ void UFlareSector::DestroySector()
 		}
 	}
 
+	ShellSimulation.Reset();
+
 	UniqueCompanies.Empty();
 	SectorSpacecrafts.Empty();
 	SectorShips.Empty();
@@ -422,6 +622,87 @@ void UFlareSector::DestroySector()
 	CompanyShipsPerCompanyCache.Empty();
 	CompanySpacecraftsPerCompanyCache.Empty();
 	SectorSpacecraftsCache.Empty();
+	SectorColliders.Empty();
+	TargetCandidates.Empty();
+	PendingSpacecrafts.Empty();
+	PendingAsteroids.Empty();
+	PendingBombs.Empty();
+	InvalidateBroadphase();
+}
+
+void UFlareSector::StreamActors()
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareSector_StreamActors);
+
+	int32 Budget = UFlareGameTools::SectorSpawnBudget > 0 ? UFlareGameTools::SectorSpawnBudget : MAX_int32;
+	int32 SpawnCount = 0;
+
+	// Spacecrafts, with their complex elements
+	while (SpawnCount < Budget && PendingSpacecrafts.Num() > 0)
+	{
+		UFlareSimulatedSpacecraft* Spacecraft = PendingSpacecrafts.Pop(false);
+
+		// Loaded or moved away meanwhile. Ships that left the previous active sector still hold their hidden actor, they are loaded again.
+		bool Loaded = Spacecraft->IsActive() && FindSpacecraft(Spacecraft->GetImmatriculation()) == Spacecraft->GetActive();
+		if (Loaded || Spacecraft->GetCurrentSector() != ParentSector)
+		{
+			continue;
+		}
+
+		int32 FirstIndex = SectorSpacecrafts.Num();
+		LoadSpacecraft(Spacecraft, Spacecraft->IsStation());
+
+		for (int32 Index = FirstIndex; Index < SectorSpacecrafts.Num(); Index++)
+		{
+			FinishLoadSpacecraftReattachRedock(SectorSpacecrafts[Index]);
+		}
+
+		for (int32 Index = FirstIndex; Index < SectorSpacecrafts.Num(); Index++)
+		{
+			FinishLoadSpacecraft(SectorSpacecrafts[Index], true);
+		}
+
+		SpawnCount += FMath::Max(SectorSpacecrafts.Num() - FirstIndex, 1);
+	}
+
+	// Asteroids, closest first
+	while (SpawnCount < Budget && PendingAsteroids.Num() > 0)
+	{
+		LoadAsteroid(PendingAsteroids.Pop(false));
+		SpawnCount++;
+	}
+
+	// Bombs, once all ships are there
+	while (SpawnCount < Budget && PendingBombs.Num() > 0 && PendingSpacecrafts.Num() == 0)
+	{
+		LoadBomb(PendingBombs.Pop(false));
+		SpawnCount++;
+	}
+
+	if (!IsStreaming())
+	{
+		FLOG("UFlareSector::StreamActors : sector fully loaded");
+		FinishStreaming();
+	}
+}
+
+void UFlareSector::FinishStreaming()
+{
+	for (UFlareCompany* Company : UniqueCompanies)
+	{
+		Company->NewSectorLoaded();
+	}
+
+	// Spawn shells now rather than during the first fight
+	int32 ArmedShipCount = 0;
+	for (AFlareSpacecraft* Ship : SectorShips)
+	{
+		if (Ship->IsMilitaryArmed())
+		{
+			ArmedShipCount++;
+		}
+	}
+	GetGame()->GetCacheSystem()->PrewarmActors(AFlareShell::StaticClass(), ArmedShipCount * SECTOR_PREWARM_SHELLS_PER_SHIP);
 }
 
 /*----------------------------------------------------
@@ -447,6 +728,7 @@ AFlareAsteroid* UFlareSector::LoadAsteroid(const FFlareAsteroidSave& AsteroidDat
 	} 
 	Asteroid->Load(AsteroidData);
 	SectorAsteroids.AddUnique(Asteroid);
+	InvalidateBroadphase();
 	return Asteroid;
 }
 
@@ -467,12 +749,14 @@ AFlareMeteorite* UFlareSector::LoadMeteorite(FFlareMeteoriteSave& MeteoriteData)
 	}
 	Meteorite->Load(&MeteoriteData, this);
 	SectorMeteorites.AddUnique(Meteorite);
+	InvalidateBroadphase();
 	return Meteorite;
 }
 
 void UFlareSector::RemoveSectorMeteorite(AFlareMeteorite* Meteorite)
 {
 	SectorMeteorites.RemoveSwap(Meteorite);
+	InvalidateBroadphase();
 }
 
 AFlareSpacecraft* UFlareSector::LoadSpacecraft(UFlareSimulatedSpacecraft* ParentSpacecraft,bool Reposition)
@@ -528,6 +812,8 @@ AFlareSpacecraft* UFlareSector::LoadSpacecraft(UFlareSimulatedSpacecraft* Parent
 
 		SectorSpacecrafts.Add(Spacecraft);
 		SectorSpacecraftsCache.Add(Spacecraft->GetImmatriculation(), Spacecraft);
+		InvalidateBroadphase();
+		InvalidateTargetCandidates();
 
 		if (CompanySpacecraftsPerCompanyCache.Contains(ParentSpacecraft->GetCompany()))
 		{
@@ -846,6 +1132,7 @@ AFlareBomb* UFlareSector::LoadBomb(const FFlareBombSave& BombData)
 				RootComponent->SetPhysicsLinearVelocity(BombData.LinearVelocity, false);
 				RootComponent->SetPhysicsAngularVelocityInDegrees(BombData.AngularVelocity, false);
 				SectorBombs.Add(Bomb);
+				InvalidateBroadphase();
 			}
 			else
 			{
@@ -868,12 +1155,15 @@ AFlareBomb* UFlareSector::LoadBomb(const FFlareBombSave& BombData)
 void UFlareSector::RegisterBomb(AFlareBomb* Bomb)
 {
 	SectorBombs.AddUnique(Bomb);
+	InvalidateBroadphase();
 }
 
 void UFlareSector::UnregisterBomb(AFlareBomb* Bomb)
 {
 	if (SectorBombs.RemoveSwap(Bomb))
 	{
+		InvalidateBroadphase();
+
 		//todo: let bomb know what's targetting it for smaller checks
 		for (AFlareSpacecraft* Spacecraft : SectorSpacecrafts)
 		{
@@ -924,56 +1214,175 @@ void UFlareSector::SetPause(bool Pause)
 	{
 		SectorShells[i]->SetPause(Pause);
 	}
+
+	if (!Pause)
+	{
+		ShellSimulation.ResetVisibility();
+	}
 }
 
 AActor* UFlareSector::GetNearestBody(FVector Location, float* NearestDistance, bool IncludeSize, AActor* ActorToIgnore)
 {
-	AActor* NearestCandidateActor = NULL;
 	float NearestCandidateActorDistance = 0;
+	AActor* NearestCandidateActor = GetBroadphase().FindNearest(Location,
+		EFlareBroadphaseBody::Spacecraft | EFlareBroadphaseBody::Asteroid | EFlareBroadphaseBody::Collider,
+		ActorToIgnore, NearestCandidateActorDistance);
 
-	for (int32 SpacecraftIndex = 0; SpacecraftIndex < SectorSpacecrafts.Num(); SpacecraftIndex++)
+	*NearestDistance = NearestCandidateActorDistance;
+	return NearestCandidateActor;
+}
+
+const FFlareSectorBroadphase& UFlareSector::GetBroadphase()
+{
+	if (!BroadphaseValid)
 	{
-		AFlareSpacecraft* SpacecraftCandidate = GetSpacecrafts()[SpacecraftIndex];
-		float Distance = FVector::Dist(SpacecraftCandidate->GetActorLocation(), Location) - SpacecraftCandidate->GetMeshScale();
-		if (SpacecraftCandidate != ActorToIgnore && (!NearestCandidateActor || NearestCandidateActorDistance > Distance))
+		UpdateBroadphase();
+	}
+
+	return Broadphase;
+}
+
+void UFlareSector::InvalidateBroadphase()
+{
+	BroadphaseValid = false;
+}
+
+void UFlareSector::UpdateBroadphase()
+{
+	// Colliders are part of the level and don't move
+	if (!SectorCollidersValid)
+	{
+		SectorColliders.Empty();
+		UGameplayStatics::GetAllActorsOfClass(GetGame()->GetWorld(), AFlareCollider::StaticClass(), SectorColliders);
+		SectorCollidersValid = true;
+	}
+
+	Broadphase.Reset();
+
+	for (AFlareSpacecraft* Spacecraft : SectorSpacecrafts)
+	{
+		if (Spacecraft)
 		{
-			NearestCandidateActor = SpacecraftCandidate;
-			NearestCandidateActorDistance = Distance;
+			Broadphase.AddBody(Spacecraft, Spacecraft->GetActorLocation(), Spacecraft->GetMeshScale(), EFlareBroadphaseBody::Spacecraft);
 		}
 	}
 
-	for (int32 AsteroidIndex = 0; AsteroidIndex < GetAsteroids().Num(); AsteroidIndex++)
+	for (AFlareAsteroid* Asteroid : SectorAsteroids)
 	{
-		AFlareAsteroid* AsteroidCandidate = GetAsteroids()[AsteroidIndex];
-
-		FBox CandidateBox = AsteroidCandidate->GetComponentsBoundingBox();
-		float CandidateSize = FMath::Max(CandidateBox.GetExtent().Size(), 1.0f);
+		if (Asteroid)
+		{
+			FBox CandidateBox = Asteroid->GetComponentsBoundingBox();
+			Broadphase.AddBody(Asteroid, Asteroid->GetActorLocation(), FMath::Max(CandidateBox.GetExtent().Size(), 1.0f), EFlareBroadphaseBody::Asteroid);
+		}
+	}
 
-		float Distance = FVector::Dist(AsteroidCandidate->GetActorLocation(), Location) - CandidateSize;
-		if (AsteroidCandidate != ActorToIgnore && (!NearestCandidateActor || NearestCandidateActorDistance > Distance))
+	for (AFlareMeteorite* Meteorite : SectorMeteorites)
+	{
+		if (IsValid(Meteorite))
 		{
-			NearestCandidateActor = AsteroidCandidate;
-			NearestCandidateActorDistance = Distance;
+			FBox CandidateBox = Meteorite->GetComponentsBoundingBox();
+			Broadphase.AddBody(Meteorite, Meteorite->GetActorLocation(), FMath::Max(CandidateBox.GetExtent().Size(), 1.0f), EFlareBroadphaseBody::Meteorite);
 		}
 	}
 
-	TArray<AActor*> ColliderActorList;
-	UGameplayStatics::GetAllActorsOfClass(GetGame()->GetWorld(), AFlareCollider::StaticClass(), ColliderActorList);
-	for (int32 ColliderIndex = 0; ColliderIndex < ColliderActorList.Num(); ColliderIndex++)
+	for (AFlareBomb* Bomb : SectorBombs)
 	{
-		AActor* ColliderCandidate = ColliderActorList[ColliderIndex];
+		if (IsValid(Bomb))
+		{
+			FBox CandidateBox = Bomb->GetComponentsBoundingBox();
+			Broadphase.AddBody(Bomb, Bomb->GetActorLocation(), FMath::Max(CandidateBox.GetExtent().Size(), 1.0f), EFlareBroadphaseBody::Bomb);
+		}
+	}
 
-		float CandidateSize = Cast<UStaticMeshComponent>(ColliderCandidate->GetRootComponent())->Bounds.SphereRadius;
-		float Distance = FVector::Dist(ColliderCandidate->GetActorLocation(), Location) - CandidateSize;
-		if (ColliderCandidate != ActorToIgnore && (!NearestCandidateActor || NearestCandidateActorDistance > Distance))
+	for (AActor* Collider : SectorColliders)
+	{
+		UStaticMeshComponent* ColliderComponent = IsValid(Collider) ? Cast<UStaticMeshComponent>(Collider->GetRootComponent()) : NULL;
+		if (ColliderComponent)
 		{
-			NearestCandidateActor = ColliderCandidate;
-			NearestCandidateActorDistance = Distance;
+			Broadphase.AddBody(Collider, Collider->GetActorLocation(), ColliderComponent->Bounds.SphereRadius, EFlareBroadphaseBody::Collider);
 		}
 	}
 
-	*NearestDistance = NearestCandidateActorDistance;
-	return NearestCandidateActor;
+	Broadphase.Build();
+	BroadphaseValid = true;
+}
+
+const TArray<FFlareTargetCandidate>& UFlareSector::GetTargetCandidates(UFlareCompany* Company)
+{
+	FFlareTargetCandidateList& List = TargetCandidates.FindOrAdd(Company);
+	if (!List.Valid)
+	{
+		UpdateTargetCandidates(Company, List.Candidates);
+		List.Valid = true;
+	}
+
+	return List.Candidates;
+}
+
+void UFlareSector::InvalidateTargetCandidates()
+{
+	for (auto& Entry : TargetCandidates)
+	{
+		Entry.Value.Valid = false;
+	}
+}
+
+bool UFlareSector::ConsumeTargetSearch()
+{
+	if (RemainingTargetSearches > 0)
+	{
+		RemainingTargetSearches--;
+		return true;
+	}
+
+	return false;
+}
+
+void UFlareSector::UpdateTargetCandidates(UFlareCompany* Company, TArray<FFlareTargetCandidate>& Candidates)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareSector_UpdateTargetCandidates);
+
+	Candidates.Reset();
+	float Limits = GetSectorLimits();
+
+	for (AFlareSpacecraft* Spacecraft : SectorSpacecrafts)
+	{
+		if (!IsValid(Spacecraft) || Spacecraft->IsSafeDestroying() || !Spacecraft->IsHostile(Company))
+		{
+			continue;
+		}
+
+		UFlareSimulatedSpacecraft* Parent = Spacecraft->GetParent();
+		if (!Parent->GetDamageSystem()->IsAlive() || Spacecraft->GetActorLocation().Size() > Limits)
+		{
+			continue;
+		}
+
+		FFlareTargetCandidate Candidate;
+		Candidate.Spacecraft = Spacecraft;
+		Candidate.Size = Parent->GetSize();
+		Candidate.IncomingBombs = Spacecraft->GetIncomingActiveBombQuantity();
+		Candidate.IsStation = Parent->IsStation();
+		Candidate.IsMilitary = Parent->IsMilitary();
+		Candidate.IsDangerous = PilotHelper::IsTargetDangerous(PilotHelper::PilotTarget(Spacecraft));
+		Candidate.IsStranded = Parent->GetDamageSystem()->IsStranded();
+		Candidate.IsUncontrollable = Parent->GetDamageSystem()->IsUncontrollable();
+		Candidate.IsDisarmed = Parent->GetDamageSystem()->IsDisarmed();
+		Candidate.IsHarpooned = Parent->GetCapturePointsMap().Num() > 0;
+		Candidate.IsUncapturable = Spacecraft->GetDescription()->IsUncapturable;
+
+		// Never target harpooned uncontrollable ships
+		if (Candidate.IsHarpooned && Candidate.IsUncontrollable)
+		{
+			continue;
+		}
+
+		// All non player company, attack player station if there is retaliation
+		Candidate.CanTargetStation = Company->IsPlayerCompany()
+			|| (Spacecraft->GetCompany()->IsPlayerCompany() && Spacecraft->GetCompany()->GetRetaliation() > 0);
+
+		Candidates.Add(Candidate);
+	}
 }
 
 void UFlareSector::PlaceSpacecraftDrone(AFlareSpacecraft* Spacecraft, FVector Location, FRotator Rotation, float RandomLocationRadiusIncrement, float InitialLocationRadius, bool PositiveOrNegative)
@@ -1030,6 +1439,7 @@ void UFlareSector::PlaceSpacecraftDrone(AFlareSpacecraft* Spacecraft, FVector Lo
 	} while (EffectiveDistance <= 0 && RandomLocationRadius < RandomLocationRadiusIncrement * 1000);
 
 	Spacecraft->SetActorLocationAndRotation(Location, Rotation);
+	InvalidateBroadphase();
 }
 
 
@@ -1106,6 +1516,7 @@ void UFlareSector::PlaceSpacecraft(AFlareSpacecraft* Spacecraft, FVector Locatio
 	}
 #endif
 	Spacecraft->SetActorLocationAndRotation(Location,Rotation);
+	InvalidateBroadphase();
 }
 
 /*----------------------------------------------------
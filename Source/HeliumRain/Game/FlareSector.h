@@ -6,12 +6,43 @@
 #include "FlareAsteroid.h"
 #include "../Quests/FlareMeteorite.h"
 #include "FlareSimulatedSector.h"
+#include "FlareSectorBroadphase.h"
+#include "FlareShellSimulation.h"
 #include "FlareSector.generated.h"
 
 class UFlareSimulatedSector;
 class AFlareGame;
 class AFlareAsteroid;
 
+
+/** Hostile spacecraft a company can target, with the attributes target selection scores */
+struct FFlareTargetCandidate
+{
+	AFlareSpacecraft*                        Spacecraft;
+	EFlarePartSize::Type                     Size;
+	int32                                    IncomingBombs;
+	bool                                     IsStation;
+	bool                                     CanTargetStation;
+	bool                                     IsMilitary;
+	bool                                     IsDangerous;
+	bool                                     IsStranded;
+	bool                                     IsUncontrollable;
+	bool                                     IsDisarmed;
+	bool                                     IsHarpooned;
+	bool                                     IsUncapturable;
+};
+
+/** Target candidates of a company, built on first use in each tick */
+struct FFlareTargetCandidateList
+{
+	FFlareTargetCandidateList()
+		: Valid(false)
+	{}
+
+	TArray<FFlareTargetCandidate>            Candidates;
+	bool                                     Valid;
+};
+
 UCLASS()
 class HELIUMRAIN_API UFlareSector : public UObject
 {
@@ -73,6 +104,39 @@ public:
 
 	AActor* GetNearestBody(FVector Location, float* NearestDistance, bool IncludeSize = true, AActor* ActorToIgnore = NULL);
 
+	/** Spatial index of spacecrafts, asteroids, meteorites, bombs and colliders, built on first use in each tick */
+	const FFlareSectorBroadphase& GetBroadphase();
+
+	/** Bodies were added, removed or moved, build the broadphase again on next use */
+	void InvalidateBroadphase();
+
+	/** Living hostile spacecrafts inside the sector limits that a company can target, built on first use in each tick */
+	const TArray<FFlareTargetCandidate>& GetTargetCandidates(UFlareCompany* Company);
+
+	/** Hostility of a dangerous small ship towards a company with large ships, as computed before the parallel collision search */
+	bool IsPredictedHostile(AFlareSpacecraft* Spacecraft, UFlareCompany* Company) const
+	{
+		return PredictedHostilities.Contains(TPair<AFlareSpacecraft*, UFlareCompany*>(Spacecraft, Company));
+	}
+
+	/** Spacecrafts were added or removed, build the target candidates again on next use */
+	void InvalidateTargetCandidates();
+
+	/** Take a target search from this tick's budget, false if none are left */
+	bool ConsumeTargetSearch();
+
+	/** Some actors of the sector are still waiting to be spawned */
+	bool IsStreaming() const
+	{
+		return PendingSpacecrafts.Num() > 0 || PendingAsteroids.Num() > 0 || PendingBombs.Num() > 0;
+	}
+
+	/** Flight of the gun shells in this sector */
+	FFlareShellSimulation& GetShellSimulation()
+	{
+		return ShellSimulation;
+	}
+
 	void PlaceSpacecraft(AFlareSpacecraft* Spacecraft, FVector Location, FRotator Rotation, float RandomLocationRadiusIncrement = 100000, bool RandomLocRadiusBoost = true, float InitialLocationRadius = 100000, bool MultiplyLocationOrAdd = true, bool PositiveOrNegative = FMath::RandBool());
 	void PlaceSpacecraftDrone(AFlareSpacecraft* Spacecraft, FVector Location, FRotator Rotation, float RandomLocationRadiusIncrement = 100000, float InitialLocationRadius = 100000, bool PositiveOrNegative = FMath::RandBool());
 
@@ -119,6 +183,49 @@ protected:
 	TMap<UFlareCompany*, TArray<AFlareSpacecraft*>> CompanyShipsPerCompanyCache;
 	TMap<UFlareCompany*, TArray<AFlareSpacecraft*>> CompanySpacecraftsPerCompanyCache;
 	TMap<FName, AFlareSpacecraft*> SectorSpacecraftsCache;
+
+	UPROPERTY()
+	TArray<AActor*>                SectorColliders;
+
+	FFlareSectorBroadphase         Broadphase;
+	bool                           BroadphaseValid;
+	bool                           SectorCollidersValid;
+
+	/** Fill the broadphase */
+	void UpdateBroadphase();
+
+	FFlareShellSimulation          ShellSimulation;
+
+	TMap<UFlareCompany*, FFlareTargetCandidateList> TargetCandidates;
+	int32                          RemainingTargetSearches;
+
+	/** Fill the target candidates of a company */
+	void UpdateTargetCandidates(UFlareCompany* Company, TArray<FFlareTargetCandidate>& Candidates);
+
+	/** Pilots searching for collisions this tick */
+	TArray<UFlareShipPilot*>       PredictingPilots;
+
+	/** Hostile (small ship, company) pairs for the collision search, the quest manager is not read from workers */
+	TSet<TPair<AFlareSpacecraft*, UFlareCompany*>> PredictedHostilities;
+
+	/** Run the collision search of all pilots due this tick in parallel, before they tick */
+	void PredictPilotCollisions(float DeltaSeconds);
+
+	/** Spacecrafts still to spawn, highest priority last */
+	TArray<UFlareSimulatedSpacecraft*> PendingSpacecrafts;
+
+	/** Asteroids still to spawn, closest last */
+	TArray<FFlareAsteroidSave>     PendingAsteroids;
+
+	/** Bombs still to spawn, once their ship is there */
+	TArray<FFlareBombSave>         PendingBombs;
+
+	/** Spawn pending actors within the per-tick budget */
+	void StreamActors();
+
+	/** All actors were spawned */
+	void FinishStreaming();
+
 public:
 
 	/*----------------------------------------------------
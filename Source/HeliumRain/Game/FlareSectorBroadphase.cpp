@@ -0,0 +1,364 @@
+
+#include "FlareSectorBroadphase.h"
+#include "../Flare.h"
+
+DECLARE_CYCLE_STAT(TEXT("FlareSectorBroadphase Build"), STAT_FlareSectorBroadphase_Build, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareSectorBroadphase Query"), STAT_FlareSectorBroadphase_Query, STATGROUP_Flare);
+
+// 1km cells, in cm
+#define BROADPHASE_CELL_SIZE 100000.f
+
+// Bodies move a little between builds, queries are extended by this distance
+#define BROADPHASE_MARGIN 10000.f
+
+
+/*----------------------------------------------------
+	Constructor
+----------------------------------------------------*/
+
+FFlareSectorBroadphase::FFlareSectorBroadphase()
+	: CellSize(BROADPHASE_CELL_SIZE)
+	, MaxCellBodyRadius(0)
+{
+}
+
+
+/*----------------------------------------------------
+	Building
+----------------------------------------------------*/
+
+void FFlareSectorBroadphase::Reset()
+{
+	Bodies.Reset();
+	Cells.Reset();
+	LargeBodies.Reset();
+	MaxCellBodyRadius = 0;
+}
+
+void FFlareSectorBroadphase::AddBody(AActor* Actor, FVector Location, float Radius, EFlareBroadphaseBody::Type Type)
+{
+	FFlareBroadphaseBody Body;
+	Body.Actor = Actor;
+	Body.Location = Location;
+	Body.Radius = Radius;
+	Body.Type = Type;
+	Bodies.Add(Body);
+}
+
+void FFlareSectorBroadphase::Build()
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareSectorBroadphase_Build);
+
+	Cells.Reset();
+	LargeBodies.Reset();
+	MaxCellBodyRadius = 0;
+	MinCell = FIntVector(MAX_int32, MAX_int32, MAX_int32);
+	MaxCell = FIntVector(MIN_int32, MIN_int32, MIN_int32);
+
+	for (int32 BodyIndex = 0; BodyIndex < Bodies.Num(); BodyIndex++)
+	{
+		const FFlareBroadphaseBody& Body = Bodies[BodyIndex];
+
+		if (Body.Radius > CellSize)
+		{
+			LargeBodies.Add(BodyIndex);
+			continue;
+		}
+
+		FIntVector Cell = GetCell(Body.Location);
+		Cells.FindOrAdd(Cell).Add(BodyIndex);
+		MaxCellBodyRadius = FMath::Max(MaxCellBodyRadius, Body.Radius);
+
+		MinCell.X = FMath::Min(MinCell.X, Cell.X);
+		MinCell.Y = FMath::Min(MinCell.Y, Cell.Y);
+		MinCell.Z = FMath::Min(MinCell.Z, Cell.Z);
+		MaxCell.X = FMath::Max(MaxCell.X, Cell.X);
+		MaxCell.Y = FMath::Max(MaxCell.Y, Cell.Y);
+		MaxCell.Z = FMath::Max(MaxCell.Z, Cell.Z);
+	}
+}
+
+
+/*----------------------------------------------------
+	Queries
+----------------------------------------------------*/
+
+void FFlareSectorBroadphase::QueryRadius(FVector Location, float Radius, int32 TypeMask, TArray<FFlareBroadphaseBody>& Results, bool IncludeBodyRadius) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareSectorBroadphase_Query);
+	Results.Reset();
+
+	float SearchRadius = Radius + BROADPHASE_MARGIN;
+	float CellSearchRadius = SearchRadius + (IncludeBodyRadius ? MaxCellBodyRadius : 0);
+	FVector Extent(CellSearchRadius);
+
+	TArray<int32> Indices;
+	if (!GatherCells(Location - Extent, Location + Extent, TypeMask, Indices))
+	{
+		Indices.Reset();
+		for (int32 BodyIndex = 0; BodyIndex < Bodies.Num(); BodyIndex++)
+		{
+			Indices.Add(BodyIndex);
+		}
+	}
+	else
+	{
+		Indices.Append(LargeBodies);
+	}
+
+	// Exact test
+	for (int32 Index = Indices.Num() - 1; Index >= 0; Index--)
+	{
+		const FFlareBroadphaseBody& Body = Bodies[Indices[Index]];
+		float BodyRadius = SearchRadius + (IncludeBodyRadius ? Body.Radius : 0);
+
+		if (!(Body.Type & TypeMask) || FVector::DistSquared(Body.Location, Location) > FMath::Square(BodyRadius))
+		{
+			Indices.RemoveAtSwap(Index, 1, false);
+		}
+	}
+
+	OutputResults(Indices, Results);
+}
+
+void FFlareSectorBroadphase::QuerySegment(FVector Start, FVector End, float Radius, int32 TypeMask, TArray<FFlareBroadphaseBody>& Results) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareSectorBroadphase_Query);
+	Results.Reset();
+
+	float SearchRadius = Radius + BROADPHASE_MARGIN;
+	FVector Extent(SearchRadius);
+
+	TArray<int32> Indices;
+	if (!GatherCells(Start.ComponentMin(End) - Extent, Start.ComponentMax(End) + Extent, TypeMask, Indices))
+	{
+		Indices.Reset();
+		for (int32 BodyIndex = 0; BodyIndex < Bodies.Num(); BodyIndex++)
+		{
+			Indices.Add(BodyIndex);
+		}
+	}
+	else
+	{
+		Indices.Append(LargeBodies);
+	}
+
+	// Exact test
+	float SearchRadiusSquared = FMath::Square(SearchRadius);
+	for (int32 Index = Indices.Num() - 1; Index >= 0; Index--)
+	{
+		const FFlareBroadphaseBody& Body = Bodies[Indices[Index]];
+
+		if (!(Body.Type & TypeMask) || FMath::PointDistToSegmentSquared(Body.Location, Start, End) > SearchRadiusSquared)
+		{
+			Indices.RemoveAtSwap(Index, 1, false);
+		}
+	}
+
+	OutputResults(Indices, Results);
+}
+
+void FFlareSectorBroadphase::QueryNearest(FVector Location, int32 Count, int32 TypeMask, const AActor* ActorToIgnore, TArray<FFlareBroadphaseBody>& Results) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareSectorBroadphase_Query);
+	Results.Reset();
+
+	if (Count <= 0)
+	{
+		return;
+	}
+
+	// Best candidates so far, sorted by surface distance
+	TArray<TPair<float, int32>> Best;
+	auto Consider = [&](int32 BodyIndex)
+	{
+		const FFlareBroadphaseBody& Body = Bodies[BodyIndex];
+		if (!(Body.Type & TypeMask) || Body.Actor == ActorToIgnore)
+		{
+			return;
+		}
+
+		float Distance = FVector::Dist(Body.Location, Location) - Body.Radius;
+		if (Best.Num() == Count && Distance >= Best.Last().Key)
+		{
+			return;
+		}
+
+		int32 InsertIndex = 0;
+		while (InsertIndex < Best.Num() && Best[InsertIndex].Key <= Distance)
+		{
+			InsertIndex++;
+		}
+		Best.Insert(TPair<float, int32>(Distance, BodyIndex), InsertIndex);
+
+		if (Best.Num() > Count)
+		{
+			Best.Pop(false);
+		}
+	};
+
+	for (int32 BodyIndex : LargeBodies)
+	{
+		Consider(BodyIndex);
+	}
+
+	// Visit cells ring by ring around the location, until no closer body can be found
+	if (Cells.Num() > 0)
+	{
+		FIntVector Center = GetCell(Location);
+		int32 MaxRing = 0;
+		MaxRing = FMath::Max(MaxRing, FMath::Abs(MinCell.X - Center.X));
+		MaxRing = FMath::Max(MaxRing, FMath::Abs(MinCell.Y - Center.Y));
+		MaxRing = FMath::Max(MaxRing, FMath::Abs(MinCell.Z - Center.Z));
+		MaxRing = FMath::Max(MaxRing, FMath::Abs(MaxCell.X - Center.X));
+		MaxRing = FMath::Max(MaxRing, FMath::Abs(MaxCell.Y - Center.Y));
+		MaxRing = FMath::Max(MaxRing, FMath::Abs(MaxCell.Z - Center.Z));
+
+		int32 VisitedCells = 0;
+		bool ScanAll = false;
+
+		for (int32 Ring = 0; Ring <= MaxRing && !ScanAll; Ring++)
+		{
+			// Bodies in this ring are at least this far from the location
+			float RingDistance = (Ring - 1) * CellSize - MaxCellBodyRadius;
+			if (Best.Num() == Count && RingDistance > Best.Last().Key)
+			{
+				break;
+			}
+
+			FIntVector RingMin(FMath::Max(Center.X - Ring, MinCell.X), FMath::Max(Center.Y - Ring, MinCell.Y), FMath::Max(Center.Z - Ring, MinCell.Z));
+			FIntVector RingMax(FMath::Min(Center.X + Ring, MaxCell.X), FMath::Min(Center.Y + Ring, MaxCell.Y), FMath::Min(Center.Z + Ring, MaxCell.Z));
+
+			for (int32 X = RingMin.X; X <= RingMax.X && !ScanAll; X++)
+			{
+				for (int32 Y = RingMin.Y; Y <= RingMax.Y && !ScanAll; Y++)
+				{
+					for (int32 Z = RingMin.Z; Z <= RingMax.Z; Z++)
+					{
+						// Only the shell of the ring
+						if (FMath::Abs(X - Center.X) != Ring && FMath::Abs(Y - Center.Y) != Ring && FMath::Abs(Z - Center.Z) != Ring)
+						{
+							continue;
+						}
+
+						// Sparse grid, scanning all bodies is cheaper
+						if (++VisitedCells > Bodies.Num())
+						{
+							ScanAll = true;
+							break;
+						}
+
+						const TArray<int32>* Cell = Cells.Find(FIntVector(X, Y, Z));
+						if (Cell)
+						{
+							for (int32 BodyIndex : *Cell)
+							{
+								Consider(BodyIndex);
+							}
+						}
+					}
+				}
+			}
+		}
+
+		if (ScanAll)
+		{
+			Best.Reset();
+			for (int32 BodyIndex = 0; BodyIndex < Bodies.Num(); BodyIndex++)
+			{
+				Consider(BodyIndex);
+			}
+		}
+	}
+
+	for (const TPair<float, int32>& Candidate : Best)
+	{
+		Results.Add(Bodies[Candidate.Value]);
+	}
+}
+
+AActor* FFlareSectorBroadphase::FindNearest(FVector Location, int32 TypeMask, const AActor* ActorToIgnore, float& SurfaceDistance) const
+{
+	TArray<FFlareBroadphaseBody> Results;
+	QueryNearest(Location, 1, TypeMask, ActorToIgnore, Results);
+
+	if (Results.Num() == 0)
+	{
+		SurfaceDistance = 0;
+		return NULL;
+	}
+
+	SurfaceDistance = FVector::Dist(Results[0].Location, Location) - Results[0].Radius;
+	return Results[0].Actor;
+}
+
+
+/*----------------------------------------------------
+	Internals
+----------------------------------------------------*/
+
+FIntVector FFlareSectorBroadphase::GetCell(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt(Location.X / CellSize),
+		FMath::FloorToInt(Location.Y / CellSize),
+		FMath::FloorToInt(Location.Z / CellSize));
+}
+
+bool FFlareSectorBroadphase::GatherCells(const FVector& Min, const FVector& Max, int32 TypeMask, TArray<int32>& Indices) const
+{
+	if (Cells.Num() == 0)
+	{
+		return true;
+	}
+
+	FIntVector BoxMin = GetCell(Min);
+	FIntVector BoxMax = GetCell(Max);
+	BoxMin = FIntVector(FMath::Max(BoxMin.X, MinCell.X), FMath::Max(BoxMin.Y, MinCell.Y), FMath::Max(BoxMin.Z, MinCell.Z));
+	BoxMax = FIntVector(FMath::Min(BoxMax.X, MaxCell.X), FMath::Min(BoxMax.Y, MaxCell.Y), FMath::Min(BoxMax.Z, MaxCell.Z));
+
+	if (BoxMin.X > BoxMax.X || BoxMin.Y > BoxMax.Y || BoxMin.Z > BoxMax.Z)
+	{
+		return true;
+	}
+
+	int64 CellCount = (int64)(BoxMax.X - BoxMin.X + 1) * (BoxMax.Y - BoxMin.Y + 1) * (BoxMax.Z - BoxMin.Z + 1);
+	if (CellCount > Bodies.Num())
+	{
+		return false;
+	}
+
+	for (int32 X = BoxMin.X; X <= BoxMax.X; X++)
+	{
+		for (int32 Y = BoxMin.Y; Y <= BoxMax.Y; Y++)
+		{
+			for (int32 Z = BoxMin.Z; Z <= BoxMax.Z; Z++)
+			{
+				const TArray<int32>* Cell = Cells.Find(FIntVector(X, Y, Z));
+				if (Cell)
+				{
+					for (int32 BodyIndex : *Cell)
+					{
+						if (Bodies[BodyIndex].Type & TypeMask)
+						{
+							Indices.Add(BodyIndex);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+void FFlareSectorBroadphase::OutputResults(TArray<int32>& Indices, TArray<FFlareBroadphaseBody>& Results) const
+{
+	Indices.Sort();
+
+	Results.Reserve(Indices.Num());
+	for (int32 BodyIndex : Indices)
+	{
+		Results.Add(Bodies[BodyIndex]);
+	}
+}
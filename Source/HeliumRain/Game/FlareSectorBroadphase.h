@@ -0,0 +1,104 @@
+#pragma once
+
+#include "../Flare.h"
+
+
+/** Kinds of bodies in the sector broadphase, usable as a mask */
+namespace EFlareBroadphaseBody
+{
+	enum Type
+	{
+		Spacecraft = 1,
+		Asteroid = 2,
+		Meteorite = 4,
+		Bomb = 8,
+		Collider = 16,
+		All = Spacecraft | Asteroid | Meteorite | Bomb | Collider
+	};
+}
+
+/** One body in the broadphase, with its location when the broadphase was built */
+struct FFlareBroadphaseBody
+{
+	AActor* Actor;
+	FVector Location;
+	float Radius;
+	EFlareBroadphaseBody::Type Type;
+};
+
+/** Uniform hashed grid over the bodies of the active sector.
+ *  Bodies larger than a cell are kept apart and always tested.
+ *  Radius and segment queries return bodies in the order they were added.
+ *  Results are copies, so that they stay valid if the broadphase is built again while they are used. */
+class FFlareSectorBroadphase
+{
+public:
+
+	FFlareSectorBroadphase();
+
+	/*----------------------------------------------------
+		Building
+	----------------------------------------------------*/
+
+	/** Remove all bodies */
+	void Reset();
+
+	/** Add a body, Build must be called before queries */
+	void AddBody(AActor* Actor, FVector Location, float Radius, EFlareBroadphaseBody::Type Type);
+
+	/** Sort bodies in cells */
+	void Build();
+
+
+	/*----------------------------------------------------
+		Queries
+	----------------------------------------------------*/
+
+	/** Bodies with a center in a sphere, larger by the body radius if IncludeBodyRadius */
+	void QueryRadius(FVector Location, float Radius, int32 TypeMask, TArray<FFlareBroadphaseBody>& Results, bool IncludeBodyRadius = false) const;
+
+	/** Bodies with a center near a segment */
+	void QuerySegment(FVector Start, FVector End, float Radius, int32 TypeMask, TArray<FFlareBroadphaseBody>& Results) const;
+
+	/** Count nearest bodies, sorted by distance to their surface */
+	void QueryNearest(FVector Location, int32 Count, int32 TypeMask, const AActor* ActorToIgnore, TArray<FFlareBroadphaseBody>& Results) const;
+
+	/** Nearest body, with the distance to its surface, NULL if there is none */
+	AActor* FindNearest(FVector Location, int32 TypeMask, const AActor* ActorToIgnore, float& SurfaceDistance) const;
+
+
+	/*----------------------------------------------------
+		Getters
+	----------------------------------------------------*/
+
+	const TArray<FFlareBroadphaseBody>& GetBodies() const
+	{
+		return Bodies;
+	}
+
+
+protected:
+
+	FIntVector GetCell(const FVector& Location) const;
+
+	/** Add all bodies of the cells in a box, false if the box has too many cells and the caller should scan all bodies */
+	bool GatherCells(const FVector& Min, const FVector& Max, int32 TypeMask, TArray<int32>& Indices) const;
+
+	/** Turn body indices into sorted results */
+	void OutputResults(TArray<int32>& Indices, TArray<FFlareBroadphaseBody>& Results) const;
+
+	TArray<FFlareBroadphaseBody>         Bodies;
+
+	/** Body indices by cell */
+	TMap<FIntVector, TArray<int32>>      Cells;
+
+	/** Bodies larger than a cell */
+	TArray<int32>                        LargeBodies;
+
+	FIntVector                           MinCell;
+	FIntVector                           MaxCell;
+
+	float                                CellSize;
+	float                                MaxCellBodyRadius;
+
+};
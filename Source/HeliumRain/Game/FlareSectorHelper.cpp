@@ -32,7 +32,7 @@ UFlareSimulatedSpacecraft*  SectorHelper::FindTradeStation(FlareTradeRequest Req
 
 	UFlareCompany* ClientCompany = Request.AllowUseNoTradeForMe ? Request.Client->GetCompany() : nullptr;
 	UFlareSimulatedSector* Sector = Request.Client->GetCurrentSector();
-	TArray<UFlareSimulatedSpacecraft*>& SectorStations = Sector->GetSectorStations();
+	const TArray<UFlareSimulatedSpacecraft*>& TradeStations = Sector->GetTradeStations(Request.Resource);
 
 	float UnloadQuantityScoreMultiplier = 0;
 	float LoadQuantityScoreMultiplier = 0;
@@ -67,9 +67,9 @@ UFlareSimulatedSpacecraft*  SectorHelper::FindTradeStation(FlareTradeRequest Req
 	uint32 FreeSpace = Request.Client->GetActiveCargoBay()->GetFreeSpaceForResource(Request.Resource, ClientCompany);
 	FText Unused;
 
-	for (int32 StationIndex = 0; StationIndex < SectorStations.Num(); StationIndex++)
+	for (int32 StationIndex = 0; StationIndex < TradeStations.Num(); StationIndex++)
 	{
-		UFlareSimulatedSpacecraft* Station = SectorStations[StationIndex];
+		UFlareSimulatedSpacecraft* Station = TradeStations[StationIndex];
 		//FLOGV("   Check trade for %s", *Station->GetImmatriculation().ToString());
 		// 
 		if (NeedOutput)
@@ -1107,23 +1107,27 @@ int32 SectorHelper::GetCompanyArmyCombatPoints(UFlareSimulatedSector* Sector, UF
 
 TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::ComputeSectorResourceStats(UFlareSimulatedSector* Sector, bool IncludeStorage)
 {
-	TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> WorldStats;
-	WorldStats.Reserve(Sector->GetGame()->GetResourceCatalog()->Resources.Num());
+	TArray<UFlareResourceCatalogEntry*>& Resources = Sector->GetGame()->GetResourceCatalog()->Resources;
 
-// Init
-	for(int32 ResourceIndex = 0; ResourceIndex < Sector->GetGame()->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
+	TArray<WorldHelper::FlareResourceStats> Stats;
+	Stats.SetNumUninitialized(Resources.Num());
+	ComputeSectorResourceStats(Sector, IncludeStorage, Stats.GetData());
+
+	TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> WorldStats;
+	WorldStats.Reserve(Resources.Num());
+	for(int32 ResourceIndex = 0; ResourceIndex < Resources.Num(); ResourceIndex++)
 	{
-		FFlareResourceDescription* Resource = &Sector->GetGame()->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-		WorldHelper::FlareResourceStats ResourceStats;
-		ResourceStats.Production = 0;
-		ResourceStats.Consumption = 0;
-		ResourceStats.Balance = 0;
-		ResourceStats.Stock = 0;
-		ResourceStats.Capacity = 0;
-
-		WorldStats.Add(Resource, ResourceStats);
+		WorldStats.Add(&Resources[ResourceIndex]->Data, Stats[ResourceIndex]);
 	}
 
+	return WorldStats;
+}
+
+void SectorHelper::ComputeSectorResourceStats(UFlareSimulatedSector* Sector, bool IncludeStorage, WorldHelper::FlareResourceStats* OutStats)
+{
+	// Init
+	FMemory::Memzero(OutStats, Sector->GetGame()->GetResourceCatalog()->Resources.Num() * sizeof(WorldHelper::FlareResourceStats));
+
 	for (int SpacecraftIndex = 0; SpacecraftIndex < Sector->GetSectorSpacecrafts().Num(); SpacecraftIndex++)
 	{
 		UFlareSimulatedSpacecraft* Spacecraft = Sector->GetSectorSpacecrafts()[SpacecraftIndex];
@@ -1144,7 +1148,7 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 				continue;
 			}
 
-			WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Cargo.Resource];
+			WorldHelper::FlareResourceStats *ResourceStats = &OutStats[Cargo.Resource->CatalogIndex];
 
 			FFlareResourceUsage Usage = Spacecraft->GetResourceUseType(Cargo.Resource);
 
@@ -1176,7 +1180,7 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 					for(const FFlareFactoryResource& FactoryResource : ProductionData->InputResources)
 					{
 						const FFlareResourceDescription* Resource = &FactoryResource.Resource->Data;
-						WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource];
+						WorldHelper::FlareResourceStats *ResourceStats = &OutStats[Resource->CatalogIndex];
 
 						int64 ProductionDuration = ProductionData->ProductionTime;
 
@@ -1208,7 +1212,7 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 			for (int32 ResourceIndex = 0; ResourceIndex < Factory->GetInputResourcesCount(); ResourceIndex++)
 			{
 				FFlareResourceDescription* Resource = Factory->GetInputResource(ResourceIndex);
-				WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource];
+				WorldHelper::FlareResourceStats *ResourceStats = &OutStats[Resource->CatalogIndex];
 				int64 ProductionDuration = Factory->GetProductionDuration();
 				float Flow = 0;
 				if (ProductionDuration == 0)
@@ -1227,7 +1231,7 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 			for (int32 ResourceIndex = 0; ResourceIndex < Factory->GetOutputResourcesCount(); ResourceIndex++)
 			{
 				FFlareResourceDescription* Resource = Factory->GetOutputResource(ResourceIndex);
-				WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource];
+				WorldHelper::FlareResourceStats *ResourceStats = &OutStats[Resource->CatalogIndex];
 				int64 ProductionDuration = Factory->GetProductionDuration();
 				if (ProductionDuration == 0)
 				{
@@ -1242,7 +1246,7 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 
 	// FS
 	FFlareResourceDescription* FleetSupply = Sector->GetGame()->GetScenarioTools()->FleetSupply;
-	WorldHelper::FlareResourceStats *FSResourceStats = &WorldStats[FleetSupply];
+	WorldHelper::FlareResourceStats *FSResourceStats = &OutStats[FleetSupply->CatalogIndex];
 	FFlareFloatBuffer* Stats = &Sector->GetData()->FleetSupplyConsumptionStats;
 	float MeanConsumption = Stats->GetMean(0, Stats->MaxSize-1);
 	FSResourceStats->Consumption += MeanConsumption;
@@ -1253,7 +1257,7 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 	for (int32 ResourceIndex = 0; ResourceIndex < Sector->GetGame()->GetResourceCatalog()->ConsumerResources.Num(); ResourceIndex++)
 	{
 		FFlareResourceDescription* Resource = &Sector->GetGame()->GetResourceCatalog()->ConsumerResources[ResourceIndex]->Data;
-		WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource];
+		WorldHelper::FlareResourceStats *ResourceStats = &OutStats[Resource->CatalogIndex];
 
 		ResourceStats->Consumption += Sector->GetPeople()->GetRessourceConsumption(Resource, false);
 	}
@@ -1262,7 +1266,7 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 	for(int32 ResourceIndex = 0; ResourceIndex < Sector->GetGame()->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 	{
 		FFlareResourceDescription* Resource = &Sector->GetGame()->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-		WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource];
+		WorldHelper::FlareResourceStats *ResourceStats = &OutStats[Resource->CatalogIndex];
 
 		ResourceStats->Balance = ResourceStats->Production - ResourceStats->Consumption;
 
@@ -1273,7 +1277,4 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 			  ResourceStats->Balance,
 			  ResourceStats->Stock);*/
 	}
-
-	return WorldStats;
-
 }
@@ -61,6 +61,9 @@ struct SectorHelper
 
 	static TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> ComputeSectorResourceStats(UFlareSimulatedSector* Sector, bool IncludeStorage);
 
+	/** Fill the stats of all resources, by resource catalog index */
+	static void ComputeSectorResourceStats(UFlareSimulatedSector* Sector, bool IncludeStorage, WorldHelper::FlareResourceStats* OutStats);
+
 	static int64 GetSellResourcePrice(UFlareSimulatedSector* Sector, FFlareResourceDescription* Resource, FFlareResourceUsage Usage);
 
 	static int64 GetBuyResourcePrice(UFlareSimulatedSector* Sector, FFlareResourceDescription* Resource, FFlareResourceUsage Usage);
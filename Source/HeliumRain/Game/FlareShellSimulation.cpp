@@ -0,0 +1,257 @@
+
+#include "FlareShellSimulation.h"
+#include "../Flare.h"
+
+#include "FlareGameTools.h"
+#include "../Spacecrafts/FlareShell.h"
+
+#include "Async/ParallelFor.h"
+
+DECLARE_CYCLE_STAT(TEXT("FlareShellSimulation Step"), STAT_FlareShellSimulation_Step, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareShellSimulation Trace"), STAT_FlareShellSimulation_Trace, STATGROUP_Flare);
+
+// Shells are stepped at 40Hz, like actors with a tick interval
+#define SHELL_STEP_INTERVAL 0.025f
+
+// Shell actors further than 50km from the view are hidden
+#define SHELL_VISUAL_DISTANCE 5000000.f
+
+
+/*----------------------------------------------------
+	Constructor
+----------------------------------------------------*/
+
+FFlareShellSimulation::FFlareShellSimulation()
+	: TimeSinceStep(0)
+	, Stepping(false)
+	, HasRemovedShells(false)
+{
+}
+
+
+/*----------------------------------------------------
+	Shells
+----------------------------------------------------*/
+
+void FFlareShellSimulation::AddShell(AFlareShell* Shell, FVector Location, FVector Velocity, bool ProximityFuze)
+{
+	FCHECK(Shell);
+	FCHECK(Shell->GetSimulationIndex() == INDEX_NONE);
+
+	Shell->SetSimulationIndex(Shells.Num());
+	Shells.Add(Shell);
+	Locations.Add(Location);
+	Velocities.Add(Velocity);
+	SecureTimes.Add(0);
+	ActiveTimes.Add(0);
+	ProximityFuzes.Add(ProximityFuze);
+	Visibles.Add(true);
+}
+
+void FFlareShellSimulation::RemoveShell(AFlareShell* Shell)
+{
+	int32 Index = Shell->GetSimulationIndex();
+	if (!Shells.IsValidIndex(Index) || Shells[Index] != Shell)
+	{
+		return;
+	}
+
+	Shell->SetSimulationIndex(INDEX_NONE);
+
+	// Indices must stay stable during a step, the slot is freed at the end
+	if (Stepping)
+	{
+		Shells[Index] = NULL;
+		HasRemovedShells = true;
+	}
+	else
+	{
+		RemoveAt(Index);
+	}
+}
+
+void FFlareShellSimulation::Reset()
+{
+	for (AFlareShell* Shell : Shells)
+	{
+		if (Shell)
+		{
+			Shell->SetSimulationIndex(INDEX_NONE);
+		}
+	}
+
+	Shells.Empty();
+	Locations.Empty();
+	Velocities.Empty();
+	SecureTimes.Empty();
+	ActiveTimes.Empty();
+	ProximityFuzes.Empty();
+	Visibles.Empty();
+	NextLocations.Empty();
+	HitResults.Empty();
+	TimeSinceStep = 0;
+	HasRemovedShells = false;
+}
+
+void FFlareShellSimulation::SetMotion(AFlareShell* Shell, FVector Location, FVector Velocity)
+{
+	int32 Index = Shell->GetSimulationIndex();
+	if (Shells.IsValidIndex(Index))
+	{
+		Locations[Index] = Location;
+		Velocities[Index] = Velocity;
+	}
+}
+
+void FFlareShellSimulation::SetFuzeTimer(AFlareShell* Shell, float SecureTime, float ActiveTime)
+{
+	int32 Index = Shell->GetSimulationIndex();
+	if (Shells.IsValidIndex(Index))
+	{
+		SecureTimes[Index] = SecureTime;
+		ActiveTimes[Index] = ActiveTime;
+	}
+}
+
+void FFlareShellSimulation::ResetVisibility()
+{
+	for (bool& Visible : Visibles)
+	{
+		Visible = true;
+	}
+}
+
+
+/*----------------------------------------------------
+	Simulation
+----------------------------------------------------*/
+
+void FFlareShellSimulation::Tick(float DeltaSeconds, bool HasView, FVector ViewLocation)
+{
+	TimeSinceStep += DeltaSeconds;
+	if (TimeSinceStep < SHELL_STEP_INTERVAL)
+	{
+		return;
+	}
+
+	float StepDuration = TimeSinceStep;
+	TimeSinceStep = 0;
+
+	if (Shells.Num())
+	{
+		Step(StepDuration, HasView, ViewLocation);
+	}
+}
+
+void FFlareShellSimulation::Step(float DeltaSeconds, bool HasView, FVector ViewLocation)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareShellSimulation_Step);
+
+	int32 ShellCount = Shells.Num();
+	Stepping = true;
+
+	// Move all shells
+	NextLocations.SetNumUninitialized(ShellCount);
+	for (int32 Index = 0; Index < ShellCount; Index++)
+	{
+		NextLocations[Index] = Locations[Index] + Velocities[Index] * DeltaSeconds;
+	}
+
+	// Trace all shell paths, the physics scene is only read
+	{
+		SCOPE_CYCLE_COUNTER(STAT_FlareShellSimulation_Trace);
+
+		HitResults.SetNum(ShellCount);
+		auto TraceShell = [&](int32 Index)
+		{
+			Shells[Index]->Trace(Locations[Index], NextLocations[Index], HitResults[Index]);
+		};
+
+		if (UFlareGameTools::ParallelShells)
+		{
+			ParallelFor(ShellCount, TraceShell);
+		}
+		else
+		{
+			for (int32 Index = 0; Index < ShellCount; Index++)
+			{
+				TraceShell(Index);
+			}
+		}
+	}
+
+	// Process impacts and fuzes, which can remove shells or move them
+	float VisualDistanceSquared = FMath::Square(SHELL_VISUAL_DISTANCE);
+	for (int32 Index = 0; Index < ShellCount; Index++)
+	{
+		FVector Location = Locations[Index];
+		Locations[Index] = NextLocations[Index];
+
+		if (Shells[Index] && HitResults[Index].GetActor())
+		{
+			FVector Velocity = Velocities[Index];
+			Shells[Index]->OnImpact(HitResults[Index], Velocity);
+		}
+
+		if (Shells[Index] && ProximityFuzes[Index])
+		{
+			if (SecureTimes[Index] > 0)
+			{
+				SecureTimes[Index] -= DeltaSeconds;
+			}
+			else if (ActiveTimes[Index] > 0)
+			{
+				Shells[Index]->CheckFuze(Location, NextLocations[Index]);
+				ActiveTimes[Index] -= DeltaSeconds;
+			}
+		}
+
+		// Only move shell actors that can be seen
+		if (Shells[Index])
+		{
+			bool Visible = !HasView || FVector::DistSquared(Locations[Index], ViewLocation) < VisualDistanceSquared;
+			if (Visible)
+			{
+				Shells[Index]->UpdateFlightVisuals(Locations[Index], Velocities[Index]);
+			}
+
+			if (Visible != Visibles[Index])
+			{
+				Shells[Index]->SetActorHiddenInGame(!Visible);
+				Visibles[Index] = Visible;
+			}
+		}
+	}
+
+	Stepping = false;
+
+	// Free the slots of removed shells, from the end so that moved shells were already seen
+	if (HasRemovedShells)
+	{
+		for (int32 Index = Shells.Num() - 1; Index >= 0; Index--)
+		{
+			if (Shells[Index] == NULL)
+			{
+				RemoveAt(Index);
+			}
+		}
+		HasRemovedShells = false;
+	}
+}
+
+void FFlareShellSimulation::RemoveAt(int32 Index)
+{
+	Shells.RemoveAtSwap(Index, 1, false);
+	Locations.RemoveAtSwap(Index, 1, false);
+	Velocities.RemoveAtSwap(Index, 1, false);
+	SecureTimes.RemoveAtSwap(Index, 1, false);
+	ActiveTimes.RemoveAtSwap(Index, 1, false);
+	ProximityFuzes.RemoveAtSwap(Index, 1, false);
+	Visibles.RemoveAtSwap(Index, 1, false);
+
+	if (Shells.IsValidIndex(Index) && Shells[Index])
+	{
+		Shells[Index]->SetSimulationIndex(Index);
+	}
+}
+
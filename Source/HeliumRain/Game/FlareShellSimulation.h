@@ -0,0 +1,91 @@
+#pragma once
+
+#include "../Flare.h"
+
+class AFlareShell;
+
+
+/** Flight of all gun shells in the active sector.
+ *  Shell motion and fuze timers are kept in parallel arrays and stepped in one batch.
+ *  Shell paths are traced together, then impacts and fuzes run on the shell actors one by one.
+ *  Shell actors far from the view are hidden and not moved. */
+class FFlareShellSimulation
+{
+public:
+
+	FFlareShellSimulation();
+
+	/*----------------------------------------------------
+		Shells
+	----------------------------------------------------*/
+
+	/** Start simulating a shell */
+	void AddShell(AFlareShell* Shell, FVector Location, FVector Velocity, bool ProximityFuze);
+
+	/** Stop simulating a shell, safe to call while shells are stepped */
+	void RemoveShell(AFlareShell* Shell);
+
+	/** Stop simulating all shells */
+	void Reset();
+
+	/** Move a shell, after a ricochet */
+	void SetMotion(AFlareShell* Shell, FVector Location, FVector Velocity);
+
+	/** Set the proximity fuze timers of a shell */
+	void SetFuzeTimer(AFlareShell* Shell, float SecureTime, float ActiveTime);
+
+	/** Shell actors were all shown again, hide the far ones on next step */
+	void ResetVisibility();
+
+
+	/*----------------------------------------------------
+		Simulation
+	----------------------------------------------------*/
+
+	/** Step all shells, at the shell tick rate */
+	void Tick(float DeltaSeconds, bool HasView, FVector ViewLocation);
+
+
+protected:
+
+	/** Step all shells by DeltaSeconds */
+	void Step(float DeltaSeconds, bool HasView, FVector ViewLocation);
+
+	/** Remove the shell at an index, moving the last shell in its place */
+	void RemoveAt(int32 Index);
+
+
+	/*----------------------------------------------------
+		Data
+	----------------------------------------------------*/
+
+	// Shell state, by shell index
+	TArray<AFlareShell*>                     Shells;
+	TArray<FVector>                          Locations;
+	TArray<FVector>                          Velocities;
+	TArray<float>                            SecureTimes;
+	TArray<float>                            ActiveTimes;
+	TArray<bool>                             ProximityFuzes;
+	TArray<bool>                             Visibles;
+
+	// Step data, by shell index
+	TArray<FVector>                          NextLocations;
+	TArray<FHitResult>                       HitResults;
+
+	float                                    TimeSinceStep;
+	bool                                     Stepping;
+	bool                                     HasRemovedShells;
+
+
+public:
+
+	/*----------------------------------------------------
+		Getters
+	----------------------------------------------------*/
+
+	int32 GetShellCount() const
+	{
+		return Shells.Num();
+	}
+
+};
@@ -15,6 +15,7 @@
 #include "../Data/FlareMeteoriteCatalog.h"
 
 #include "../Economy/FlareCargoBay.h"
+#include "../Economy/FlareFactory.h"
 
 #include "../Player/FlarePlayerController.h"
 
@@ -29,6 +30,8 @@
 DECLARE_CYCLE_STAT(TEXT("FlareSector SimulatePriceVariation"), STAT_FlareSector_SimulatePriceVariation, STATGROUP_Flare);
 DECLARE_CYCLE_STAT(TEXT("FlareSector GetSectorFriendlyness"), STAT_FlareSector_GetSectorFriendlyness, STATGROUP_Flare);
 DECLARE_CYCLE_STAT(TEXT("FlareSector GetSectorBattleState"), STAT_FlareSector_GetSectorBattleState, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareSector UpdateSectorBattleStates"), STAT_FlareSector_UpdateSectorBattleStates, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareSector UpdateTradeStationIndex"), STAT_FlareSector_UpdateTradeStationIndex, STATGROUP_Flare);
 
 #define FLEET_SUPPLY_CONSUMPTION_STATS 50
 
@@ -43,6 +46,8 @@ UFlareSimulatedSector::UFlareSimulatedSector(const FObjectInitializer& ObjectIni
 	: Super(ObjectInitializer)
 {
 	PersistentStationIndex = 0;
+	WorldIndex = INDEX_NONE;
+	TradeStationIndexValid = false;
 }
 
 void UFlareSimulatedSector::Load(const FFlareSectorDescription* Description, const FFlareSectorSave& Data, const FFlareSectorOrbitParameters& OrbitParameters)
@@ -66,6 +71,7 @@ void UFlareSimulatedSector::Load(const FFlareSectorDescription* Description, con
 	SectorSpacecrafts.Empty();
 	SectorFleets.Empty();
 	LastSectorBattleStates.Empty();
+	InvalidateTradeStationIndex();
 
 	FFlareCelestialBody* Body = Game->GetGameWorld()->GetPlanerarium()->FindCelestialBody(SectorOrbitParameters.CelestialBodyIdentifier);
 	if (Body)
@@ -110,6 +116,7 @@ void UFlareSimulatedSector::Load(const FFlareSectorDescription* Description, con
 		if(!Spacecraft->IsComplexElement())
 		{
 			SectorSpacecrafts.Add(Spacecraft);
+			Game->GetGameWorld()->SetSpacecraftSector(Spacecraft, this);
 			if (Spacecraft->IsMilitaryArmed())
 			{
 				SectorCombatCapableShips.Add(Spacecraft);
@@ -511,12 +518,19 @@ UFlareSimulatedSpacecraft* UFlareSimulatedSector::CreateSpacecraft(FFlareSpacecr
 	if(!Spacecraft->IsComplexElement())
 	{
 		SectorSpacecrafts.Add(Spacecraft);
+		Game->GetGameWorld()->SetSpacecraftSector(Spacecraft, this);
 		if (Spacecraft->IsMilitaryArmed())
 		{
 			SectorCombatCapableShips.Add(Spacecraft);
 		}
 	}
 
+	InvalidateSectorBattleStates();
+	if (Spacecraft->IsStation())
+	{
+		InvalidateTradeStationIndex();
+	}
+	Game->GetGameWorld()->InvalidateEconomySnapshot();
 	Spacecraft->SetCurrentSector(this);
 	Company->CreatedSpaceCraft(Spacecraft);
 
@@ -591,6 +605,8 @@ void UFlareSimulatedSector::AddFleet(UFlareFleet* Fleet)
 	{
 		Fleet->GetShips()[ShipIndex]->SetCurrentSector(this);
 		SectorSpacecrafts.AddUnique(Fleet->GetShips()[ShipIndex]);
+		InvalidateSectorBattleStates();
+		Game->GetGameWorld()->SetSpacecraftSector(Fleet->GetShips()[ShipIndex], this);
 		SectorShips.AddUnique(Fleet->GetShips()[ShipIndex]);
 		if (Fleet->GetShips()[ShipIndex]->IsMilitaryArmed())
 		{
@@ -631,19 +647,36 @@ void UFlareSimulatedSector::RetireFleet(UFlareFleet* Fleet)
 
 int UFlareSimulatedSector::RemoveSpacecraft(UFlareSimulatedSpacecraft* Spacecraft)
 {
-	SectorStations.Remove(Spacecraft);
+	if (SectorStations.Remove(Spacecraft) > 0)
+	{
+		InvalidateTradeStationIndex();
+	}
+	Game->GetGameWorld()->InvalidateEconomySnapshot();
 	SectorChildStations.Remove(Spacecraft);
 	SectorShips.Remove(Spacecraft);
 	SectorCombatCapableShips.Remove(Spacecraft);
 	RemoveSectorReserves(Spacecraft);
 
-	return SectorSpacecrafts.Remove(Spacecraft);
+	int RemovedCount = SectorSpacecrafts.Remove(Spacecraft);
+	if (RemovedCount > 0)
+	{
+		Game->GetGameWorld()->ClearSpacecraftSector(Spacecraft, this);
+		InvalidateSectorBattleStates();
+	}
+	return RemovedCount;
 }
 
 
 void UFlareSimulatedSector::SetSectorOrbitParameters(const FFlareSectorOrbitParameters& OrbitParameters)
 {
 	SectorOrbitParameters = OrbitParameters;
+
+	// Travel sectors move every day, only world sectors are in the travel duration matrix
+	UFlareWorld* World = Cast<UFlareWorld>(GetOuter());
+	if (World)
+	{
+		World->InvalidateSectorTravelDurations();
+	}
 }
 
 /*----------------------------------------------------
@@ -1366,121 +1399,351 @@ FFlareSectorBattleState UFlareSimulatedSector::UpdateSectorBattleState(UFlareCom
 		return BattleState;
 	}
 
-	// Hostiles
-	int HostileSpacecraftCount = 0;
-	int DangerousHostileSpacecraftCount = 0;
-	int DangerousHostileActiveSpacecraftCount = 0;
-	int DangerousHostileActiveMissileCount = 0;
+	FFlareSectorBattleCounts Counts;
 
-	// Friendlies
-	int FriendlySpacecraftCount = 0;
-	int DangerousFriendlySpacecraftCount = 0;
-	int DangerousFriendlyActiveSpacecraftCount = 0;
-	int CrippledFriendlySpacecraftCount = 0;
-	int DangerousFriendlyActiveMissileCount = 0;
+	// Look at every spacecraft
+	for (int SpacecraftIndex = 0; SpacecraftIndex < GetSectorShips().Num(); SpacecraftIndex++)
+	{
+		CountShipBattleState(GetSectorShips()[SpacecraftIndex], Company, Counts);
+	}
 
-	// Neutrals ??
-	int FriendlyStationCount = 0;
-	int FriendlyStationInCaptureCount = 0;
-	int FriendlyControllableShipCount = 0;
+	// Look at every station
+	for (int SpacecraftIndex = 0; SpacecraftIndex < GetSectorStations().Num(); SpacecraftIndex++)
+	{
+		CountStationBattleState(GetSectorStations()[SpacecraftIndex], Company, Counts);
+	}
 
-	// Neutrals
-	int NeutralSpacecraftCount = 0;
-	int DangerousNeutralSpacecraftCount = 0;
-	int DangerousNeutralActiveSpacecraftCount = 0; 
+	return FinishSectorBattleState(Company, Counts);
+}
 
-	// Look at every spacecraft
-	for (int SpacecraftIndex = 0; SpacecraftIndex < GetSectorShips().Num(); SpacecraftIndex++)
+void UFlareSimulatedSector::UpdateSectorBattleStates()
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareSector_UpdateSectorBattleStates);
+
+	if (GetSectorShips().Num() == 0)
 	{
-		UFlareSimulatedSpacecraft* Spacecraft = GetSectorShips()[SpacecraftIndex];
-		UFlareCompany* OtherCompany = Spacecraft->GetCompany();
+		LastSectorBattleStates.Empty();
+		return;
+	}
 
+	// Player ships can be hostile on their own because of quests, keep them apart
+	TMap<UFlareCompany*, FFlareSectorBattleCompanyAggregate> Aggregates;
+	TArray<UFlareSimulatedSpacecraft*> PlayerShips;
+	TArray<UFlareSimulatedSpacecraft*> PlayerStations;
+
+	for (UFlareSimulatedSpacecraft* Spacecraft : GetSectorShips())
+	{
 		if (!Spacecraft->GetDamageSystem()->IsAlive() || Spacecraft->IsDestroyed())
 		{
 			continue;
 		}
 
-		if (OtherCompany == Company)
+		if (Spacecraft->GetCompany()->IsPlayerCompany())
 		{
-			FriendlySpacecraftCount++;
-			if (!Spacecraft->GetDamageSystem()->IsDisarmed())
+			PlayerShips.Add(Spacecraft);
+			continue;
+		}
+
+		FFlareSectorBattleCompanyAggregate& Aggregate = Aggregates.FindOrAdd(Spacecraft->GetCompany());
+		Aggregate.ShipCount++;
+
+		if (!Spacecraft->GetDamageSystem()->IsDisarmed())
+		{
+			Aggregate.ArmedShipCount++;
+			if (!Spacecraft->IsReserve())
 			{
-				DangerousFriendlySpacecraftCount++;
-				if (!Spacecraft->IsReserve())
-				{
-					DangerousFriendlyActiveSpacecraftCount++;
-				}
+				Aggregate.ArmedActiveShipCount++;
 			}
-			else
+		}
+
+		if (Spacecraft->GetDamageSystem()->IsStranded())
+		{
+			Aggregate.StrandedShipCount++;
+		}
+
+		if (!Spacecraft->GetDamageSystem()->IsUncontrollable() && !Spacecraft->IsReserve())
+		{
+			Aggregate.ControllableActiveShipCount++;
+		}
+	}
+
+	for (UFlareSimulatedSpacecraft* Spacecraft : GetSectorStations())
+	{
+		if (!Spacecraft->GetDamageSystem()->IsAlive())
+		{
+			continue;
+		}
+
+		if (Spacecraft->GetCompany()->IsPlayerCompany())
+		{
+			PlayerStations.Add(Spacecraft);
+			continue;
+		}
+
+		FFlareSectorBattleCompanyAggregate& Aggregate = Aggregates.FindOrAdd(Spacecraft->GetCompany());
+		Aggregate.StationCount++;
+		if (Spacecraft->IsBeingCaptured())
+		{
+			Aggregate.StationInCaptureCount++;
+		}
+	}
+
+	// Derive every company state from the aggregates, each company pair being resolved once
+	for (UFlareCompany* Company : Game->GetGameWorld()->GetCompanies())
+	{
+		if (Company->IsPlayerCompany())
+		{
+			UpdateSectorBattleState(Company);
+			continue;
+		}
+
+		FFlareSectorBattleCounts Counts;
+
+		for (auto& Entry : Aggregates)
+		{
+			UFlareCompany* OtherCompany = Entry.Key;
+			const FFlareSectorBattleCompanyAggregate& Aggregate = Entry.Value;
+			int32 DisarmedShipCount = Aggregate.ShipCount - Aggregate.ArmedShipCount;
+
+			if (OtherCompany == Company)
 			{
-				NeutralSpacecraftCount++;
+				Counts.FriendlySpacecraftCount += Aggregate.ShipCount + Aggregate.StationCount;
+				Counts.DangerousFriendlySpacecraftCount += Aggregate.ArmedShipCount;
+				Counts.DangerousFriendlyActiveSpacecraftCount += Aggregate.ArmedActiveShipCount;
+				Counts.NeutralSpacecraftCount += DisarmedShipCount;
+				Counts.CrippledFriendlySpacecraftCount += Aggregate.StrandedShipCount + Aggregate.StationCount;
+				Counts.FriendlyControllableShipCount += Aggregate.ControllableActiveShipCount;
+				Counts.FriendlyStationCount += Aggregate.StationCount;
+				Counts.FriendlyStationInCaptureCount += Aggregate.StationInCaptureCount;
 			}
-
-			if (Spacecraft->GetDamageSystem()->IsStranded())
+			else if (OtherCompany->GetWarState(Company) == EFlareHostility::Hostile)
+			{
+				Counts.HostileSpacecraftCount += Aggregate.ShipCount + Aggregate.StationCount;
+				Counts.DangerousHostileSpacecraftCount += Aggregate.ArmedShipCount;
+				Counts.DangerousHostileActiveSpacecraftCount += Aggregate.ArmedActiveShipCount;
+				Counts.NeutralSpacecraftCount += DisarmedShipCount;
+			}
+			else
 			{
-				CrippledFriendlySpacecraftCount++;
+				Counts.NeutralSpacecraftCount += Aggregate.ShipCount;
 			}
+		}
+
+		for (UFlareSimulatedSpacecraft* Spacecraft : PlayerShips)
+		{
+			CountShipBattleState(Spacecraft, Company, Counts);
+		}
+
+		for (UFlareSimulatedSpacecraft* Spacecraft : PlayerStations)
+		{
+			CountStationBattleState(Spacecraft, Company, Counts);
+		}
+
+		FinishSectorBattleState(Company, Counts);
+	}
+}
+
+void UFlareSimulatedSector::InvalidateSectorBattleStates()
+{
+	LastSectorBattleStates.Empty();
+}
+
+const TArray<UFlareSimulatedSpacecraft*>& UFlareSimulatedSector::GetTradeStations(FFlareResourceDescription* Resource)
+{
+	if (!TradeStationIndexValid)
+	{
+		UpdateTradeStationIndex();
+	}
+
+	if (!TradeStationsByResource.IsValidIndex(Resource->CatalogIndex))
+	{
+		return SectorStations;
+	}
+
+	return TradeStationsByResource[Resource->CatalogIndex];
+}
+
+void UFlareSimulatedSector::InvalidateTradeStationIndex()
+{
+	TradeStationIndexValid = false;
+}
+
+void UFlareSimulatedSector::UpdateTradeStationIndex()
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareSector_UpdateTradeStationIndex);
+
+	UFlareResourceCatalog* ResourceCatalog = Game->GetResourceCatalog();
+	int32 ResourceCount = ResourceCatalog->Resources.Num();
+
+	TradeStationsByResource.SetNum(ResourceCount);
+	for (TArray<UFlareSimulatedSpacecraft*>& Stations : TradeStationsByResource)
+	{
+		Stations.Reset();
+	}
+
+	TArray<bool> StationResources;
+	StationResources.SetNumUninitialized(ResourceCount);
 
-			if (!Spacecraft->GetDamageSystem()->IsUncontrollable())
+	for (UFlareSimulatedSpacecraft* Station : SectorStations)
+	{
+		// Shipyard inputs depend on the ship being built
+		bool AllResources = Station->IsShipyard();
+
+		// Hubs trade any resource once a slot is locked
+		if (!AllResources && Station->HasCapability(EFlareSpacecraftCapability::Storage))
+		{
+			for (FFlareCargo& Slot : Station->GetActiveCargoBay()->GetSlots())
 			{
-				if (!Spacecraft->IsReserve())
+				if (Slot.Lock == EFlareResourceLock::Input || Slot.Lock == EFlareResourceLock::Output || Slot.Lock == EFlareResourceLock::Trade)
 				{
-					FriendlyControllableShipCount++;
+					AllResources = true;
+					break;
 				}
 			}
+		}
 
+		if (AllResources)
+		{
+			for (TArray<UFlareSimulatedSpacecraft*>& Stations : TradeStationsByResource)
+			{
+				Stations.Add(Station);
+			}
+			continue;
 		}
-		else if (Spacecraft->IsHostile(Company))
+
+		FMemory::Memzero(StationResources.GetData(), ResourceCount * sizeof(bool));
+
+		// Factory resources, whatever the technologies of the owner
+		for (UFlareFactory* Factory : Station->GetFactories())
 		{
-			HostileSpacecraftCount++;
-			if (!Spacecraft->GetDamageSystem()->IsDisarmed())
+			const FFlareProductionData& CycleData = Factory->GetCycleData();
+			for (const FFlareFactoryResource& FactoryResource : CycleData.InputResources)
 			{
-				DangerousHostileSpacecraftCount++;
-				if (!Spacecraft->IsReserve())
+				FFlareResourceDescription* Resource = ResourceCatalog->Get(FactoryResource.Resource->Data.Identifier);
+				if (Resource && StationResources.IsValidIndex(Resource->CatalogIndex))
 				{
-					DangerousHostileActiveSpacecraftCount++;
+					StationResources[Resource->CatalogIndex] = true;
 				}
 			}
-			else
+			for (const FFlareFactoryResource& FactoryResource : CycleData.OutputResources)
 			{
-				NeutralSpacecraftCount++;
+				FFlareResourceDescription* Resource = ResourceCatalog->Get(FactoryResource.Resource->Data.Identifier);
+				if (Resource && StationResources.IsValidIndex(Resource->CatalogIndex))
+				{
+					StationResources[Resource->CatalogIndex] = true;
+				}
 			}
 		}
-		else
+
+		// Consumer and maintenance resources
+		bool Consumer = Station->HasCapability(EFlareSpacecraftCapability::Consumer);
+		bool Maintenance = Station->HasCapability(EFlareSpacecraftCapability::Maintenance);
+		for (int32 ResourceIndex = 0; ResourceIndex < ResourceCount; ResourceIndex++)
 		{
-			NeutralSpacecraftCount++;
+			const FFlareResourceDescription& Resource = ResourceCatalog->Resources[ResourceIndex]->Data;
+			if (StationResources[ResourceIndex]
+				|| (Consumer && Resource.IsConsumerResource)
+				|| (Maintenance && Resource.IsMaintenanceResource))
+			{
+				TradeStationsByResource[ResourceIndex].Add(Station);
+			}
 		}
-
 	}
 
-	// Look at every station
-	for (int SpacecraftIndex = 0; SpacecraftIndex < GetSectorStations().Num(); SpacecraftIndex++)
+	TradeStationIndexValid = true;
+}
+
+void UFlareSimulatedSector::CountShipBattleState(UFlareSimulatedSpacecraft* Spacecraft, UFlareCompany* Company, FFlareSectorBattleCounts& Counts)
+{
+	UFlareCompany* OtherCompany = Spacecraft->GetCompany();
+
+	if (!Spacecraft->GetDamageSystem()->IsAlive() || Spacecraft->IsDestroyed())
 	{
-		UFlareSimulatedSpacecraft* Spacecraft = GetSectorStations()[SpacecraftIndex];
-		UFlareCompany* OtherCompany = Spacecraft->GetCompany();
+		return;
+	}
 
-		if (!Spacecraft->GetDamageSystem()->IsAlive())
+	if (OtherCompany == Company)
+	{
+		Counts.FriendlySpacecraftCount++;
+		if (!Spacecraft->GetDamageSystem()->IsDisarmed())
 		{
-			continue;
+			Counts.DangerousFriendlySpacecraftCount++;
+			if (!Spacecraft->IsReserve())
+			{
+				Counts.DangerousFriendlyActiveSpacecraftCount++;
+			}
 		}
-
-		if (OtherCompany == Company)
+		else
 		{
-			FriendlySpacecraftCount++;
-			CrippledFriendlySpacecraftCount++;
+			Counts.NeutralSpacecraftCount++;
+		}
 
-			FriendlyStationCount++;
+		if (Spacecraft->GetDamageSystem()->IsStranded())
+		{
+			Counts.CrippledFriendlySpacecraftCount++;
+		}
 
-			if (Spacecraft->IsBeingCaptured())
+		if (!Spacecraft->GetDamageSystem()->IsUncontrollable())
+		{
+			if (!Spacecraft->IsReserve())
 			{
-				FriendlyStationInCaptureCount++;
+				Counts.FriendlyControllableShipCount++;
 			}
 		}
-		else if (Spacecraft->IsHostile(Company))
+	}
+	else if (Spacecraft->IsHostile(Company))
+	{
+		Counts.HostileSpacecraftCount++;
+		if (!Spacecraft->GetDamageSystem()->IsDisarmed())
 		{
-			HostileSpacecraftCount++;
+			Counts.DangerousHostileSpacecraftCount++;
+			if (!Spacecraft->IsReserve())
+			{
+				Counts.DangerousHostileActiveSpacecraftCount++;
+			}
 		}
+		else
+		{
+			Counts.NeutralSpacecraftCount++;
+		}
+	}
+	else
+	{
+		Counts.NeutralSpacecraftCount++;
 	}
+}
+
+void UFlareSimulatedSector::CountStationBattleState(UFlareSimulatedSpacecraft* Spacecraft, UFlareCompany* Company, FFlareSectorBattleCounts& Counts)
+{
+	UFlareCompany* OtherCompany = Spacecraft->GetCompany();
+
+	if (!Spacecraft->GetDamageSystem()->IsAlive())
+	{
+		return;
+	}
+
+	if (OtherCompany == Company)
+	{
+		Counts.FriendlySpacecraftCount++;
+		Counts.CrippledFriendlySpacecraftCount++;
+
+		Counts.FriendlyStationCount++;
+
+		if (Spacecraft->IsBeingCaptured())
+		{
+			Counts.FriendlyStationInCaptureCount++;
+		}
+	}
+	else if (Spacecraft->IsHostile(Company))
+	{
+		Counts.HostileSpacecraftCount++;
+	}
+}
+
+FFlareSectorBattleState UFlareSimulatedSector::FinishSectorBattleState(UFlareCompany* Company, FFlareSectorBattleCounts& Counts)
+{
+	FFlareSectorBattleState BattleState;
+	BattleState.Init();
 
 	// Look at bombs if this is an active sector
 	if (Game->GetActiveSector() && Game->GetActiveSector()->GetSimulatedSector() == this)
@@ -1498,11 +1761,11 @@ FFlareSectorBattleState UFlareSimulatedSector::UpdateSectorBattleState(UFlareCom
 
 				if (OtherCompany == Company)
 				{
-					DangerousFriendlyActiveMissileCount++;
+					Counts.DangerousFriendlyActiveMissileCount++;
 				}
 				else if (Bomb->IsHostile(Company))
 				{
-					DangerousHostileActiveMissileCount++;
+					Counts.DangerousHostileActiveMissileCount++;
 				}
 			}
 		}
@@ -1510,49 +1773,49 @@ FFlareSectorBattleState UFlareSimulatedSector::UpdateSectorBattleState(UFlareCom
 
 	// Setup
 	BattleState.InBattle = true;
-	BattleState.FriendlyStationCount = FriendlyStationCount;
-	BattleState.FriendlyStationInCaptureCount = FriendlyStationInCaptureCount;
-	BattleState.FriendlyControllableShipCount = FriendlyControllableShipCount;
+	BattleState.FriendlyStationCount = Counts.FriendlyStationCount;
+	BattleState.FriendlyStationInCaptureCount = Counts.FriendlyStationInCaptureCount;
+	BattleState.FriendlyControllableShipCount = Counts.FriendlyControllableShipCount;
 
-	BattleState.DangerousFriendlyActiveSpacecraftCount = DangerousFriendlyActiveSpacecraftCount;
-	BattleState.DangerousHostileActiveSpacecraftCount = DangerousHostileActiveSpacecraftCount;
+	BattleState.DangerousFriendlyActiveSpacecraftCount = Counts.DangerousFriendlyActiveSpacecraftCount;
+	BattleState.DangerousHostileActiveSpacecraftCount = Counts.DangerousHostileActiveSpacecraftCount;
 
-	BattleState.DangerousFriendlyActiveMissileCount = DangerousFriendlyActiveMissileCount;
-	BattleState.DangerousHostileActiveMissileCount = DangerousHostileActiveMissileCount;
+	BattleState.DangerousFriendlyActiveMissileCount = Counts.DangerousFriendlyActiveMissileCount;
+	BattleState.DangerousHostileActiveMissileCount = Counts.DangerousHostileActiveMissileCount;
 
-	BattleState.NeutralSpacecraftCount = NeutralSpacecraftCount;
+	BattleState.NeutralSpacecraftCount = Counts.NeutralSpacecraftCount;
 
 	// Danger
-	if (DangerousHostileSpacecraftCount > 0 || DangerousHostileActiveMissileCount > 0)
+	if (Counts.DangerousHostileSpacecraftCount > 0 || Counts.DangerousHostileActiveMissileCount > 0)
 	{
 		BattleState.HasDanger = true;
 	}
 
-	if (HostileSpacecraftCount > 0)
+	if (Counts.HostileSpacecraftCount > 0)
 	{
 		BattleState.HasEnemies = true;
 	}
 
 	// No friendly or no hostile ship
-	if (FriendlySpacecraftCount == 0 || HostileSpacecraftCount == 0)
+	if (Counts.FriendlySpacecraftCount == 0 || Counts.HostileSpacecraftCount == 0)
 	{
 		BattleState.InBattle = false;
 	}
 
 	// No friendly and hostile ship are not dangerous
-	if (DangerousFriendlySpacecraftCount == 0 && DangerousHostileSpacecraftCount == 0)
+	if (Counts.DangerousFriendlySpacecraftCount == 0 && Counts.DangerousHostileSpacecraftCount == 0)
 	{
 		BattleState.InBattle = false;
 	}
 
 	// Missiles are here, battle still in progress
-	if (DangerousFriendlyActiveMissileCount > 0 || DangerousHostileActiveMissileCount > 0)
+	if (Counts.DangerousFriendlyActiveMissileCount > 0 || Counts.DangerousHostileActiveMissileCount > 0)
 	{
 		BattleState.InBattle = true;
 	}
 
 	// Can retreat, not all player ships are crippled
-	if (CrippledFriendlySpacecraftCount != FriendlySpacecraftCount)
+	if (Counts.CrippledFriendlySpacecraftCount != Counts.FriendlySpacecraftCount)
 	{
 		BattleState.RetreatPossible = false;
 	}
@@ -1560,11 +1823,11 @@ FFlareSectorBattleState UFlareSimulatedSector::UpdateSectorBattleState(UFlareCom
 	if (BattleState.InBattle)
 	{
 		// No friendly dangerous ship so the enemy have one. Battle is lost
-		if (DangerousFriendlySpacecraftCount == 0 && DangerousFriendlyActiveMissileCount == 0)
+		if (Counts.DangerousFriendlySpacecraftCount == 0 && Counts.DangerousFriendlyActiveMissileCount == 0)
 		{
 			BattleState.BattleWon = false;
 		}
-		else if (DangerousHostileSpacecraftCount == 0 && DangerousHostileActiveMissileCount == 0)
+		else if (Counts.DangerousHostileSpacecraftCount == 0 && Counts.DangerousHostileActiveMissileCount == 0)
 		{
 			BattleState.BattleWon = true;
 		}
@@ -1572,11 +1835,11 @@ FFlareSectorBattleState UFlareSimulatedSector::UpdateSectorBattleState(UFlareCom
 		{
 			BattleState.InFight = true;
 
-			if (DangerousFriendlyActiveSpacecraftCount == 0 && DangerousFriendlyActiveMissileCount == 0)
+			if (Counts.DangerousFriendlyActiveSpacecraftCount == 0 && Counts.DangerousFriendlyActiveMissileCount == 0)
 			{
 				BattleState.ActiveFightWon = false;
 			}
-			else if (DangerousHostileActiveSpacecraftCount == 0 && DangerousHostileActiveMissileCount == 0)
+			else if (Counts.DangerousHostileActiveSpacecraftCount == 0 && Counts.DangerousHostileActiveMissileCount == 0)
 			{
 				BattleState.ActiveFightWon = true;
 			}
@@ -397,6 +397,40 @@ struct FFlareStationSpawnParameters
 };
 
 
+/** Spacecraft counts used to compute a battle state */
+struct FFlareSectorBattleCounts
+{
+	int32 HostileSpacecraftCount = 0;
+	int32 DangerousHostileSpacecraftCount = 0;
+	int32 DangerousHostileActiveSpacecraftCount = 0;
+	int32 DangerousHostileActiveMissileCount = 0;
+
+	int32 FriendlySpacecraftCount = 0;
+	int32 DangerousFriendlySpacecraftCount = 0;
+	int32 DangerousFriendlyActiveSpacecraftCount = 0;
+	int32 CrippledFriendlySpacecraftCount = 0;
+	int32 DangerousFriendlyActiveMissileCount = 0;
+
+	int32 FriendlyStationCount = 0;
+	int32 FriendlyStationInCaptureCount = 0;
+	int32 FriendlyControllableShipCount = 0;
+
+	int32 NeutralSpacecraftCount = 0;
+};
+
+/** Alive spacecraft of one company in a sector, as seen by the battle state */
+struct FFlareSectorBattleCompanyAggregate
+{
+	int32 ShipCount = 0;
+	int32 ArmedShipCount = 0;
+	int32 ArmedActiveShipCount = 0;
+	int32 StrandedShipCount = 0;
+	int32 ControllableActiveShipCount = 0;
+	int32 StationCount = 0;
+	int32 StationInCaptureCount = 0;
+};
+
+
 UCLASS()
 class HELIUMRAIN_API UFlareSimulatedSector : public UObject
 {
@@ -413,6 +447,12 @@ public:
 	/** Load sector people */
 	virtual UFlarePeople* LoadPeople(const FFlarePeopleSave& PeopleData);
 
+	/** Set the index of this sector in UFlareWorld::GetSectors() */
+	void SetWorldIndex(int32 Index)
+	{
+		WorldIndex = Index;
+	}
+
 	/** Save the sector to a save file */
     virtual FFlareSectorSave* Save();
 
@@ -521,6 +561,7 @@ protected:
 	UFlarePeople*							People;
 
 	int32                                   PersistentStationIndex;
+	int32                                   WorldIndex;
 	float									LightRatio;
 
 	AFlareGame*                             Game;
@@ -535,6 +576,20 @@ protected:
 	TMap<UFlareCompany*, FFlareSectorBattleState>				LastSectorBattleStates;
 	TMap<UFlareCompany*, int32>									LastCompanySectorCapturePoints;
 
+	/** Stations that may trade each resource, by resource catalog index, in SectorStations order */
+	TArray<TArray<UFlareSimulatedSpacecraft*>>					TradeStationsByResource;
+	bool														TradeStationIndexValid;
+
+	/** Add a ship or a station to the battle counts of a company */
+	void CountShipBattleState(UFlareSimulatedSpacecraft* Spacecraft, UFlareCompany* Company, FFlareSectorBattleCounts& Counts);
+	void CountStationBattleState(UFlareSimulatedSpacecraft* Spacecraft, UFlareCompany* Company, FFlareSectorBattleCounts& Counts);
+
+	/** Compute and store the battle state of a company from its counts */
+	FFlareSectorBattleState FinishSectorBattleState(UFlareCompany* Company, FFlareSectorBattleCounts& Counts);
+
+	/** Sort the sector stations by the resources they may buy or sell */
+	void UpdateTradeStationIndex();
+
 public:
 
     /*----------------------------------------------------
@@ -566,6 +621,12 @@ public:
         return SectorData.Identifier;
     }
 
+	/** Dense index of this sector, for per-sector tables */
+	inline int32 GetWorldIndex() const
+	{
+		return WorldIndex;
+	}
+
 	/** Get the description of this sector */
 	FText GetSectorDescription() const;
 
@@ -680,6 +741,18 @@ public:
 	/** Update the current battle status of a company */
 	FFlareSectorBattleState UpdateSectorBattleState(UFlareCompany* Company);
 
+	/** Update the battle status of every company with a single pass on the sector spacecrafts */
+	void UpdateSectorBattleStates();
+
+	/** Drop the cached battle states, they will be computed again when needed */
+	void InvalidateSectorBattleStates();
+
+	/** Stations that may buy or sell a resource, to be checked with GetResourceUseType */
+	const TArray<UFlareSimulatedSpacecraft*>& GetTradeStations(FFlareResourceDescription* Resource);
+
+	/** Stations, factories or cargo locks changed, the trade station index will be built again when needed */
+	void InvalidateTradeStationIndex();
+
 	/** Get the current battle status text */
 	FText GetSectorBattleStateText(UFlareCompany* Company);
 
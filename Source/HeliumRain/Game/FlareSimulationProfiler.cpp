@@ -0,0 +1,292 @@
+#include "FlareSimulationProfiler.h"
+#include "../Flare.h"
+
+#include "FlareWorld.h"
+
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+
+#define SIMULATION_PROFILER_DEFAULT_HISTORY 60
+
+
+/*----------------------------------------------------
+	Day profile
+----------------------------------------------------*/
+
+const FFlareSimulationPhaseStats* FFlareSimulationDayProfile::FindPhase(FName Name) const
+{
+	for (const FFlareSimulationPhaseStats& Phase : Phases)
+	{
+		if (Phase.Name == Name)
+		{
+			return &Phase;
+		}
+	}
+	return NULL;
+}
+
+
+/*----------------------------------------------------
+	Constructor
+----------------------------------------------------*/
+
+FFlareSimulationProfiler::FFlareSimulationProfiler()
+	: CurrentPhase(NULL)
+	, HistorySize(SIMULATION_PROFILER_DEFAULT_HISTORY)
+	, RecordingDay(false)
+	, DayStartTime(0)
+	, DayStartMemory(0)
+	, PhaseStartTime(0)
+	, PhaseStartMemory(0)
+{
+}
+
+
+/*----------------------------------------------------
+	Recording
+----------------------------------------------------*/
+
+void FFlareSimulationProfiler::BeginDay(int64 Date)
+{
+	CurrentDay = FFlareSimulationDayProfile();
+	CurrentDay.Date = Date;
+	CurrentDay.Time = 0;
+	CurrentDay.UsedPhysicalDelta = 0;
+	CurrentPhase = NULL;
+
+	RecordingDay = true;
+	DayStartTime = FPlatformTime::Seconds();
+	DayStartMemory = GetUsedMemory();
+}
+
+void FFlareSimulationProfiler::EndDay()
+{
+	if (!RecordingDay)
+	{
+		return;
+	}
+
+	if (CurrentPhase)
+	{
+		EndPhase();
+	}
+
+	CurrentDay.Time = FPlatformTime::Seconds() - DayStartTime;
+	CurrentDay.UsedPhysicalDelta = GetUsedMemory() - DayStartMemory;
+	RecordingDay = false;
+
+	History.Add(CurrentDay);
+	while (History.Num() > HistorySize)
+	{
+		History.RemoveAt(0);
+	}
+}
+
+void FFlareSimulationProfiler::BeginPhase(FName Name)
+{
+	if (!RecordingDay)
+	{
+		return;
+	}
+
+	if (CurrentPhase)
+	{
+		EndPhase();
+	}
+
+	// Phases called several times in a day are merged
+	for (FFlareSimulationPhaseStats& Phase : CurrentDay.Phases)
+	{
+		if (Phase.Name == Name)
+		{
+			CurrentPhase = &Phase;
+			break;
+		}
+	}
+
+	if (!CurrentPhase)
+	{
+		FFlareSimulationPhaseStats NewPhase;
+		NewPhase.Name = Name;
+		NewPhase.Time = 0;
+		NewPhase.Items = 0;
+		NewPhase.UsedPhysicalDelta = 0;
+		NewPhase.Calls = 0;
+		CurrentPhase = &CurrentDay.Phases[CurrentDay.Phases.Add(NewPhase)];
+	}
+
+	CurrentPhase->Calls++;
+	PhaseStartTime = FPlatformTime::Seconds();
+	PhaseStartMemory = GetUsedMemory();
+}
+
+void FFlareSimulationProfiler::EndPhase(int32 Items)
+{
+	if (!CurrentPhase)
+	{
+		return;
+	}
+
+	CurrentPhase->Time += FPlatformTime::Seconds() - PhaseStartTime;
+	CurrentPhase->UsedPhysicalDelta += GetUsedMemory() - PhaseStartMemory;
+	CurrentPhase->Items += Items;
+	CurrentPhase = NULL;
+}
+
+void FFlareSimulationProfiler::SetHistorySize(int32 NewSize)
+{
+	HistorySize = FMath::Max(1, NewSize);
+	while (History.Num() > HistorySize)
+	{
+		History.RemoveAt(0);
+	}
+}
+
+void FFlareSimulationProfiler::Reset()
+{
+	History.Empty();
+	CurrentPhase = NULL;
+	RecordingDay = false;
+}
+
+
+/*----------------------------------------------------
+	Reports
+----------------------------------------------------*/
+
+void FFlareSimulationProfiler::PrintSummary() const
+{
+	if (History.Num() == 0)
+	{
+		FLOG("FFlareSimulationProfiler::PrintSummary : no day recorded");
+		return;
+	}
+
+	double TotalTime = 0;
+	for (const FFlareSimulationDayProfile& Day : History)
+	{
+		TotalTime += Day.Time;
+	}
+
+	FLOGV("Simulation profile over %d days, average day %.6fs", History.Num(), TotalTime / History.Num());
+
+	for (const FFlareSimulationPhaseStats& Phase : History.Last().Phases)
+	{
+		FLOGV("- %-24s avg %.6fs, last %.6fs, %d items", *Phase.Name.ToString(), GetAveragePhaseTime(Phase.Name), Phase.Time, Phase.Items);
+	}
+}
+
+bool FFlareSimulationProfiler::WriteReport(const FString& FileName, const FString& Label) const
+{
+	TSharedRef<FJsonObject> ReportObject = MakeShareable(new FJsonObject());
+	ReportObject->SetStringField("Label", Label);
+	ReportObject->SetStringField("Timestamp", FDateTime::UtcNow().ToIso8601());
+	ReportObject->SetNumberField("Days", History.Num());
+
+	double TotalTime = 0;
+	TArray< TSharedPtr<FJsonValue> > DaysArray;
+	for (const FFlareSimulationDayProfile& Day : History)
+	{
+		TSharedRef<FJsonObject> DayObject = MakeShareable(new FJsonObject());
+		DayObject->SetNumberField("Date", Day.Date);
+		DayObject->SetNumberField("Time", Day.Time);
+		DayObject->SetNumberField("UsedPhysicalDelta", Day.UsedPhysicalDelta);
+
+		TArray< TSharedPtr<FJsonValue> > PhasesArray;
+		for (const FFlareSimulationPhaseStats& Phase : Day.Phases)
+		{
+			TSharedRef<FJsonObject> PhaseObject = MakeShareable(new FJsonObject());
+			PhaseObject->SetStringField("Name", Phase.Name.ToString());
+			PhaseObject->SetNumberField("Time", Phase.Time);
+			PhaseObject->SetNumberField("Items", Phase.Items);
+			PhaseObject->SetNumberField("Calls", Phase.Calls);
+			PhaseObject->SetNumberField("UsedPhysicalDelta", Phase.UsedPhysicalDelta);
+			PhasesArray.Add(MakeShareable(new FJsonValueObject(PhaseObject)));
+		}
+		DayObject->SetArrayField("Phases", PhasesArray);
+
+		DaysArray.Add(MakeShareable(new FJsonValueObject(DayObject)));
+		TotalTime += Day.Time;
+	}
+
+	ReportObject->SetNumberField("TotalTime", TotalTime);
+	ReportObject->SetArrayField("History", DaysArray);
+
+	FString FileContents;
+	TSharedRef< TJsonWriter<> > JsonWriter = TJsonWriterFactory<>::Create(&FileContents);
+	if (!FJsonSerializer::Serialize(ReportObject, JsonWriter))
+	{
+		FLOGV("FFlareSimulationProfiler::WriteReport : fail to serialize report '%s'", *FileName);
+		return false;
+	}
+	JsonWriter->Close();
+
+	if (!FFileHelper::SaveStringToFile(FileContents, *FileName))
+	{
+		FLOGV("FFlareSimulationProfiler::WriteReport : fail to write report '%s'", *FileName);
+		return false;
+	}
+
+	FLOGV("FFlareSimulationProfiler::WriteReport : report written to '%s'", *FileName);
+	return true;
+}
+
+bool FFlareSimulationProfiler::RunBenchmark(UFlareWorld* World, int32 Days, const FString& FileName)
+{
+	if (!World || Days <= 0)
+	{
+		FLOG("FFlareSimulationProfiler::RunBenchmark : nothing to simulate");
+		return false;
+	}
+
+	FFlareSimulationProfiler& Profiler = World->GetProfiler();
+	int32 PreviousHistorySize = Profiler.HistorySize;
+	Profiler.Reset();
+	Profiler.SetHistorySize(Days);
+
+	FLOGV("FFlareSimulationProfiler::RunBenchmark : simulating %d days from day %lld", Days, World->GetDate());
+	double StartTs = FPlatformTime::Seconds();
+
+	for (int32 DayIndex = 0; DayIndex < Days; DayIndex++)
+	{
+		World->FastForward();
+	}
+
+	double EndTs = FPlatformTime::Seconds();
+	FLOGV("FFlareSimulationProfiler::RunBenchmark : %d days done in %.6fs", Days, EndTs - StartTs);
+
+	Profiler.PrintSummary();
+	bool Result = Profiler.WriteReport(FileName, FString::Printf(TEXT("Benchmark %d days"), Days));
+	Profiler.SetHistorySize(PreviousHistorySize);
+
+	return Result;
+}
+
+FString FFlareSimulationProfiler::GetDefaultReportFileName()
+{
+	return FString::Printf(TEXT("%s/Benchmarks/Simulate-%s.json"), *FPaths::ProjectSavedDir(), *FDateTime::Now().ToString());
+}
+
+double FFlareSimulationProfiler::GetAveragePhaseTime(FName Name) const
+{
+	double TotalTime = 0;
+	int32 DayCount = 0;
+
+	for (const FFlareSimulationDayProfile& Day : History)
+	{
+		const FFlareSimulationPhaseStats* Phase = Day.FindPhase(Name);
+		if (Phase)
+		{
+			TotalTime += Phase->Time;
+			DayCount++;
+		}
+	}
+
+	return DayCount > 0 ? TotalTime / DayCount : 0;
+}
+
+int64 FFlareSimulationProfiler::GetUsedMemory()
+{
+	return FPlatformMemory::GetStats().UsedPhysical;
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "../Flare.h"
+
+class UFlareWorld;
+
+
+/** Timing and counters for one phase of a simulated day */
+struct FFlareSimulationPhaseStats
+{
+	FName Name;
+	double Time;
+	int32 Items;
+
+	/** Change of the process used physical memory, not an allocation count */
+	int64 UsedPhysicalDelta;
+
+	int32 Calls;
+};
+
+/** All phases for one simulated day */
+struct FFlareSimulationDayProfile
+{
+	int64 Date;
+	double Time;
+
+	/** Change of the process used physical memory over the day */
+	int64 UsedPhysicalDelta;
+
+	TArray<FFlareSimulationPhaseStats> Phases;
+
+	const FFlareSimulationPhaseStats* FindPhase(FName Name) const;
+};
+
+/** Per-phase profiler for UFlareWorld::Simulate, keeps a rolling history of days */
+class FFlareSimulationProfiler
+{
+public:
+
+	FFlareSimulationProfiler();
+
+	/*----------------------------------------------------
+		Recording
+	----------------------------------------------------*/
+
+	/** Start recording a new day */
+	void BeginDay(int64 Date);
+
+	/** Finish the current day and push it in the history */
+	void EndDay();
+
+	/** Start recording a phase. Phases can't be nested */
+	void BeginPhase(FName Name);
+
+	/** Finish the current phase, with the number of items processed */
+	void EndPhase(int32 Items = 0);
+
+	/** Set the number of days kept */
+	void SetHistorySize(int32 NewSize);
+
+	/** Clear all recorded days */
+	void Reset();
+
+
+	/*----------------------------------------------------
+		Reports
+	----------------------------------------------------*/
+
+	/** Log the average of each phase over the history */
+	void PrintSummary() const;
+
+	/** Write the history as a JSON report */
+	bool WriteReport(const FString& FileName, const FString& Label) const;
+
+	/** Fast-forward the world and write a report, returns false on failure */
+	static bool RunBenchmark(UFlareWorld* World, int32 Days, const FString& FileName);
+
+	/** Get a default report file name */
+	static FString GetDefaultReportFileName();
+
+
+	/*----------------------------------------------------
+		Getters
+	----------------------------------------------------*/
+
+	const TArray<FFlareSimulationDayProfile>& GetHistory() const
+	{
+		return History;
+	}
+
+	const FFlareSimulationDayProfile* GetLastDay() const
+	{
+		return History.Num() ? &History.Last() : NULL;
+	}
+
+	/** Average time of a phase over the history */
+	double GetAveragePhaseTime(FName Name) const;
+
+
+protected:
+
+	static int64 GetUsedMemory();
+
+	TArray<FFlareSimulationDayProfile> History;
+	FFlareSimulationDayProfile         CurrentDay;
+	FFlareSimulationPhaseStats*        CurrentPhase;
+
+	int32                              HistorySize;
+	bool                               RecordingDay;
+	double                             DayStartTime;
+	int64                              DayStartMemory;
+	double                             PhaseStartTime;
+	int64                              PhaseStartMemory;
+
+};
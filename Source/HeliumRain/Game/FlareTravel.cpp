@@ -16,8 +16,6 @@
 
 #include "../UI/Components/FlareNotification.h"
 
-static const double TRAVEL_DURATION_PER_PHASE_KM = 0.52;
-static const double TRAVEL_DURATION_PER_ALTITUDE_KM = 2;
 
 #define LOCTEXT_NAMESPACE "FlareTravelInfos"
 
@@ -461,13 +459,35 @@ void UFlareTravel::GenerateTravelDuration()
 
 int64 UFlareTravel::ComputeTravelDuration(UFlareWorld* World, UFlareSimulatedSector* OriginSector, UFlareSimulatedSector* DestinationSector, UFlareCompany* Company, UFlareFleet* TravelFleet)
 {
-	int64 TravelDuration = 0;
-
 	if (OriginSector == DestinationSector)
 	{
 		return 0;
 	}
 
+	// World sectors use the precomputed paths, travel sectors move every day
+	const FFlareTravelLeg* Leg = World->GetTravelDurations().FindLeg(World, OriginSector, DestinationSector);
+	FFlareTravelLeg TravelSectorLeg;
+	if (!Leg)
+	{
+		TravelSectorLeg = ComputeTravelLeg(World, OriginSector, DestinationSector);
+		Leg = &TravelSectorLeg;
+	}
+
+	int64 TravelDuration = FFlareTravelDurations::GetLegDuration(*Leg, FFlareTravelFleetSpeed(TravelFleet));
+	return ApplyCompanyTravelBonus(World, Company, TravelDuration);
+}
+
+FFlareTravelLeg UFlareTravel::ComputeTravelLeg(UFlareWorld* World, UFlareSimulatedSector* OriginSector, UFlareSimulatedSector* DestinationSector)
+{
+	FFlareTravelLeg Leg;
+	Leg.Distance = 0;
+	Leg.PhaseChange = true;
+
+	if (OriginSector == DestinationSector)
+	{
+		return Leg;
+	}
+
 	double OriginAltitude;
 	double DestinationAltitude;
 	double OriginPhase;
@@ -487,16 +507,22 @@ int64 UFlareTravel::ComputeTravelDuration(UFlareWorld* World, UFlareSimulatedSec
 	{
 		// Phase change travel
 		FFlareCelestialBody* CelestialBody = World->GetPlanerarium()->FindCelestialBody(OriginCelestialBodyIdentifier);
-		TravelDuration = ComputePhaseTravelDuration(World, CelestialBody, OriginAltitude, OriginPhase, DestinationPhase, TravelFleet);
+		Leg.Distance = ComputePhaseTravelDistance(World, CelestialBody, OriginAltitude, OriginPhase, DestinationPhase);
 	}
 	else
 	{
 		// Altitude change travel
 		FFlareCelestialBody* OriginCelestialBody = World->GetPlanerarium()->FindCelestialBody(OriginCelestialBodyIdentifier);
 		FFlareCelestialBody* DestinationCelestialBody = World->GetPlanerarium()->FindCelestialBody(DestinationCelestialBodyIdentifier);
-		TravelDuration = ComputeAltitudeTravelDuration(World, OriginCelestialBody, OriginAltitude, DestinationCelestialBody, DestinationAltitude, TravelFleet);
+		Leg.Distance = ComputeAltitudeTravelPathDistance(World, OriginCelestialBody, OriginAltitude, DestinationCelestialBody, DestinationAltitude);
+		Leg.PhaseChange = false;
 	}
 
+	return Leg;
+}
+
+int64 UFlareTravel::ApplyCompanyTravelBonus(UFlareWorld* World, UFlareCompany* Company, int64 TravelDuration)
+{
 	bool AICheats = World->GetGame()->GetPC()->GetPlayerData()->AICheats;
 	if (AICheats)
 	{
@@ -567,57 +593,39 @@ double UFlareTravel::ComputeSphereOfInfluenceAltitude(UFlareWorld* World, FFlare
 }
 
 
-int64 UFlareTravel::ComputePhaseTravelDuration(UFlareWorld* World, FFlareCelestialBody* CelestialBody, double Altitude, double OriginPhase, double DestinationPhase, UFlareFleet* TravelFleet)
+double UFlareTravel::ComputePhaseTravelDistance(UFlareWorld* World, FFlareCelestialBody* CelestialBody, double Altitude, double OriginPhase, double DestinationPhase)
 {
 	double TravelPhase =  FMath::Abs(FMath::UnwindDegrees(DestinationPhase - OriginPhase));
 
 	double OrbitRadius = CelestialBody->Radius + Altitude;
 	double OrbitPerimeter = 2 * PI * OrbitRadius;
-	double TravelDistance = OrbitPerimeter * TravelPhase / 360;
-
-	if (TravelFleet)
-	{
-		float EngineAccelerationPowerRatio = FMath::Max((float) 0.75f, 1.f - (0.005f * (TravelFleet->GetShipCount() - 1)));
-		return ((TravelDistance * 0.015) / (TravelFleet->GetFleetLowestEngineAccelerationPower() * EngineAccelerationPowerRatio)) / (UFlareGameTools::SECONDS_IN_DAY);
-
-	}
-	return (TRAVEL_DURATION_PER_PHASE_KM * TravelDistance) / UFlareGameTools::SECONDS_IN_DAY;
+	return OrbitPerimeter * TravelPhase / 360;
 }
 
-int64 UFlareTravel::ComputeAltitudeTravelDuration(UFlareWorld* World, FFlareCelestialBody* OriginCelestialBody, double OriginAltitude, FFlareCelestialBody* DestinationCelestialBody, double DestinationAltitude, UFlareFleet* TravelFleet)
+double UFlareTravel::ComputeAltitudeTravelPathDistance(UFlareWorld* World, FFlareCelestialBody* OriginCelestialBody, double OriginAltitude, FFlareCelestialBody* DestinationCelestialBody, double DestinationAltitude)
 {
-	double TravelAltitude;
-
 	if (OriginCelestialBody == DestinationCelestialBody)
 	{
-		TravelAltitude = ComputeAltitudeTravelDistance(World, OriginAltitude, DestinationAltitude);
+		return ComputeAltitudeTravelDistance(World, OriginAltitude, DestinationAltitude);
 	}
 	else if (World->GetPlanerarium()->IsSatellite(DestinationCelestialBody, OriginCelestialBody))
 	{
 		// Planet to moon
-		TravelAltitude = ComputeAltitudeTravelToMoonDistance(World, OriginCelestialBody, OriginAltitude, DestinationCelestialBody) +
-						 ComputeAltitudeTravelToSoiDistance(World, DestinationCelestialBody, DestinationAltitude);
+		return ComputeAltitudeTravelToMoonDistance(World, OriginCelestialBody, OriginAltitude, DestinationCelestialBody) +
+			   ComputeAltitudeTravelToSoiDistance(World, DestinationCelestialBody, DestinationAltitude);
 	}
 	else if (World->GetPlanerarium()->IsSatellite(OriginCelestialBody, DestinationCelestialBody))
 	{
 		// Moon to planet
-		TravelAltitude = ComputeAltitudeTravelToSoiDistance(World, OriginCelestialBody, OriginAltitude) +
-						 ComputeAltitudeTravelToMoonDistance(World, DestinationCelestialBody, DestinationAltitude, OriginCelestialBody);
+		return ComputeAltitudeTravelToSoiDistance(World, OriginCelestialBody, OriginAltitude) +
+			   ComputeAltitudeTravelToMoonDistance(World, DestinationCelestialBody, DestinationAltitude, OriginCelestialBody);
 	}
 	else
 	{
-		TravelAltitude = ComputeAltitudeTravelToSoiDistance(World, OriginCelestialBody, OriginAltitude) +
-						 ComputeAltitudeTravelMoonToMoonDistance(World, OriginCelestialBody, DestinationCelestialBody) +
-						 ComputeAltitudeTravelToSoiDistance(World, DestinationCelestialBody, DestinationAltitude);
-	}
-
-	if (TravelFleet && TravelFleet->GetFleetLowestEngineAccelerationPower())
-	{
-		float EngineAccelerationPowerRatio = FMath::Max((float)0.75f, 1.f - (0.01f * (TravelFleet->GetShipCount() - 1)));
-		return ((TravelAltitude * 0.05) / (TravelFleet->GetFleetLowestEngineAccelerationPower() * EngineAccelerationPowerRatio)) / (UFlareGameTools::SECONDS_IN_DAY);
+		return ComputeAltitudeTravelToSoiDistance(World, OriginCelestialBody, OriginAltitude) +
+			   ComputeAltitudeTravelMoonToMoonDistance(World, OriginCelestialBody, DestinationCelestialBody) +
+			   ComputeAltitudeTravelToSoiDistance(World, DestinationCelestialBody, DestinationAltitude);
 	}
-
-	return (TRAVEL_DURATION_PER_ALTITUDE_KM * TravelAltitude + UFlareGameTools::SECONDS_IN_DAY) / UFlareGameTools::SECONDS_IN_DAY;
 }
 
 double UFlareTravel::ComputeAltitudeTravelDistance(UFlareWorld* World, double OriginAltitude, double DestinationAltitude)
@@ -2,6 +2,7 @@
 
 #include "Object.h"
 #include "FlareSimulatedSector.h"
+#include "FlareTravelDurations.h"
 #include "FlareTravel.generated.h"
 
 
@@ -82,9 +83,15 @@ public:
 
 	static int64 ComputeTravelDuration(UFlareWorld* World, UFlareSimulatedSector* OriginSector, UFlareSimulatedSector* DestinationSector, UFlareCompany* Company, UFlareFleet* TravelFleet = nullptr);
 
-	static int64 ComputePhaseTravelDuration(UFlareWorld* World, FFlareCelestialBody* CelestialBody, double Altitude, double OriginPhase, double DestinationPhase, UFlareFleet* TravelFleet);
+	/** Orbital path between two sectors, see FFlareTravelDurations for the cached version */
+	static FFlareTravelLeg ComputeTravelLeg(UFlareWorld* World, UFlareSimulatedSector* OriginSector, UFlareSimulatedSector* DestinationSector);
 
-	static int64 ComputeAltitudeTravelDuration(UFlareWorld* World, FFlareCelestialBody* OriginCelestialBody, double OriginAltitude, FFlareCelestialBody* DestinationCelestialBody, double DestinationAltitude, UFlareFleet* TravelFleet);
+	/** Apply difficulty and technology modifiers to a travel duration */
+	static int64 ApplyCompanyTravelBonus(UFlareWorld* World, UFlareCompany* Company, int64 TravelDuration);
+
+	static double ComputePhaseTravelDistance(UFlareWorld* World, FFlareCelestialBody* CelestialBody, double Altitude, double OriginPhase, double DestinationPhase);
+
+	static double ComputeAltitudeTravelPathDistance(UFlareWorld* World, FFlareCelestialBody* OriginCelestialBody, double OriginAltitude, FFlareCelestialBody* DestinationCelestialBody, double DestinationAltitude);
 
 	static double ComputeSphereOfInfluenceAltitude(UFlareWorld* World, FFlareCelestialBody* CelestialBody);
 
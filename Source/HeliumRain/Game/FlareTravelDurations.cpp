@@ -0,0 +1,166 @@
+
+#include "FlareTravelDurations.h"
+#include "../Flare.h"
+
+#include "FlareWorld.h"
+#include "FlareFleet.h"
+#include "FlareTravel.h"
+#include "FlareGameTools.h"
+#include "FlareSimulatedSector.h"
+
+DECLARE_CYCLE_STAT(TEXT("FlareTravelDurations Update"), STAT_FlareTravelDurations_Update, STATGROUP_Flare);
+
+static const double TRAVEL_DURATION_PER_PHASE_KM = 0.52;
+static const double TRAVEL_DURATION_PER_ALTITUDE_KM = 2;
+
+
+/*----------------------------------------------------
+	Fleet speed
+----------------------------------------------------*/
+
+FFlareTravelFleetSpeed::FFlareTravelFleetSpeed(UFlareFleet* Fleet)
+	: HasFleet(Fleet != NULL)
+	, PhaseSpeed(0)
+	, AltitudeSpeed(0)
+{
+	if (Fleet)
+	{
+		// Large fleets are slower
+		float EnginePower = Fleet->GetFleetLowestEngineAccelerationPower();
+		int32 ShipCount = Fleet->GetShipCount();
+		PhaseSpeed = EnginePower * FMath::Max(0.75f, 1.f - (0.005f * (ShipCount - 1)));
+		AltitudeSpeed = EnginePower * FMath::Max(0.75f, 1.f - (0.01f * (ShipCount - 1)));
+	}
+}
+
+
+/*----------------------------------------------------
+	Constructor
+----------------------------------------------------*/
+
+FFlareTravelDurations::FFlareTravelDurations()
+	: SectorCount(0)
+	, Valid(false)
+{
+}
+
+
+/*----------------------------------------------------
+	Interface
+----------------------------------------------------*/
+
+void FFlareTravelDurations::Invalidate()
+{
+	FScopeLock Lock(&UpdateLock);
+	Valid = false;
+}
+
+void FFlareTravelDurations::Prepare(UFlareWorld* World)
+{
+	FScopeLock Lock(&UpdateLock);
+	if (!Valid)
+	{
+		Update(World);
+	}
+}
+
+const FFlareTravelLeg* FFlareTravelDurations::FindLeg(UFlareWorld* World, UFlareSimulatedSector* OriginSector, UFlareSimulatedSector* DestinationSector)
+{
+	if (!Valid)
+	{
+		Prepare(World);
+	}
+
+	const int32* OriginIndex = SectorIndices.Find(OriginSector);
+	const int32* DestinationIndex = SectorIndices.Find(DestinationSector);
+
+	if (OriginIndex && DestinationIndex)
+	{
+		return &Legs[*OriginIndex * SectorCount + *DestinationIndex];
+	}
+
+	return NULL;
+}
+
+int64 FFlareTravelDurations::GetLegDuration(const FFlareTravelLeg& Leg, const FFlareTravelFleetSpeed& FleetSpeed)
+{
+	if (Leg.PhaseChange)
+	{
+		if (FleetSpeed.HasFleet)
+		{
+			return ((Leg.Distance * 0.015) / FleetSpeed.PhaseSpeed) / UFlareGameTools::SECONDS_IN_DAY;
+		}
+		return (TRAVEL_DURATION_PER_PHASE_KM * Leg.Distance) / UFlareGameTools::SECONDS_IN_DAY;
+	}
+	else
+	{
+		if (FleetSpeed.HasFleet && FleetSpeed.AltitudeSpeed)
+		{
+			return ((Leg.Distance * 0.05) / FleetSpeed.AltitudeSpeed) / UFlareGameTools::SECONDS_IN_DAY;
+		}
+		return (TRAVEL_DURATION_PER_ALTITUDE_KM * Leg.Distance + UFlareGameTools::SECONDS_IN_DAY) / UFlareGameTools::SECONDS_IN_DAY;
+	}
+}
+
+
+/*----------------------------------------------------
+	Getters
+----------------------------------------------------*/
+
+int64 FFlareTravelDurations::GetBaseDuration(UFlareWorld* World, int32 OriginIndex, int32 DestinationIndex)
+{
+	return GetBaseDurations(World, OriginIndex)[DestinationIndex];
+}
+
+const int64* FFlareTravelDurations::GetBaseDurations(UFlareWorld* World, int32 OriginIndex)
+{
+	if (!Valid)
+	{
+		Prepare(World);
+	}
+
+	return &BaseDurations[OriginIndex * SectorCount];
+}
+
+
+/*----------------------------------------------------
+	Internals
+----------------------------------------------------*/
+
+void FFlareTravelDurations::Update(UFlareWorld* World)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareTravelDurations_Update);
+
+	TArray<UFlareSimulatedSector*>& Sectors = World->GetSectors();
+	SectorCount = Sectors.Num();
+
+	SectorIndices.Empty(SectorCount);
+	for (int32 SectorIndex = 0; SectorIndex < SectorCount; SectorIndex++)
+	{
+		SectorIndices.Add(Sectors[SectorIndex], SectorIndex);
+	}
+
+	Legs.SetNumUninitialized(SectorCount * SectorCount);
+	BaseDurations.SetNumUninitialized(SectorCount * SectorCount);
+	FFlareTravelFleetSpeed NoFleet(NULL);
+
+	for (int32 OriginIndex = 0; OriginIndex < SectorCount; OriginIndex++)
+	{
+		for (int32 DestinationIndex = 0; DestinationIndex < SectorCount; DestinationIndex++)
+		{
+			int32 Index = OriginIndex * SectorCount + DestinationIndex;
+			Legs[Index] = UFlareTravel::ComputeTravelLeg(World, Sectors[OriginIndex], Sectors[DestinationIndex]);
+
+			if (OriginIndex == DestinationIndex)
+			{
+				BaseDurations[Index] = 0;
+			}
+			else
+			{
+				BaseDurations[Index] = UFlareTravel::ApplyCompanyTravelBonus(World, NULL, GetLegDuration(Legs[Index], NoFleet));
+			}
+		}
+	}
+
+	Valid = true;
+}
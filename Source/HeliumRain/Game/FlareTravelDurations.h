@@ -0,0 +1,84 @@
+#pragma once
+
+#include "../Flare.h"
+#include "HAL/ThreadSafeBool.h"
+
+class UFlareWorld;
+class UFlareFleet;
+class UFlareSimulatedSector;
+
+
+/** Orbital path between two sectors, independent of the company and fleet */
+struct FFlareTravelLeg
+{
+	/** Travel distance in km */
+	double Distance;
+
+	/** Phase change on the same orbit, or altitude change */
+	bool PhaseChange;
+};
+
+/** Fleet dependent part of a travel duration, cheap to compute for each query */
+struct FFlareTravelFleetSpeed
+{
+	FFlareTravelFleetSpeed(UFlareFleet* Fleet);
+
+	bool HasFleet;
+	float PhaseSpeed;
+	float AltitudeSpeed;
+};
+
+/** Travel durations between world sectors.
+ *  Orbital paths are computed once for each pair of sectors, and only computed again when orbits or sectors change. */
+class FFlareTravelDurations
+{
+public:
+
+	FFlareTravelDurations();
+
+	/*----------------------------------------------------
+		Interface
+	----------------------------------------------------*/
+
+	/** Orbits or the sector list changed, the matrix will be computed again on next use */
+	void Invalidate();
+
+	/** Compute the matrix now if needed. Call from the game thread before using the matrix from workers */
+	void Prepare(UFlareWorld* World);
+
+	/** Path between two sectors, NULL if one of them isn't a world sector */
+	const FFlareTravelLeg* FindLeg(UFlareWorld* World, UFlareSimulatedSector* OriginSector, UFlareSimulatedSector* DestinationSector);
+
+	/** Travel duration in days of a path for a fleet, before company bonuses */
+	static int64 GetLegDuration(const FFlareTravelLeg& Leg, const FFlareTravelFleetSpeed& FleetSpeed);
+
+
+	/*----------------------------------------------------
+		Getters
+	----------------------------------------------------*/
+
+	/** Travel duration with no company or fleet, by index in UFlareWorld::GetSectors() */
+	int64 GetBaseDuration(UFlareWorld* World, int32 OriginIndex, int32 DestinationIndex);
+
+	/** Travel durations from a sector to all sectors, by index in UFlareWorld::GetSectors() */
+	const int64* GetBaseDurations(UFlareWorld* World, int32 OriginIndex);
+
+
+protected:
+
+	/** Fill the matrix */
+	void Update(UFlareWorld* World);
+
+	TMap<UFlareSimulatedSector*, int32>  SectorIndices;
+
+	/** SectorCount x SectorCount */
+	TArray<FFlareTravelLeg>              Legs;
+	TArray<int64>                        BaseDurations;
+
+	int32                                SectorCount;
+	FCriticalSection                     UpdateLock;
+
+	/** Set last by Update, after the matrix is filled, so workers can check it without the lock */
+	FThreadSafeBool                      Valid;
+
+};
@@ -22,6 +22,8 @@
 #include "../Player/FlarePlayerController.h"
 #include "../Player/FlareMenuManager.h"
 
+#include "Async/ParallelFor.h"
+
 #define LOCTEXT_NAMESPACE "FlareWorld"
 
 /*----------------------------------------------------
@@ -30,6 +32,8 @@
 
 UFlareWorld::UFlareWorld(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, EconomySnapshot(true)
+	, EconomySnapshotWithoutStorage(false)
 {
 }
 
@@ -151,6 +155,7 @@ UFlareCompany* UFlareWorld::LoadCompany(const FFlareCompanySave& CompanyData)
 	Company = NewObject<UFlareCompany>(this, UFlareCompany::StaticClass(), CompanyData.Identifier);
     Company->Load(CompanyData);
     Companies.AddUnique(Company);
+	CompanyIndex.Add(Company->GetIdentifier(), Company);
 
 	//FLOGV("UFlareWorld::LoadCompany : loaded '%s'", *Company->GetCompanyName().ToString());
 
@@ -165,7 +170,9 @@ UFlareSimulatedSector* UFlareWorld::LoadSector(const FFlareSectorDescription* De
 	// Create the new sector
 	Sector = NewObject<UFlareSimulatedSector>(this, UFlareSimulatedSector::StaticClass(), SectorData.Identifier);
 	Sector->Load(Description, SectorData, OrbitParameters);
-	Sectors.AddUnique(Sector);
+	Sector->SetWorldIndex(Sectors.AddUnique(Sector));
+	SectorIndex.Add(Sector->GetIdentifier(), Sector);
+	InvalidateSectorTravelDurations();
 
 	//FLOGV("UFlareWorld::LoadSector : loaded '%s'", *Sector->GetSectorName().ToString());
 
@@ -515,11 +522,19 @@ void UFlareWorld::Simulate()
 	 *  End previous day
 	 */
 	FLOGV("** UFlareWorld::Simulate day %d", WorldData.Date);
+	Profiler.BeginDay(WorldData.Date);
+
+	// Travel durations are read from the parallel phases below, compute them here
+	TravelDurations.Prepare(this);
 
 	FLOG("* Simulate > Player autotrade");
+	Profiler.BeginPhase("PlayerAutoTrade");
 	AITradeHelper::CompanyAutoTrade(PlayerCompany);
+	Profiler.EndPhase(PlayerCompany->GetCompanyFleets().Num());
 
 	FLOG("* Simulate > Battles");
+	Profiler.BeginPhase("Battles");
+	int32 BattleCount = 0;
 	for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
 	{
 		UFlareSimulatedSector* Sector = Sectors[SectorIndex];
@@ -536,13 +551,15 @@ void UFlareWorld::Simulate()
 			}
 		}
 
+		Sector->UpdateSectorBattleStates();
+
 		if (!HasBattle)
 		{
 			for (int CompanyIndex = 0; CompanyIndex < Companies.Num(); CompanyIndex++)
 			{
 				UFlareCompany* Company = Companies[CompanyIndex];
 
-				FFlareSectorBattleState BattleState = Sector->UpdateSectorBattleState(Company);
+				FFlareSectorBattleState BattleState = Sector->GetSectorBattleState(Company);
 
 				if (!BattleState.WantFight())
 				{
@@ -556,23 +573,44 @@ void UFlareWorld::Simulate()
 				HasBattle = true;
 			}
 		}
-		else
+
+		if (HasBattle)
 		{
-			for (int CompanyIndex = 0; CompanyIndex < Companies.Num(); CompanyIndex++)
+			if (BattleSimulations.Num() <= BattleCount)
 			{
-				UFlareCompany* Company = Companies[CompanyIndex];
-				FFlareSectorBattleState BattleState = Sector->UpdateSectorBattleState(Company);
+				BattleSimulations.Add(NewObject<UFlareBattle>(this, UFlareBattle::StaticClass()));
 			}
+			BattleSimulations[BattleCount]->Load(Sector);
+			BattleCount++;
 		}
+	}
 
-		if (HasBattle)
+	// Each battle only modifies its own sector, fight them all at once
+	if (UFlareGameTools::ParallelBattles)
+	{
+		ParallelFor(BattleCount, [&](int32 BattleIndex)
 		{
-			if (!BattleSimulation || BattleSimulation == nullptr)
-			{
-				BattleSimulation = NewObject<UFlareBattle>(this, UFlareBattle::StaticClass());
-			}
-			BattleSimulation->Load(Sector);
-			BattleSimulation->Simulate();
+			BattleSimulations[BattleIndex]->Simulate();
+		});
+	}
+	else
+	{
+		for (int32 BattleIndex = 0; BattleIndex < BattleCount; BattleIndex++)
+		{
+			BattleSimulations[BattleIndex]->Simulate();
+		}
+	}
+
+	// Apply the results in sector order
+	int32 CommittedBattleCount = 0;
+	for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
+	{
+		UFlareSimulatedSector* Sector = Sectors[SectorIndex];
+
+		if (CommittedBattleCount < BattleCount && BattleSimulations[CommittedBattleCount]->GetSector() == Sector)
+		{
+			BattleSimulations[CommittedBattleCount]->CommitResults();
+			CommittedBattleCount++;
 		}
 /*
 		// Forcibly remove destroyed "active" spacecraft
@@ -608,6 +646,8 @@ void UFlareWorld::Simulate()
 		}
 	}
 
+	Profiler.EndPhase(BattleCount);
+
 	FLOG("* Simulate > AI");
 
 	HasTotalWorldCombatPointCache = false;
@@ -620,9 +660,11 @@ void UFlareWorld::Simulate()
 	AITradeSources MaintenanceSources(this);
 	AITradeIdleShips IdleShips(this);
 
+	Profiler.BeginPhase("GenerateTradingNeeds");
 	AITradeHelper::GenerateTradingNeeds(Needs, MaintenanceNeeds, StorageNeeds, this);
 	AITradeHelper::GenerateTradingSources(Sources, MaintenanceSources, this);
 	AITradeHelper::GenerateIdleShips(IdleShips, this);
+	Profiler.EndPhase(Needs.List.Num() + MaintenanceNeeds.List.Num() + StorageNeeds.List.Num());
 
 	int32 MaxCombatPoint = 0;
 	UFlareCompany* MaxCombatPointCompany = NULL;
@@ -660,8 +702,12 @@ void UFlareWorld::Simulate()
 
 #endif
 
+	// Trading consumes the needs, count them first
+	int32 NeedCount = MaintenanceNeeds.List.Num() + Needs.List.Num();
+	Profiler.BeginPhase("ComputeGlobalTrading");
 	AITradeHelper::ComputeGlobalTrading(this, MaintenanceNeeds, Sources, MaintenanceSources, IdleShips, CompaniesMoney);
 	AITradeHelper::ComputeGlobalTrading(this, Needs, Sources, MaintenanceSources, IdleShips, CompaniesMoney);
+	Profiler.EndPhase(NeedCount);
 
 	int32 TotalReservedResources = 0;
 	for(UFlareCompany* Company: Companies)
@@ -674,7 +720,10 @@ void UFlareWorld::Simulate()
 		}
 	}
 
+	int32 StorageNeedCount = StorageNeeds.List.Num();
+	Profiler.BeginPhase("ComputeGlobalTrading");
 	AITradeHelper::ComputeGlobalTrading(this, StorageNeeds, Sources, MaintenanceSources, IdleShips, CompaniesMoney);
+	Profiler.EndPhase(StorageNeedCount);
 
 #if DEBUG_NEW_AI_TRADING
 	FLOG("Final trading stat");
@@ -842,6 +891,7 @@ void UFlareWorld::Simulate()
 	SortedCompanyValues.Sort(&CompanyValueComparator);
 	SortedCompanyCombatValues.Sort(&CompanyTotalCombatValueComparator);
 
+	Profiler.BeginPhase("SimulateAI");
 	TArray<UFlareCompany*> CompaniesToSimulateAI = Companies;
 	while(CompaniesToSimulateAI.Num())
 	{
@@ -849,11 +899,14 @@ void UFlareWorld::Simulate()
 		CompaniesToSimulateAI[Index]->SimulateAI(GlobalWar, TotalReservedResources);
 		CompaniesToSimulateAI.RemoveAtSwap(Index);
 	}
+	Profiler.EndPhase(Companies.Num());
 
+	Profiler.BeginPhase("CompanySimulate");
 	for (UFlareCompany* Company : GetCompanies())
 	{
 		Company->Simulate();
 	}
+	Profiler.EndPhase(Companies.Num());
 
 	// Clear bombs, Process meteorites
 	for (UFlareSimulatedSector* Sector : Sectors)
@@ -998,6 +1051,7 @@ void UFlareWorld::Simulate()
 
 	// Factories
 	FLOG("* Simulate > Factories");
+	Profiler.BeginPhase("Factories");
 
 	for (UFlareSimulatedSpacecraft* CurrentShipyard : GetShipyards())
 	{
@@ -1013,17 +1067,23 @@ void UFlareWorld::Simulate()
 		Factories[FactoryIndex]->Simulate();
 	}
 
+	Profiler.EndPhase(Factories.Num() + GetShipyards().Num() + GetCarrierShipyards().Num());
+
 	// Peoples
 	FLOG("* Simulate > Peoples");
+	Profiler.BeginPhase("People");
 	for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
 	{
 		Sectors[SectorIndex]->GetPeople()->Simulate();
 	}
+	Profiler.EndPhase(Sectors.Num());
 
 
 	FLOG("* Simulate > Trade routes");
+	Profiler.BeginPhase("TradeRoutes");
 
 	// Trade routes
+	int32 TradeRouteCount = 0;
 	for (int CompanyIndex = 0; CompanyIndex < Companies.Num(); CompanyIndex++)
 	{
 		TArray<UFlareTradeRoute*>& TradeRoutes = Companies[CompanyIndex]->GetCompanyTradeRoutes();
@@ -1032,9 +1092,12 @@ void UFlareWorld::Simulate()
 		{
 			TradeRoutes[RouteIndex]->Simulate();
 		}
+		TradeRouteCount += TradeRoutes.Num();
 	}
+	Profiler.EndPhase(TradeRouteCount);
 
 	FLOG("* Simulate > Travels");
+	Profiler.BeginPhase("Travels");
 
 	// Undock and make move AI ships
 	for (UFlareSimulatedSector* Sector : Sectors)
@@ -1059,16 +1122,22 @@ void UFlareWorld::Simulate()
 	{
 		TravelsToProcess[TravelIndex]->Simulate();
 	}
+	Profiler.EndPhase(TravelsToProcess.Num());
 	
 	FLOG("* Simulate > Prices");
+	Profiler.BeginPhase("Prices");
 	// Price variation.
 	for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
 	{
 		Sectors[SectorIndex]->SimulatePriceVariation();
 	}
 
+	Profiler.EndPhase(Sectors.Num());
+
 	// People money migration
+	Profiler.BeginPhase("PeopleMoneyMigration");
 	SimulatePeopleMoneyMigration();
+	Profiler.EndPhase(Sectors.Num());
 
 	// Process events
 
@@ -1095,6 +1164,8 @@ void UFlareWorld::Simulate()
 		Company->InvalidateCompanyValueCache();
 	}
 
+	Profiler.EndDay();
+
 	double EndTs = FPlatformTime::Seconds();
 	FLOGV("** Simulate day %d done in %.6fs", WorldData.Date-1, EndTs- StartTs);
 
@@ -1626,17 +1697,32 @@ void UFlareWorld::ProcessAllCaptures()
 
 void UFlareWorld::SimulatePeopleMoneyMigration()
 {
-	for (int SectorIndexA = 0; SectorIndexA < Sectors.Num(); SectorIndexA++)
+	// Work on flat columns, written back once at the end
+	const int32 SectorCount = Sectors.Num();
+	TArray<float> Population;
+	TArray<uint32> Money;
+	TArray<uint32> Dept;
+	Population.SetNumUninitialized(SectorCount);
+	Money.SetNumUninitialized(SectorCount);
+	Dept.SetNumUninitialized(SectorCount);
+
+	for (int SectorIndex = 0; SectorIndex < SectorCount; SectorIndex++)
 	{
-		UFlareSimulatedSector* SectorA = Sectors[SectorIndexA];
+		FFlarePeopleSave* PeopleData = Sectors[SectorIndex]->GetPeople()->GetData();
+		Population[SectorIndex] = PeopleData->Population;
+		Money[SectorIndex] = PeopleData->Money;
+		Dept[SectorIndex] = PeopleData->Dept;
+	}
 
-		for (int SectorIndexB = SectorIndexA + 1; SectorIndexB < Sectors.Num(); SectorIndexB++)
-		{
-			UFlareSimulatedSector* SectorB = Sectors[SectorIndexB];
+	for (int SectorIndexA = 0; SectorIndexA < SectorCount; SectorIndexA++)
+	{
+		const int64* SectorTravelDurations = TravelDurations.GetBaseDurations(this, SectorIndexA);
 
+		for (int SectorIndexB = SectorIndexA + 1; SectorIndexB < SectorCount; SectorIndexB++)
+		{
 			// Money and people migration
-			float PopulationA = SectorA->GetPeople()->GetPopulation();
-			float PopulationB = SectorB->GetPeople()->GetPopulation();
+			float PopulationA = Population[SectorIndexA];
+			float PopulationB = Population[SectorIndexB];
 
 			if(PopulationA == 0 && PopulationB == 0)
 			{
@@ -1646,47 +1732,87 @@ void UFlareWorld::SimulatePeopleMoneyMigration()
 			else if (PopulationA  == 0)
 			{
 				// Origin sector has no population so it leak it's money
-				uint32 TransfertA = SectorA->GetPeople()->GetMoney() / 1000;
-				SectorA->GetPeople()->TakeMoney(TransfertA);
-				SectorB->GetPeople()->Pay(TransfertA);
+				uint32 TransfertA = Money[SectorIndexA] / 1000;
+				UFlarePeople::TakeMoneyFrom(Money[SectorIndexA], Dept[SectorIndexA], TransfertA);
+				UFlarePeople::PayTo(Money[SectorIndexB], Dept[SectorIndexB], TransfertA);
 			}
 			else if (PopulationB  == 0)
 			{
 				// Destination sector has no population so it leak it's money
-				uint32 TransfertB = SectorB->GetPeople()->GetMoney() / 1000;
-				SectorB->GetPeople()->TakeMoney(TransfertB);
-				SectorA->GetPeople()->Pay(TransfertB);
+				uint32 TransfertB = Money[SectorIndexB] / 1000;
+				UFlarePeople::TakeMoneyFrom(Money[SectorIndexB], Dept[SectorIndexB], TransfertB);
+				UFlarePeople::PayTo(Money[SectorIndexA], Dept[SectorIndexA], TransfertB);
 			}
 			else
 			{
 				// Both have population. The wealthier leak.
-				float WealthA = SectorA->GetPeople()->GetWealth();
-				float WealthB = SectorB->GetPeople()->GetWealth();
+				float WealthA = (float) Money[SectorIndexA] / PopulationA;
+				float WealthB = (float) Money[SectorIndexB] / PopulationB;
 				float TotalWealth = WealthA + WealthB;
 
 				float PercentRatio = 0.05f; // 5% at max
-				float TravelDuration = FMath::Max(1.f, (float) UFlareTravel::ComputeTravelDuration(this, SectorA, SectorB, NULL));
+				float TravelDuration = FMath::Max(1.f, (float) SectorTravelDurations[SectorIndexB]);
 
 				if(TotalWealth > 0)
 				{
 					if(WealthA > WealthB)
 					{
 						float LeakRatio = PercentRatio * 2 * ((WealthA / TotalWealth) - 0.5f) / TravelDuration;
-						uint32 TransfertA = LeakRatio * SectorA->GetPeople()->GetMoney();
-						SectorA->GetPeople()->TakeMoney(TransfertA);
-						SectorB->GetPeople()->Pay(TransfertA);
+						uint32 TransfertA = LeakRatio * Money[SectorIndexA];
+						UFlarePeople::TakeMoneyFrom(Money[SectorIndexA], Dept[SectorIndexA], TransfertA);
+						UFlarePeople::PayTo(Money[SectorIndexB], Dept[SectorIndexB], TransfertA);
 					}
 					else
 					{
-						float LeakRatio = 0.05f * 2 * ((WealthB / TotalWealth) - 0.5f) / TravelDuration; // 5% at max
-						uint32 TransfertB = LeakRatio * SectorB->GetPeople()->GetMoney();
-						SectorB->GetPeople()->TakeMoney(TransfertB);
-						SectorA->GetPeople()->Pay(TransfertB);
+						float LeakRatio = PercentRatio * 2 * ((WealthB / TotalWealth) - 0.5f) / TravelDuration;
+						uint32 TransfertB = LeakRatio * Money[SectorIndexB];
+						UFlarePeople::TakeMoneyFrom(Money[SectorIndexB], Dept[SectorIndexB], TransfertB);
+						UFlarePeople::PayTo(Money[SectorIndexA], Dept[SectorIndexA], TransfertB);
 					}
 				}
 			}
 		}
 	}
+
+	for (int SectorIndex = 0; SectorIndex < SectorCount; SectorIndex++)
+	{
+		FFlarePeopleSave* PeopleData = Sectors[SectorIndex]->GetPeople()->GetData();
+		PeopleData->Money = Money[SectorIndex];
+		PeopleData->Dept = Dept[SectorIndex];
+	}
+}
+
+int64 UFlareWorld::GetSectorTravelDuration(int32 OriginIndex, int32 DestinationIndex)
+{
+	return TravelDurations.GetBaseDuration(this, OriginIndex, DestinationIndex);
+}
+
+void UFlareWorld::InvalidateSectorTravelDurations()
+{
+	TravelDurations.Invalidate();
+}
+
+void UFlareWorld::InvalidateEconomySnapshot()
+{
+	EconomySnapshot.Invalidate();
+	EconomySnapshotWithoutStorage.Invalidate();
+}
+
+FFlareEconomySnapshot& UFlareWorld::GetEconomySnapshot(bool IncludeStorage)
+{
+	FFlareEconomySnapshot& Snapshot = (IncludeStorage ? EconomySnapshot : EconomySnapshotWithoutStorage);
+	Snapshot.Prepare(this);
+	return Snapshot;
+}
+
+const FFlareResourceStats& UFlareWorld::GetSectorResourceStats(UFlareSimulatedSector* Sector, FFlareResourceDescription* Resource, bool IncludeStorage)
+{
+	return GetEconomySnapshot(IncludeStorage).GetSectorStats(this, Sector, Resource);
+}
+
+const FFlareResourceStats& UFlareWorld::GetWorldResourceStats(FFlareResourceDescription* Resource, bool IncludeStorage)
+{
+	return GetEconomySnapshot(IncludeStorage).GetWorldStats(this, Resource);
 }
 
 void UFlareWorld::FastForward()
@@ -2226,6 +2352,81 @@ void UFlareWorld::DeleteTravel(UFlareTravel* Travel)
 	Travels.Remove(Travel);
 }
 
+
+/*----------------------------------------------------
+	Identifier index
+----------------------------------------------------*/
+
+void UFlareWorld::RegisterFleet(UFlareFleet* Fleet)
+{
+	FleetIndex.Add(Fleet->GetIdentifier(), Fleet);
+}
+
+void UFlareWorld::UnregisterFleet(UFlareFleet* Fleet)
+{
+	if (FleetIndex.FindRef(Fleet->GetIdentifier()) == Fleet)
+	{
+		FleetIndex.Remove(Fleet->GetIdentifier());
+	}
+}
+
+void UFlareWorld::RegisterTradeRoute(UFlareTradeRoute* TradeRoute)
+{
+	TradeRouteIndex.Add(TradeRoute->GetIdentifier(), TradeRoute);
+}
+
+void UFlareWorld::UnregisterTradeRoute(UFlareTradeRoute* TradeRoute)
+{
+	if (TradeRouteIndex.FindRef(TradeRoute->GetIdentifier()) == TradeRoute)
+	{
+		TradeRouteIndex.Remove(TradeRoute->GetIdentifier());
+	}
+}
+
+void UFlareWorld::RegisterSpacecraft(UFlareSimulatedSpacecraft* Spacecraft)
+{
+	FName Immatriculation = Spacecraft->GetImmatriculation();
+
+	if (Spacecraft->IsDestroyed())
+	{
+		if (SpacecraftIndex.FindRef(Immatriculation) == Spacecraft)
+		{
+			SpacecraftIndex.Remove(Immatriculation);
+		}
+
+		// Keep the first destroyed spacecraft with this immatriculation
+		if (!DestroyedSpacecraftIndex.Contains(Immatriculation))
+		{
+			DestroyedSpacecraftIndex.Add(Immatriculation, Spacecraft);
+		}
+	}
+	else if (!Spacecraft->IsComplexElement())
+	{
+		// Complex elements are only reachable through their master, as in UFlareCompany::FindSpacecraft
+		SpacecraftIndex.Add(Immatriculation, Spacecraft);
+	}
+}
+
+void UFlareWorld::SetSpacecraftSector(UFlareSimulatedSpacecraft* Spacecraft, UFlareSimulatedSector* Sector)
+{
+	// Travel sectors are not world sectors
+	if (Sector->GetOuter() != this)
+	{
+		return;
+	}
+
+	SpacecraftSectorIndex.Add(Spacecraft->GetImmatriculation(), Sector);
+}
+
+void UFlareWorld::ClearSpacecraftSector(UFlareSimulatedSpacecraft* Spacecraft, UFlareSimulatedSector* Sector)
+{
+	if (SpacecraftSectorIndex.FindRef(Spacecraft->GetImmatriculation()) == Sector)
+	{
+		SpacecraftSectorIndex.Remove(Spacecraft->GetImmatriculation());
+	}
+}
+
+
 /*----------------------------------------------------
 	Getters
 ----------------------------------------------------*/
@@ -2281,16 +2482,7 @@ TArray<UFlareSimulatedSpacecraft*> UFlareWorld::GetShipyardsFor(UFlareCompany* C
 
 UFlareCompany* UFlareWorld::FindCompany(FName Identifier) const
 {
-	for (int i = 0; i < Companies.Num(); i++)
-	{
-		UFlareCompany* Company = Companies[i];
-		if (Company->GetIdentifier() == Identifier)
-		{
-			return Company;
-		}
-	}
-
-	return NULL;
+	return CompanyIndex.FindRef(Identifier);
 }
 
 UFlareCompany* UFlareWorld::FindCompanyByShortName(FName CompanyShortName) const
@@ -2310,89 +2502,34 @@ UFlareCompany* UFlareWorld::FindCompanyByShortName(FName CompanyShortName) const
 
 UFlareSimulatedSector* UFlareWorld::FindSector(FName Identifier) const
 {
-	for (int i = 0; i < Sectors.Num(); i++)
-	{
-		UFlareSimulatedSector* Sector = Sectors[i];
-		if (Sector->GetIdentifier() == Identifier)
-		{
-			return Sector;
-		}
-	}
-
-	return NULL;
+	return SectorIndex.FindRef(Identifier);
 }
 
-UFlareSimulatedSector* UFlareWorld::FindSectorBySpacecraft(FName SpacecraftIdentifier) const
+UFlareSimulatedSector* UFlareWorld::FindSectorBySpacecraft(FName ShipImmatriculation) const
 {
-	for (int i = 0; i < Sectors.Num(); i++)
-	{
-		UFlareSimulatedSector* Sector = Sectors[i];
-		for (int j = 0; j < Sector->GetSectorSpacecrafts().Num(); j++)
-		{
-			if (Sector->GetSectorSpacecrafts()[j]->GetDescription()->Identifier == SpacecraftIdentifier)
-			{
-				return Sector;
-			}
-		}
-	}
-	return NULL;
+	return SpacecraftSectorIndex.FindRef(ShipImmatriculation);
 }
 
 UFlareFleet* UFlareWorld::FindFleet(FName Identifier) const
 {
-	for (int i = 0; i < Companies.Num(); i++)
-	{
-		UFlareCompany* Company = Companies[i];
-		UFlareFleet* Fleet = Company->FindFleet(Identifier);
-		if (Fleet)
-		{
-			return Fleet;
-		}
-	}
-	return NULL;
+	return FleetIndex.FindRef(Identifier);
 }
 
 UFlareTradeRoute* UFlareWorld::FindTradeRoute(FName Identifier) const
 {
-	for (int i = 0; i < Companies.Num(); i++)
-	{
-		UFlareCompany* Company = Companies[i];
-		UFlareTradeRoute* TradeRoute = Company->FindTradeRoute(Identifier);
-		if (TradeRoute)
-		{
-			return TradeRoute;
-		}
-	}
-	return NULL;
+	return TradeRouteIndex.FindRef(Identifier);
 }
 
 UFlareSimulatedSpacecraft* UFlareWorld::FindSpacecraft(FName ShipImmatriculation)
 {
-	for (UFlareCompany* Company : Companies)
+	UFlareSimulatedSpacecraft* Spacecraft = SpacecraftIndex.FindRef(ShipImmatriculation);
+	if (Spacecraft)
 	{
-		UFlareSimulatedSpacecraft* Spacecraft = Company->FindSpacecraft(ShipImmatriculation);
-		if (Spacecraft)
-		{
-			return Spacecraft;
-		}
-		Spacecraft = Company->FindSpacecraft(ShipImmatriculation, true);
-		if (Spacecraft)
-		{
-			return Spacecraft;
-		}
+		return Spacecraft;
 	}
-/*
+
 	// Now check destroyed ships
-	for (UFlareCompany* Company : Companies)
-	{
-		UFlareSimulatedSpacecraft* Spacecraft = Company->FindSpacecraft(ShipImmatriculation, true);
-		if (Spacecraft)
-		{
-			return Spacecraft;
-		}
-	}
-*/
-	return NULL;
+	return DestroyedSpacecraftIndex.FindRef(ShipImmatriculation);
 }
 
 
@@ -4,6 +4,9 @@
 #include "Object.h"
 #include "FlareGameTypes.h"
 #include "FlareTravel.h"
+#include "FlareSimulationProfiler.h"
+#include "FlareTravelDurations.h"
+#include "FlareEconomySnapshot.h"
 #include "Planetarium/FlareSimulatedPlanetarium.h"
 #include "FlareWorld.generated.h"
 
@@ -170,6 +173,24 @@ public:
 
 	void SimulatePeopleMoneyMigration();
 
+	/** Travel duration between two world sectors with no company or fleet bonus, by index in GetSectors() */
+	int64 GetSectorTravelDuration(int32 OriginIndex, int32 DestinationIndex);
+
+	/** Sector orbits or the sector list changed, travel durations will be computed again */
+	void InvalidateSectorTravelDurations();
+
+	/** Stocks, stations or factories changed, economy stats will be computed again on next use */
+	void InvalidateEconomySnapshot();
+
+	/** Resource stats of all sectors for the current day, computed on first use */
+	FFlareEconomySnapshot& GetEconomySnapshot(bool IncludeStorage);
+
+	/** Resource stats of a sector for the current day */
+	const FFlareResourceStats& GetSectorResourceStats(UFlareSimulatedSector* Sector, FFlareResourceDescription* Resource, bool IncludeStorage);
+
+	/** Resource stats of the whole world for the current day */
+	const FFlareResourceStats& GetWorldResourceStats(FFlareResourceDescription* Resource, bool IncludeStorage);
+
 	/** Simulate world from now to the next event */
 	void FastForward();
 
@@ -192,6 +213,32 @@ public:
 
 	FFlareWorldGameEventSave* GetGlobalEvent(FName EventSearch);
 
+
+	/*----------------------------------------------------
+		Identifier index
+	----------------------------------------------------*/
+
+	/** Add a fleet to the identifier index */
+	void RegisterFleet(UFlareFleet* Fleet);
+
+	/** Remove a fleet from the identifier index */
+	void UnregisterFleet(UFlareFleet* Fleet);
+
+	/** Add a trade route to the identifier index */
+	void RegisterTradeRoute(UFlareTradeRoute* TradeRoute);
+
+	/** Remove a trade route from the identifier index */
+	void UnregisterTradeRoute(UFlareTradeRoute* TradeRoute);
+
+	/** Add a spacecraft to the live or destroyed spacecraft index, depending on its state */
+	void RegisterSpacecraft(UFlareSimulatedSpacecraft* Spacecraft);
+
+	/** Set the sector a spacecraft is listed in */
+	void SetSpacecraftSector(UFlareSimulatedSpacecraft* Spacecraft, UFlareSimulatedSector* Sector);
+
+	/** A spacecraft left a sector */
+	void ClearSpacecraftSector(UFlareSimulatedSpacecraft* Spacecraft, UFlareSimulatedSector* Sector);
+
 protected:
 
 	/*----------------------------------------------------
@@ -227,13 +274,33 @@ protected:
 	UPROPERTY()
 	UFlareSimulatedPlanetarium*			 Planetarium;
 
+	/** Battles of the day, one per contested sector, reused from day to day */
 	UPROPERTY()
-	UFlareBattle*					  	 BattleSimulation;
+	TArray<UFlareBattle*>				 BattleSimulations;
 
 	TArray<AFlareSpacecraft*>			 PendingActiveSpacecraftDeletions;
 
 	AFlareGame*                          Game;
 
+	/** Per-phase timings of the daily simulation */
+	FFlareSimulationProfiler             Profiler;
+
+	/** Travel durations between world sectors */
+	FFlareTravelDurations                TravelDurations;
+
+	/** Daily resource stats, with and without storage stations */
+	FFlareEconomySnapshot                EconomySnapshot;
+	FFlareEconomySnapshot                EconomySnapshotWithoutStorage;
+
+	/** Identifier indexes */
+	TMap<FName, UFlareCompany*>             CompanyIndex;
+	TMap<FName, UFlareSimulatedSector*>     SectorIndex;
+	TMap<FName, UFlareFleet*>               FleetIndex;
+	TMap<FName, UFlareTradeRoute*>          TradeRouteIndex;
+	TMap<FName, UFlareSimulatedSpacecraft*> SpacecraftIndex;
+	TMap<FName, UFlareSimulatedSpacecraft*> DestroyedSpacecraftIndex;
+	TMap<FName, UFlareSimulatedSector*>     SpacecraftSectorIndex;
+
 	bool RunningPrimarySimulate;
 	bool WorldMoneyReferenceInit;
 	TArray<UFlareCompany*> SortedCompanyValues;
@@ -268,6 +335,16 @@ public:
 		return &WorldData;
 	}
 
+	inline FFlareSimulationProfiler& GetProfiler()
+	{
+		return Profiler;
+	}
+
+	inline FFlareTravelDurations& GetTravelDurations()
+	{
+		return TravelDurations;
+	}
+
 	inline UFlareSimulatedPlanetarium* GetPlanerarium()
 	{
 		return Planetarium;
@@ -322,7 +399,8 @@ public:
 
 	UFlareSimulatedSector* FindSector(FName Identifier) const;
 
-	UFlareSimulatedSector* FindSectorBySpacecraft(FName SpacecraftIdentifier) const;
+	/** Find the sector listing a spacecraft, by immatriculation */
+	UFlareSimulatedSector* FindSectorBySpacecraft(FName ShipImmatriculation) const;
 
 	UFlareFleet* FindFleet(FName Identifier) const;
 
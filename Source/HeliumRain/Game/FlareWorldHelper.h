@@ -1,17 +1,11 @@
 #pragma once
 #include "../Economy/FlareResource.h"
+#include "FlareEconomySnapshot.h"
 #include "FlareWorld.h"
 
 struct WorldHelper
 {
-	struct FlareResourceStats
-	{
-		float Production;
-		float Consumption;
-		float Balance;
-		int32 Stock;
-		int32 Capacity;
-	};
+	typedef FFlareResourceStats FlareResourceStats;
 
 	static TMap<FFlareResourceDescription*, FlareResourceStats> ComputeWorldResourceStats(AFlareGame* Game, bool IncludeStorage);
 
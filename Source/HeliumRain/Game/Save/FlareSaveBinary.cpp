@@ -0,0 +1,1022 @@
+
+#include "FlareSaveBinary.h"
+#include "../../Flare.h"
+
+#include "FlareSaveWriter.h"
+#include "../FlareSaveGame.h"
+
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+
+
+/*----------------------------------------------------
+	Constructor
+----------------------------------------------------*/
+
+UFlareSaveBinary::UFlareSaveBinary(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, Version(FLARE_SAVE_BINARY_VERSION)
+{
+}
+
+
+/*----------------------------------------------------
+	Binary file writer
+----------------------------------------------------*/
+
+FFlareSaveBinaryWriter::FFlareSaveBinaryWriter(const FString& FileName)
+	: FileWriter(NULL)
+	, TargetFileName(FileName)
+	, TempFileName(FileName + TEXT(".tmp"))
+	, Position(0)
+{
+	SetIsSaving(true);
+	SetIsPersistent(true);
+
+	FileWriter = IFileManager::Get().CreateFileWriter(*TempFileName);
+	if (!FileWriter)
+	{
+		FLOGV("FFlareSaveBinaryWriter : fail to open '%s'", *TempFileName);
+		SetError();
+		return;
+	}
+
+	uint32 Magic = FLARE_SAVE_BINARY_MAGIC;
+	uint32 FileVersion = FLARE_SAVE_BINARY_VERSION;
+	*FileWriter << Magic;
+	*FileWriter << FileVersion;
+
+	Chunk.Reserve(FLARE_SAVE_BINARY_CHUNK_SIZE);
+}
+
+FFlareSaveBinaryWriter::~FFlareSaveBinaryWriter()
+{
+	// Not closed, drop the partial file
+	if (FileWriter)
+	{
+		delete FileWriter;
+		IFileManager::Get().Delete(*TempFileName, false, false, true);
+	}
+}
+
+void FFlareSaveBinaryWriter::Serialize(void* Data, int64 Length)
+{
+	if (IsError() || !FileWriter)
+	{
+		return;
+	}
+
+	const uint8* Source = (const uint8*) Data;
+	Position += Length;
+
+	while (Length > 0)
+	{
+		int64 CopySize = FMath::Min<int64>(Length, FLARE_SAVE_BINARY_CHUNK_SIZE - Chunk.Num());
+		Chunk.Append(Source, CopySize);
+		Source += CopySize;
+		Length -= CopySize;
+
+		if (Chunk.Num() == FLARE_SAVE_BINARY_CHUNK_SIZE)
+		{
+			FlushChunk();
+		}
+	}
+}
+
+bool FFlareSaveBinaryWriter::Close()
+{
+	if (!FileWriter)
+	{
+		return false;
+	}
+
+	// A zero-sized block ends the file
+	FlushChunk();
+	int32 EndMarker = 0;
+	*FileWriter << EndMarker;
+
+	bool Result = !IsError() && FileWriter->Close();
+	delete FileWriter;
+	FileWriter = NULL;
+
+	if (Result)
+	{
+		Result = IFileManager::Get().Move(*TargetFileName, *TempFileName, true);
+	}
+
+	if (!Result)
+	{
+		IFileManager::Get().Delete(*TempFileName, false, false, true);
+		SetError();
+	}
+
+	return Result;
+}
+
+void FFlareSaveBinaryWriter::FlushChunk()
+{
+	if (Chunk.Num() == 0 || IsError())
+	{
+		return;
+	}
+
+	int32 UncompressedSize = Chunk.Num();
+	int32 CompressedSize = FCompression::CompressMemoryBound(COMPRESS_ZLIB, UncompressedSize);
+	CompressedChunk.SetNumUninitialized(CompressedSize, false);
+
+	if (!FCompression::CompressMemory(COMPRESS_ZLIB, CompressedChunk.GetData(), CompressedSize, Chunk.GetData(), UncompressedSize))
+	{
+		FLOGV("FFlareSaveBinaryWriter : fail to compress save '%s'", *TargetFileName);
+		SetError();
+		return;
+	}
+
+	*FileWriter << UncompressedSize;
+	*FileWriter << CompressedSize;
+	FileWriter->Serialize(CompressedChunk.GetData(), CompressedSize);
+
+	if (FileWriter->IsError())
+	{
+		SetError();
+	}
+
+	Chunk.Reset();
+}
+
+
+/*----------------------------------------------------
+	Interface
+----------------------------------------------------*/
+
+bool UFlareSaveBinary::SaveGame(const FString& FileName, UFlareSaveGame* Data)
+{
+	Version = FLARE_SAVE_BINARY_VERSION;
+	NameIndices.Empty();
+
+	FFlareSaveBinaryWriter Ar(FileName);
+	if (!Ar.IsError())
+	{
+		SerializeGame(Ar, Data);
+	}
+
+	if (!Ar.Close())
+	{
+		FLOGV("UFlareSaveBinary::SaveGame : fail to write save '%s'", *FileName);
+		return false;
+	}
+
+	return true;
+}
+
+UFlareSaveGame* UFlareSaveBinary::LoadGame(const FString& FileName)
+{
+	TArray<uint8> Payload;
+	Version = ReadFile(FileName, Payload);
+
+	if (Version == INDEX_NONE)
+	{
+		return NULL;
+	}
+	else if (Version > FLARE_SAVE_BINARY_VERSION)
+	{
+		FLOGV("WARNING: Invalid save version. Save format is '%d' ('%d' expected)", Version, FLARE_SAVE_BINARY_VERSION);
+		return NULL;
+	}
+
+	Names.Empty();
+
+	UFlareSaveGame* SaveGame = NewObject<UFlareSaveGame>(this, UFlareSaveGame::StaticClass());
+	FMemoryReader Ar(Payload, true);
+	SerializeGame(Ar, SaveGame);
+
+	if (Ar.IsError())
+	{
+		FLOGV("WARNING: Fail to read binary save '%s'. Save corrupted", *FileName);
+		return NULL;
+	}
+
+	return SaveGame;
+}
+
+void UFlareSaveBinary::SerializeGame(FArchive& Ar, UFlareSaveGame* Data)
+{
+	SerializeBool(Ar, Data->AutoSave);
+
+	SerializePlayer(Ar, Data->PlayerData);
+	SerializeCompanyDescription(Ar, Data->PlayerCompanyDescription);
+	Ar << Data->CurrentImmatriculationIndex;
+	Ar << Data->CurrentIdentifierIndex;
+	SerializeWorld(Ar, Data->WorldData);
+}
+
+
+/*----------------------------------------------------
+	Structures
+----------------------------------------------------*/
+
+void UFlareSaveBinary::SerializePlayer(FArchive& Ar, FFlarePlayerSave& Data)
+{
+	SerializeName(Ar, Data.UUID);
+	Ar << Data.ScenarioId;
+	Ar << Data.DifficultyId;
+	SerializeBool(Ar, Data.AICheats);
+
+	Ar << Data.PlayerEmblemIndex;
+	SerializeName(Ar, Data.CompanyIdentifier);
+	SerializeName(Ar, Data.PlayerFleetIdentifier);
+	SerializeName(Ar, Data.LastFlownShipIdentifier);
+	SerializeQuest(Ar, Data.QuestData);
+	SerializeNameArray(Ar, Data.UnlockedScannables);
+}
+
+void UFlareSaveBinary::SerializeQuest(FArchive& Ar, FFlareQuestSave& Data)
+{
+	SerializeName(Ar, Data.SelectedQuest);
+	SerializeBool(Ar, Data.PlayTutorial);
+	SerializeBool(Ar, Data.PlayStory);
+	Ar << Data.NextGeneratedQuestIndex;
+
+	SerializeArray(Ar, Data.QuestProgresses, &UFlareSaveBinary::SerializeQuestProgress);
+	SerializeNameArray(Ar, Data.SuccessfulQuests);
+	SerializeNameArray(Ar, Data.AbandonedQuests);
+	SerializeNameArray(Ar, Data.FailedQuests);
+	SerializeArray(Ar, Data.GeneratedQuests, &UFlareSaveBinary::SerializeGeneratedQuest);
+}
+
+void UFlareSaveBinary::SerializeQuestProgress(FArchive& Ar, FFlareQuestProgressSave& Data)
+{
+	SerializeName(Ar, Data.QuestIdentifier);
+	SerializeEnum(Ar, Data.Status, TEXT("EFlareQuestStatus"));
+	Ar << Data.AvailableDate;
+	Ar << Data.AcceptationDate;
+	SerializeBundle(Ar, Data.Data);
+
+	SerializeNameArray(Ar, Data.SuccessfullSteps);
+	SerializeArray(Ar, Data.CurrentStepProgress, &UFlareSaveBinary::SerializeQuestStepProgress);
+	SerializeArray(Ar, Data.TriggerConditionsSave, &UFlareSaveBinary::SerializeQuestStepProgress);
+	SerializeArray(Ar, Data.ExpirationConditionsSave, &UFlareSaveBinary::SerializeQuestStepProgress);
+}
+
+void UFlareSaveBinary::SerializeGeneratedQuest(FArchive& Ar, FFlareGeneratedQuestSave& Data)
+{
+	SerializeName(Ar, Data.QuestClass);
+	SerializeBundle(Ar, Data.Data);
+}
+
+void UFlareSaveBinary::SerializeQuestStepProgress(FArchive& Ar, FFlareQuestConditionSave& Data)
+{
+	SerializeName(Ar, Data.ConditionIdentifier);
+	SerializeBundle(Ar, Data.Data);
+}
+
+void UFlareSaveBinary::SerializeCompanyDescription(FArchive& Ar, FFlareCompanyDescription& Data)
+{
+	SerializeText(Ar, Data.Name);
+	SerializeName(Ar, Data.ShortName);
+	SerializeText(Ar, Data.Description);
+
+	SerializeColor(Ar, Data.CustomizationBasePaintColor);
+	SerializeColor(Ar, Data.CustomizationPaintColor);
+	SerializeColor(Ar, Data.CustomizationOverlayColor);
+	SerializeColor(Ar, Data.CustomizationLightColor);
+	Ar << Data.CustomizationPatternIndex;
+}
+
+void UFlareSaveBinary::SerializeWorld(FArchive& Ar, FFlareWorldSave& Data)
+{
+	Ar << Data.Date;
+
+	SerializeArray(Ar, Data.GlobalEvents, &UFlareSaveBinary::SerializeWorldEvents);
+	SerializeArray(Ar, Data.CompanyData, &UFlareSaveBinary::SerializeCompany);
+	SerializeArray(Ar, Data.SectorData, &UFlareSaveBinary::SerializeSector);
+	SerializeArray(Ar, Data.TravelData, &UFlareSaveBinary::SerializeTravel);
+}
+
+void UFlareSaveBinary::SerializeWorldEvents(FArchive& Ar, FFlareWorldGameEventSave& Data)
+{
+	SerializeName(Ar, Data.EventName);
+	Ar << Data.EventDate;
+	Ar << Data.EventDateEnd;
+}
+
+void UFlareSaveBinary::SerializeCompany(FArchive& Ar, FFlareCompanySave& Data)
+{
+	SerializeName(Ar, Data.Identifier);
+	Ar << Data.CatalogIdentifier;
+	Ar << Data.Money;
+	Ar << Data.CompanyValue;
+	Ar << Data.PlayerLastPeaceDate;
+	Ar << Data.PlayerLastWarDate;
+	Ar << Data.PlayerLastTributeDate;
+	Ar << Data.FleetImmatriculationIndex;
+	Ar << Data.TradeRouteImmatriculationIndex;
+	Ar << Data.WhiteListImmatriculationIndex;
+	SerializeName(Ar, Data.DefaultWhiteListIdentifier);
+	Ar << Data.TechnologyLevel;
+	Ar << Data.ResearchAmount;
+	Ar << Data.ResearchSpent;
+	SerializeCompanyAI(Ar, Data.AI);
+	SerializeCompanyLicenses(Ar, Data.Licenses);
+
+	SerializeFloat(Ar, Data.ResearchRatio);
+	SerializeFloat(Ar, Data.Retaliation);
+
+	SerializeNameArray(Ar, Data.UnlockedTechnologies);
+	SerializeNameArray(Ar, Data.CaptureOrders);
+	SerializeNameArray(Ar, Data.HostileCompanies);
+
+	SerializeArray(Ar, Data.ShipData, &UFlareSaveBinary::SerializeSpacecraft);
+	SerializeArray(Ar, Data.ChildStationData, &UFlareSaveBinary::SerializeSpacecraft);
+	SerializeArray(Ar, Data.StationData, &UFlareSaveBinary::SerializeSpacecraft);
+	SerializeArray(Ar, Data.DestroyedSpacecraftData, &UFlareSaveBinary::SerializeSpacecraft);
+	SerializeArray(Ar, Data.Fleets, &UFlareSaveBinary::SerializeFleet);
+	SerializeArray(Ar, Data.TradeRoutes, &UFlareSaveBinary::SerializeTradeRoute);
+	SerializeArray(Ar, Data.WhiteLists, &UFlareSaveBinary::SerializeWhiteList);
+	SerializeArray(Ar, Data.SectorsKnowledge, &UFlareSaveBinary::SerializeSectorKnowledge);
+
+	SerializeFloat(Ar, Data.PlayerReputation);
+
+	SerializeArray(Ar, Data.TransactionLog, &UFlareSaveBinary::SerializeTransactionLogEntry);
+}
+
+void UFlareSaveBinary::SerializeSpacecraft(FArchive& Ar, FFlareSpacecraftSave& Data)
+{
+	SerializeBool(Ar, Data.IsDestroyed);
+	SerializeBool(Ar, Data.IsUnderConstruction);
+	SerializeName(Ar, Data.Immatriculation);
+	SerializeName(Ar, Data.ImmatriculationReplacement);
+	SerializeText(Ar, Data.NickName);
+	SerializeName(Ar, Data.Identifier);
+	SerializeName(Ar, Data.CompanyIdentifier);
+	SerializeVector(Ar, Data.Location);
+	SerializeRotator(Ar, Data.Rotation);
+	SerializeEnum(Ar, Data.SpawnMode, TEXT("EFlareSpawnMode"));
+	SerializeVector(Ar, Data.LinearVelocity);
+	SerializeVector(Ar, Data.AngularVelocity);
+	SerializeBool(Ar, Data.WantUndockInternalShips);
+	SerializeName(Ar, Data.DockedTo);
+	Ar << Data.DockedAt;
+	SerializeName(Ar, Data.DockedAtInternally);
+	SerializeName(Ar, Data.DefaultWhiteListIdentifier);
+	SerializeFloat(Ar, Data.DockedAngle);
+	SerializeFloat(Ar, Data.Heat);
+	SerializeFloat(Ar, Data.PowerOutageDelay);
+	SerializeFloat(Ar, Data.PowerOutageAcculumator);
+	SerializeName(Ar, Data.DynamicComponentStateIdentifier);
+	SerializeFloat(Ar, Data.DynamicComponentStateProgress);
+	Ar << Data.Level;
+	Ar << Data.TradingReason;
+	SerializeBool(Ar, Data.IsTrading);
+	SerializeName(Ar, Data.IsTradingWith);
+	SerializeBool(Ar, Data.IsIntercepted);
+	SerializeFloat(Ar, Data.RefillStock);
+	SerializeFloat(Ar, Data.RepairStock);
+	SerializeBool(Ar, Data.IsReserve);
+	SerializeBool(Ar, Data.AllowExternalOrder);
+	SerializeBool(Ar, Data.AllowAutoConstruction);
+	SerializePilot(Ar, Data.Pilot);
+	SerializeAsteroid(Ar, Data.AsteroidData);
+	SerializeName(Ar, Data.OwnerShipName);
+	SerializeName(Ar, Data.AttachActorName);
+	SerializeName(Ar, Data.AttachComplexStationName);
+	SerializeName(Ar, Data.AttachComplexConnectorName);
+
+	SerializeArray(Ar, Data.Components, &UFlareSaveBinary::SerializeSpacecraftComponent);
+	SerializeArray(Ar, Data.ConstructionCargoBay, &UFlareSaveBinary::SerializeCargo);
+	SerializeArray(Ar, Data.ProductionCargoBay, &UFlareSaveBinary::SerializeCargo);
+	SerializeArray(Ar, Data.FactoryConstructionStates, &UFlareSaveBinary::SerializeFactory);
+	SerializeArray(Ar, Data.FactoryStates, &UFlareSaveBinary::SerializeFactory);
+	SerializeArray(Ar, Data.ShipyardOrderQueue, &UFlareSaveBinary::SerializeShipyardOrder);
+	SerializeNameArray(Ar, Data.SalesExcludedResources);
+	SerializeNameArray(Ar, Data.ShipyardOrderExternalConfig);
+	SerializeNameArray(Ar, Data.OwnedShipNames);
+	SerializeArray(Ar, Data.ConnectedStations, &UFlareSaveBinary::SerializeStationConnection);
+
+	int32 CapturePointCount = SerializeCount(Ar, Data.CapturePoints.Num());
+	if (Ar.IsSaving())
+	{
+		for (auto& Pair : Data.CapturePoints)
+		{
+			SerializeName(Ar, Pair.Key);
+			Ar << Pair.Value;
+		}
+	}
+	else
+	{
+		Data.CapturePoints.Empty(CapturePointCount);
+		for (int32 i = 0; i < CapturePointCount; i++)
+		{
+			FName Company;
+			int32 Points = 0;
+			SerializeName(Ar, Company);
+			Ar << Points;
+			Data.CapturePoints.Add(Company, Points);
+		}
+	}
+
+	Ar << Data.SaveVersion;
+}
+
+void UFlareSaveBinary::SerializePilot(FArchive& Ar, FFlareShipPilotSave& Data)
+{
+	SerializeName(Ar, Data.Identifier);
+	Ar << Data.Name;
+}
+
+void UFlareSaveBinary::SerializeAsteroid(FArchive& Ar, FFlareAsteroidSave& Data)
+{
+	SerializeName(Ar, Data.Identifier);
+	SerializeVector(Ar, Data.Location);
+	SerializeRotator(Ar, Data.Rotation);
+	SerializeVector(Ar, Data.LinearVelocity);
+	SerializeVector(Ar, Data.AngularVelocity);
+	SerializeVector(Ar, Data.Scale);
+	Ar << Data.AsteroidMeshID;
+}
+
+void UFlareSaveBinary::SerializeMeteorite(FArchive& Ar, FFlareMeteoriteSave& Data)
+{
+	SerializeVector(Ar, Data.Location);
+	SerializeVector(Ar, Data.TargetOffset);
+	SerializeRotator(Ar, Data.Rotation);
+	SerializeVector(Ar, Data.LinearVelocity);
+	SerializeVector(Ar, Data.AngularVelocity);
+	Ar << Data.MeteoriteMeshID;
+	SerializeBool(Ar, Data.IsMetal);
+	SerializeFloat(Ar, Data.Damage);
+	SerializeFloat(Ar, Data.BrokenDamage);
+	SerializeName(Ar, Data.TargetStation);
+	SerializeBool(Ar, Data.HasMissed);
+	Ar << Data.DaysBeforeImpact;
+}
+
+void UFlareSaveBinary::SerializeSpacecraftComponent(FArchive& Ar, FFlareSpacecraftComponentSave& Data)
+{
+	SerializeName(Ar, Data.ComponentIdentifier);
+	SerializeName(Ar, Data.ShipSlotIdentifier);
+	SerializeFloat(Ar, Data.Damage);
+	SerializeFloat(Ar, Data.Turret.TurretAngle);
+	SerializeFloat(Ar, Data.Turret.BarrelsAngle);
+	Ar << Data.Weapon.FiredAmmo;
+	SerializeTurretPilot(Ar, Data.Pilot);
+}
+
+void UFlareSaveBinary::SerializeTurretPilot(FArchive& Ar, FFlareTurretPilotSave& Data)
+{
+	SerializeName(Ar, Data.Identifier);
+	Ar << Data.Name;
+}
+
+void UFlareSaveBinary::SerializeStationConnection(FArchive& Ar, FFlareConnectionSave& Data)
+{
+	SerializeName(Ar, Data.ConnectorName);
+	SerializeName(Ar, Data.StationIdentifier);
+}
+
+void UFlareSaveBinary::SerializeTradeOperation(FArchive& Ar, FFlareTradeRouteSectorOperationSave& Data)
+{
+	SerializeName(Ar, Data.ResourceIdentifier);
+	Ar << Data.GotoSectorIndex;
+	Ar << Data.GotoOperationIndex;
+
+	Ar << Data.MaxQuantity;
+	Ar << Data.InventoryLimit;
+	Ar << Data.MaxWait;
+	SerializeEnum(Ar, Data.Type, TEXT("EFlareTradeRouteOperation"));
+
+	SerializeFloat(Ar, Data.LoadUnloadPriority);
+	SerializeFloat(Ar, Data.BuySellPriority);
+	SerializeBool(Ar, Data.CanTradeWithStorages);
+	SerializeBool(Ar, Data.CanDonate);
+
+	SerializeArray(Ar, Data.OperationConditions, &UFlareSaveBinary::SerializeOperationCondition);
+}
+
+void UFlareSaveBinary::SerializeOperationCondition(FArchive& Ar, FFlareTradeRouteOperationConditionSave& Data)
+{
+	SerializeEnum(Ar, Data.ConditionRequirement, TEXT("EFlareTradeRouteOperationConditions"));
+	SerializeFloat(Ar, Data.ConditionPercentage);
+	SerializeBool(Ar, Data.SkipOnConditionFail);
+	SerializeBool(Ar, Data.BooleanOne);
+	SerializeBool(Ar, Data.BooleanTwo);
+	SerializeBool(Ar, Data.BooleanThree);
+}
+
+void UFlareSaveBinary::SerializeCargo(FArchive& Ar, FFlareCargoSave& Data)
+{
+	SerializeName(Ar, Data.ResourceIdentifier);
+	Ar << Data.Quantity;
+	SerializeEnum(Ar, Data.Lock, TEXT("EFlareResourceLock"));
+	SerializeEnum(Ar, Data.Restriction, TEXT("EFlareResourceRestriction"));
+}
+
+void UFlareSaveBinary::SerializeFactory(FArchive& Ar, FFlareFactorySave& Data)
+{
+	SerializeBool(Ar, Data.Active);
+	Ar << Data.CostReserved;
+	Ar << Data.ProductedDuration;
+	SerializeBool(Ar, Data.InfiniteCycle);
+	Ar << Data.CycleCount;
+	SerializeName(Ar, Data.TargetShipClass);
+	SerializeName(Ar, Data.TargetShipCompany);
+	SerializeFloat(Ar, Data.FactoryEfficiency);
+
+	SerializeArray(Ar, Data.ResourceReserved, &UFlareSaveBinary::SerializeCargo);
+	SerializeArray(Ar, Data.OutputCargoLimit, &UFlareSaveBinary::SerializeCargo);
+}
+
+void UFlareSaveBinary::SerializeShipyardOrder(FArchive& Ar, FFlareShipyardOrderSave& Data)
+{
+	SerializeName(Ar, Data.Company);
+	SerializeName(Ar, Data.ShipClass);
+	Ar << Data.AdvancePayment;
+}
+
+void UFlareSaveBinary::SerializeFleet(FArchive& Ar, FFlareFleetSave& Data)
+{
+	SerializeText(Ar, Data.Name);
+	SerializeName(Ar, Data.Identifier);
+	SerializeName(Ar, Data.DefaultWhiteListIdentifier);
+	SerializeNameArray(Ar, Data.ShipImmatriculations);
+	SerializeColor(Ar, Data.FleetColor);
+	SerializeBool(Ar, Data.AutoTrade);
+	SerializeBool(Ar, Data.HideTravelList);
+
+	Ar << Data.AutoTradeStatsDays;
+	Ar << Data.AutoTradeStatsLoadResources;
+	Ar << Data.AutoTradeStatsUnloadResources;
+	Ar << Data.AutoTradeStatsMoneySell;
+	Ar << Data.AutoTradeStatsMoneyBuy;
+}
+
+void UFlareSaveBinary::SerializeWhiteList(FArchive& Ar, FFlareWhiteListSave& Data)
+{
+	SerializeText(Ar, Data.Name);
+	SerializeName(Ar, Data.Identifier);
+	SerializeArray(Ar, Data.CompanyData, &UFlareSaveBinary::SerializeWhiteListCompanyData);
+}
+
+void UFlareSaveBinary::SerializeWhiteListCompanyData(FArchive& Ar, FFlareWhiteListCompanyDataSave& Data)
+{
+	SerializeName(Ar, Data.Identifier);
+	SerializeBool(Ar, Data.CanTradeTo);
+	SerializeBool(Ar, Data.CanTradeFrom);
+	SerializeNameArray(Ar, Data.ResourcesTradeFrom);
+	SerializeNameArray(Ar, Data.ResourcesTradeTo);
+}
+
+void UFlareSaveBinary::SerializeTradeRoute(FArchive& Ar, FFlareTradeRouteSave& Data)
+{
+	SerializeText(Ar, Data.Name);
+	SerializeName(Ar, Data.Identifier);
+	SerializeName(Ar, Data.FleetIdentifier);
+	SerializeName(Ar, Data.TargetSectorIdentifier);
+	Ar << Data.CurrentOperationIndex;
+	Ar << Data.CurrentOperationProgress;
+	Ar << Data.CurrentOperationDuration;
+	SerializeBool(Ar, Data.IsPaused);
+
+	// Stats
+	Ar << Data.StatsDays;
+	Ar << Data.StatsLoadResources;
+	Ar << Data.StatsUnloadResources;
+	Ar << Data.StatsMoneySell;
+	Ar << Data.StatsMoneyBuy;
+	Ar << Data.StatsOperationSuccessCount;
+	Ar << Data.StatsOperationFailCount;
+
+	SerializeArray(Ar, Data.Sectors, &UFlareSaveBinary::SerializeTradeRouteSector);
+}
+
+void UFlareSaveBinary::SerializeTradeRouteSector(FArchive& Ar, FFlareTradeRouteSectorSave& Data)
+{
+	SerializeName(Ar, Data.SectorIdentifier);
+	SerializeArray(Ar, Data.Operations, &UFlareSaveBinary::SerializeTradeOperation);
+}
+
+void UFlareSaveBinary::SerializeSectorKnowledge(FArchive& Ar, FFlareCompanySectorKnowledge& Data)
+{
+	SerializeName(Ar, Data.SectorIdentifier);
+	SerializeEnum(Ar, Data.Knowledge, TEXT("EFlareSectorKnowledge"));
+}
+
+void UFlareSaveBinary::SerializeTransactionLogEntry(FArchive& Ar, FFlareTransactionLogEntry& Data)
+{
+	Ar << Data.Date;
+	Ar << Data.Amount;
+	SerializeEnum(Ar, Data.Type, TEXT("EFlareTransactionLogEntry"));
+	SerializeName(Ar, Data.Spacecraft);
+	SerializeName(Ar, Data.Sector);
+	SerializeName(Ar, Data.OtherCompany);
+	SerializeName(Ar, Data.OtherSpacecraft);
+	SerializeName(Ar, Data.Resource);
+	Ar << Data.ResourceQuantity;
+	SerializeName(Ar, Data.ExtraIdentifier1);
+	SerializeName(Ar, Data.ExtraIdentifier2);
+}
+
+void UFlareSaveBinary::SerializeCompanyAI(FArchive& Ar, FFlareCompanyAISave& Data)
+{
+	Ar << Data.BudgetMilitary;
+	Ar << Data.BudgetStation;
+	Ar << Data.BudgetTechnology;
+	Ar << Data.BudgetTrade;
+	Ar << Data.DateCalculatedDefaultBudget;
+	Ar << Data.DateBoughtLicense;
+	SerializeFloat(Ar, Data.Caution);
+	SerializeFloat(Ar, Data.Pacifism);
+	SerializeName(Ar, Data.ResearchProject);
+	SerializeName(Ar, Data.DesiredStationLicense);
+}
+
+void UFlareSaveBinary::SerializeCompanyLicenses(FArchive& Ar, FFlareCompanyLicensesSave& Data)
+{
+	SerializeNameArray(Ar, Data.LicenseBuilding);
+	SerializeBool(Ar, Data.HasRecievedStartingLicenses);
+}
+
+void UFlareSaveBinary::SerializeCompanyReputation(FArchive& Ar, FFlareCompanyReputationSave& Data)
+{
+	SerializeName(Ar, Data.CompanyIdentifier);
+	SerializeFloat(Ar, Data.Reputation);
+}
+
+void UFlareSaveBinary::SerializeSector(FArchive& Ar, FFlareSectorSave& Data)
+{
+	SerializeText(Ar, Data.GivenName);
+	SerializeName(Ar, Data.Identifier);
+	Ar << Data.LocalTime;
+	SerializePeople(Ar, Data.PeopleData);
+
+	SerializeArray(Ar, Data.BombData, &UFlareSaveBinary::SerializeBomb);
+	SerializeArray(Ar, Data.AsteroidData, &UFlareSaveBinary::SerializeAsteroid);
+	SerializeArray(Ar, Data.MeteoriteData, &UFlareSaveBinary::SerializeMeteorite);
+	SerializeNameArray(Ar, Data.FleetIdentifiers);
+	SerializeNameArray(Ar, Data.SpacecraftIdentifiers);
+	SerializeArray(Ar, Data.ResourcePrices, &UFlareSaveBinary::SerializeResourcePrice);
+
+	SerializeBool(Ar, Data.IsTravelSector);
+
+	SerializeFloatBuffer(Ar, Data.FleetSupplyConsumptionStats);
+	Ar << Data.DailyFleetSupplyConsumption;
+}
+
+void UFlareSaveBinary::SerializePeople(FArchive& Ar, FFlarePeopleSave& Data)
+{
+	Ar << Data.Population;
+	Ar << Data.FoodStock;
+	Ar << Data.FuelStock;
+	Ar << Data.ToolStock;
+	Ar << Data.TechStock;
+	SerializeFloat(Ar, Data.FoodConsumption);
+	SerializeFloat(Ar, Data.FuelConsumption);
+	SerializeFloat(Ar, Data.ToolConsumption);
+	SerializeFloat(Ar, Data.TechConsumption);
+	Ar << Data.Money;
+	Ar << Data.Dept;
+	Ar << Data.BirthPoint;
+	Ar << Data.DeathPoint;
+	Ar << Data.HungerPoint;
+	Ar << Data.HappinessPoint;
+
+	SerializeArray(Ar, Data.CompanyReputations, &UFlareSaveBinary::SerializeCompanyReputation);
+}
+
+void UFlareSaveBinary::SerializeBomb(FArchive& Ar, FFlareBombSave& Data)
+{
+	SerializeName(Ar, Data.Identifier);
+	SerializeVector(Ar, Data.Location);
+	SerializeRotator(Ar, Data.Rotation);
+	SerializeVector(Ar, Data.LinearVelocity);
+	SerializeVector(Ar, Data.AngularVelocity);
+	SerializeName(Ar, Data.WeaponSlotIdentifier);
+	SerializeName(Ar, Data.AimTargetSpacecraft);
+	SerializeName(Ar, Data.ParentSpacecraft);
+	SerializeName(Ar, Data.AttachTarget);
+	SerializeBool(Ar, Data.Activated);
+	SerializeBool(Ar, Data.Dropped);
+	SerializeBool(Ar, Data.Locked);
+	SerializeFloat(Ar, Data.DropParentDistance);
+	SerializeFloat(Ar, Data.LifeTime);
+	SerializeFloat(Ar, Data.BurnDuration);
+}
+
+void UFlareSaveBinary::SerializeResourcePrice(FArchive& Ar, FFFlareResourcePrice& Data)
+{
+	SerializeName(Ar, Data.ResourceIdentifier);
+	SerializeFloat(Ar, Data.Price);
+	SerializeFloatBuffer(Ar, Data.Prices);
+}
+
+void UFlareSaveBinary::SerializeFloatBuffer(FArchive& Ar, FFlareFloatBuffer& Data)
+{
+	Ar << Data.MaxSize;
+	Ar << Data.WriteIndex;
+
+	int32 Count = SerializeCount(Ar, Data.Values.Num());
+	if (Ar.IsLoading())
+	{
+		Data.Values.SetNumUninitialized(Count);
+	}
+
+	for (float& Value : Data.Values)
+	{
+		SerializeFloat(Ar, Value);
+	}
+}
+
+void UFlareSaveBinary::SerializeBundle(FArchive& Ar, FFlareBundle& Data)
+{
+	// Keys are written first, then the values
+	auto SerializeMap = [&](auto& Map, auto SerializeValue)
+	{
+		int32 Count = SerializeCount(Ar, Map.Num());
+		if (Ar.IsSaving())
+		{
+			for (auto& Pair : Map)
+			{
+				SerializeName(Ar, Pair.Key);
+				SerializeValue(Pair.Value);
+			}
+		}
+		else
+		{
+			Map.Empty(Count);
+			for (int32 i = 0; i < Count; i++)
+			{
+				FName Key;
+				SerializeName(Ar, Key);
+				SerializeValue(Map.Add(Key));
+			}
+		}
+	};
+
+	SerializeMap(Data.FloatValues, [&](float& Value) { SerializeFloat(Ar, Value); });
+	SerializeMap(Data.Int32Values, [&](int32& Value) { Ar << Value; });
+	SerializeMap(Data.TransformValues, [&](FTransform& Value) { SerializeTransform(Ar, Value); });
+	SerializeMap(Data.VectorArrayValues, [&](FVectorArray& Value)
+	{
+		int32 Count = SerializeCount(Ar, Value.Entries.Num());
+		if (Ar.IsLoading())
+		{
+			Value.Entries.SetNum(Count);
+		}
+
+		for (FVector& Vector : Value.Entries)
+		{
+			SerializeVector(Ar, Vector);
+		}
+	});
+	SerializeMap(Data.NameValues, [&](FName& Value) { SerializeName(Ar, Value); });
+	SerializeMap(Data.NameArrayValues, [&](FNameArray& Value) { SerializeNameArray(Ar, Value.Entries); });
+	SerializeMap(Data.StringValues, [&](FString& Value) { Ar << Value; });
+	SerializeNameArray(Ar, Data.Tags);
+}
+
+void UFlareSaveBinary::SerializeTravel(FArchive& Ar, FFlareTravelSave& Data)
+{
+	SerializeName(Ar, Data.FleetIdentifier);
+	SerializeName(Ar, Data.OriginSectorIdentifier);
+	SerializeName(Ar, Data.DestinationSectorIdentifier);
+	Ar << Data.DepartureDate;
+
+	SerializeSector(Ar, Data.SectorData);
+}
+
+
+/*----------------------------------------------------
+	Low-level types
+----------------------------------------------------*/
+
+void UFlareSaveBinary::SerializeName(FArchive& Ar, FName& Data)
+{
+	// Names are written as a 1-based table index, 0 introducing a new name
+	if (Ar.IsSaving())
+	{
+		int32* Index = NameIndices.Find(Data);
+		uint32 PackedIndex = Index ? *Index + 1 : 0;
+		Ar.SerializeIntPacked(PackedIndex);
+
+		if (!Index)
+		{
+			FString NameString = Data.ToString();
+			Ar << NameString;
+			NameIndices.Add(Data, NameIndices.Num());
+		}
+	}
+	else
+	{
+		uint32 PackedIndex = 0;
+		Ar.SerializeIntPacked(PackedIndex);
+
+		if (PackedIndex == 0)
+		{
+			FString NameString;
+			Ar << NameString;
+			Data = FName(*NameString);
+			Names.Add(Data);
+		}
+		else if (PackedIndex <= (uint32) Names.Num())
+		{
+			Data = Names[PackedIndex - 1];
+		}
+		else
+		{
+			Data = NAME_None;
+			Ar.SetError();
+		}
+	}
+}
+
+void UFlareSaveBinary::SerializeText(FArchive& Ar, FText& Data)
+{
+	FString TextString;
+	if (Ar.IsSaving())
+	{
+		TextString = Data.ToString();
+	}
+
+	Ar << TextString;
+
+	if (Ar.IsLoading())
+	{
+		Data = FText::FromString(TextString);
+	}
+}
+
+void UFlareSaveBinary::SerializeBool(FArchive& Ar, bool& Data)
+{
+	uint8 Value = Data ? 1 : 0;
+	Ar << Value;
+	Data = (Value != 0);
+}
+
+void UFlareSaveBinary::SerializeFloat(FArchive& Ar, float& Data)
+{
+	if (Ar.IsSaving())
+	{
+		float Value = UFlareSaveWriter::FixFloat(Data);
+		Ar << Value;
+	}
+	else
+	{
+		Ar << Data;
+	}
+}
+
+void UFlareSaveBinary::SerializeVector(FArchive& Ar, FVector& Data)
+{
+	SerializeFloat(Ar, Data.X);
+	SerializeFloat(Ar, Data.Y);
+	SerializeFloat(Ar, Data.Z);
+}
+
+void UFlareSaveBinary::SerializeRotator(FArchive& Ar, FRotator& Data)
+{
+	SerializeFloat(Ar, Data.Pitch);
+	SerializeFloat(Ar, Data.Yaw);
+	SerializeFloat(Ar, Data.Roll);
+}
+
+void UFlareSaveBinary::SerializeColor(FArchive& Ar, FLinearColor& Data)
+{
+	// Like the JSON format, colors are opaque
+	SerializeFloat(Ar, Data.R);
+	SerializeFloat(Ar, Data.G);
+	SerializeFloat(Ar, Data.B);
+
+	if (Ar.IsLoading())
+	{
+		Data.A = 1.f;
+	}
+}
+
+void UFlareSaveBinary::SerializeTransform(FArchive& Ar, FTransform& Data)
+{
+	FQuat Rotation = Data.GetRotation();
+	FVector Translation = Data.GetTranslation();
+	FVector Scale = Data.GetScale3D();
+
+	SerializeFloat(Ar, Rotation.X);
+	SerializeFloat(Ar, Rotation.Y);
+	SerializeFloat(Ar, Rotation.Z);
+	SerializeFloat(Ar, Rotation.W);
+	SerializeVector(Ar, Translation);
+	SerializeVector(Ar, Scale);
+
+	if (Ar.IsLoading())
+	{
+		Data = FTransform(Rotation, Translation, Scale);
+	}
+}
+
+void UFlareSaveBinary::SerializeNameArray(FArchive& Ar, TArray<FName>& Data)
+{
+	int32 Count = SerializeCount(Ar, Data.Num());
+	if (Ar.IsLoading())
+	{
+		Data.Empty(Count);
+		Data.SetNum(Count);
+	}
+
+	for (FName& Name : Data)
+	{
+		SerializeName(Ar, Name);
+	}
+}
+
+int32 UFlareSaveBinary::SerializeCount(FArchive& Ar, int32 Count)
+{
+	uint32 PackedCount = Count;
+	Ar.SerializeIntPacked(PackedCount);
+
+	// Every element takes at least a byte
+	if (Ar.IsLoading() && (Ar.IsError() || (int64) PackedCount > Ar.TotalSize() - Ar.Tell()))
+	{
+		Ar.SetError();
+		return 0;
+	}
+
+	return PackedCount;
+}
+
+UEnum* UFlareSaveBinary::GetEnum(const TCHAR* EnumName)
+{
+	FName Key(EnumName);
+	UEnum** CachedEnum = EnumCache.Find(Key);
+	if (CachedEnum)
+	{
+		return *CachedEnum;
+	}
+
+	UEnum* Enum = FindObject<UEnum>(ANY_PACKAGE, EnumName, true);
+	EnumCache.Add(Key, Enum);
+	return Enum;
+}
+
+
+/*----------------------------------------------------
+	Getters
+----------------------------------------------------*/
+
+int32 UFlareSaveBinary::ReadFile(const FString& FileName, TArray<uint8>& Payload)
+{
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *FileName, FILEREAD_Silent))
+	{
+		return INDEX_NONE;
+	}
+
+	FMemoryReader FileReader(FileData);
+
+	uint32 Magic = 0;
+	uint32 FileVersion = 0;
+	FileReader << Magic;
+	FileReader << FileVersion;
+
+	if (FileReader.IsError() || Magic != FLARE_SAVE_BINARY_MAGIC)
+	{
+		FLOGV("WARNING: '%s' is not a binary save. Save corrupted", *FileName);
+		return INDEX_NONE;
+	}
+
+	Payload.Empty();
+	TArray<uint8> CompressedChunk;
+	while (true)
+	{
+		int32 UncompressedSize = 0;
+		FileReader << UncompressedSize;
+		if (UncompressedSize == 0)
+		{
+			break;
+		}
+
+		int32 CompressedSize = 0;
+		FileReader << CompressedSize;
+		if (FileReader.IsError() || UncompressedSize < 0 || UncompressedSize > FLARE_SAVE_BINARY_CHUNK_SIZE
+			|| CompressedSize <= 0 || CompressedSize > FileReader.TotalSize() - FileReader.Tell())
+		{
+			FLOGV("WARNING: Fail to read binary save '%s'. Save corrupted", *FileName);
+			return INDEX_NONE;
+		}
+
+		CompressedChunk.SetNumUninitialized(CompressedSize, false);
+		FileReader.Serialize(CompressedChunk.GetData(), CompressedSize);
+
+		int32 Offset = Payload.Num();
+		Payload.AddUninitialized(UncompressedSize);
+		if (!FCompression::UncompressMemory(COMPRESS_ZLIB, Payload.GetData() + Offset, UncompressedSize, CompressedChunk.GetData(), CompressedSize))
+		{
+			FLOGV("Fail to uncompress save '%s' with compressed size %d and uncompressed size %d", *FileName, CompressedSize, UncompressedSize);
+			return INDEX_NONE;
+		}
+	}
+
+	if (FileReader.IsError())
+	{
+		FLOGV("WARNING: Fail to read binary save '%s'. Save corrupted", *FileName);
+		return INDEX_NONE;
+	}
+
+	return FileVersion;
+}
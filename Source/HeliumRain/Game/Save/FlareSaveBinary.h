@@ -0,0 +1,286 @@
+#pragma once
+
+#include "Object.h"
+#include "../FlareSaveGame.h"
+#include "FlareSaveBinary.generated.h"
+
+
+/** Binary save file identifier, "HRSV" */
+#define FLARE_SAVE_BINARY_MAGIC 0x56535248
+
+/** Current binary save format, bump when the serialized layout changes */
+#define FLARE_SAVE_BINARY_VERSION 1
+
+/** Size of the uncompressed blocks the binary save is split into */
+#define FLARE_SAVE_BINARY_CHUNK_SIZE (1024 * 1024)
+
+
+struct FFlarePlayerSave;
+struct FFlareQuestSave;
+struct FFlareQuestProgressSave;
+struct FFlareGeneratedQuestSave;
+struct FFlareQuestConditionSave;
+
+struct FFlareCompanyDescription;
+struct FFlareWorldSave;
+
+struct FFlareCompanySave;
+
+struct FFlareSpacecraftSave;
+struct FFlareShipPilotSave;
+struct FFlareAsteroidSave;
+struct FFlareSpacecraftComponentSave;
+struct FFlareTurretPilotSave;
+
+struct FFlareCargoSave;
+struct FFlareFactorySave;
+
+struct FFlareFleetSave;
+struct FFlareTradeRouteSave;
+struct FFlareTradeRouteSectorSave;
+struct FFlareTradeRouteSectorOperationSave;
+struct FFlareCompanySectorKnowledge;
+struct FFlareCompanyAISave;
+struct FFlareCompanyLicensesSave;
+struct FFlareCompanyReputationSave;
+
+struct FFlareSectorSave;
+struct FFlarePeopleSave;
+struct FFlareBombSave;
+struct FFFlareResourcePrice;
+struct FFlareTravelSave;
+struct FFlareFloatBuffer;
+
+
+/** Archive writing a binary save file, compressing one block at a time as data comes in */
+class FFlareSaveBinaryWriter : public FArchive
+{
+public:
+
+	FFlareSaveBinaryWriter(const FString& FileName);
+
+	virtual ~FFlareSaveBinaryWriter();
+
+	virtual void Serialize(void* Data, int64 Length) override;
+
+	/** Write the last block and move the file in place, false if anything failed */
+	virtual bool Close() override;
+
+	virtual int64 Tell() override
+	{
+		return Position;
+	}
+
+	virtual int64 TotalSize() override
+	{
+		return Position;
+	}
+
+	virtual FString GetArchiveName() const override
+	{
+		return TEXT("FFlareSaveBinaryWriter");
+	}
+
+protected:
+
+	/** Compress the current block to the file */
+	void FlushChunk();
+
+	FArchive*                                FileWriter;
+
+	TArray<uint8>                            Chunk;
+
+	TArray<uint8>                            CompressedChunk;
+
+	FString                                  TargetFileName;
+
+	FString                                  TempFileName;
+
+	int64                                    Position;
+};
+
+
+/** Binary save format, serialized straight from the save structures.
+ *  The file is a magic and version header followed by zlib compressed blocks.
+ *  Names are written once and then referenced by index. */
+UCLASS()
+class HELIUMRAIN_API UFlareSaveBinary: public UObject
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	/*----------------------------------------------------
+		Interface
+	----------------------------------------------------*/
+
+	/** Write a save to a binary file */
+	bool SaveGame(const FString& FileName, UFlareSaveGame* Data);
+
+	/** Read a save from a binary file, NULL if the file is missing or invalid */
+	UFlareSaveGame* LoadGame(const FString& FileName);
+
+	/** Serialize a whole save, in either direction */
+	void SerializeGame(FArchive& Ar, UFlareSaveGame* Data);
+
+
+protected:
+
+	/*----------------------------------------------------
+		Structures
+	----------------------------------------------------*/
+
+	void SerializePlayer(FArchive& Ar, FFlarePlayerSave& Data);
+	void SerializeQuest(FArchive& Ar, FFlareQuestSave& Data);
+	void SerializeQuestProgress(FArchive& Ar, FFlareQuestProgressSave& Data);
+	void SerializeGeneratedQuest(FArchive& Ar, FFlareGeneratedQuestSave& Data);
+	void SerializeQuestStepProgress(FArchive& Ar, FFlareQuestConditionSave& Data);
+
+	void SerializeCompanyDescription(FArchive& Ar, FFlareCompanyDescription& Data);
+	void SerializeWorld(FArchive& Ar, FFlareWorldSave& Data);
+
+	void SerializeWorldEvents(FArchive& Ar, FFlareWorldGameEventSave& Data);
+	void SerializeCompany(FArchive& Ar, FFlareCompanySave& Data);
+
+	void SerializeSpacecraft(FArchive& Ar, FFlareSpacecraftSave& Data);
+	void SerializePilot(FArchive& Ar, FFlareShipPilotSave& Data);
+	void SerializeAsteroid(FArchive& Ar, FFlareAsteroidSave& Data);
+	void SerializeMeteorite(FArchive& Ar, FFlareMeteoriteSave& Data);
+	void SerializeSpacecraftComponent(FArchive& Ar, FFlareSpacecraftComponentSave& Data);
+	void SerializeTurretPilot(FArchive& Ar, FFlareTurretPilotSave& Data);
+	void SerializeStationConnection(FArchive& Ar, FFlareConnectionSave& Data);
+
+	void SerializeTradeOperation(FArchive& Ar, FFlareTradeRouteSectorOperationSave& Data);
+	void SerializeOperationCondition(FArchive& Ar, FFlareTradeRouteOperationConditionSave& Data);
+	void SerializeCargo(FArchive& Ar, FFlareCargoSave& Data);
+	void SerializeFactory(FArchive& Ar, FFlareFactorySave& Data);
+	void SerializeShipyardOrder(FArchive& Ar, FFlareShipyardOrderSave& Data);
+
+	void SerializeFleet(FArchive& Ar, FFlareFleetSave& Data);
+	void SerializeWhiteList(FArchive& Ar, FFlareWhiteListSave& Data);
+	void SerializeWhiteListCompanyData(FArchive& Ar, FFlareWhiteListCompanyDataSave& Data);
+	void SerializeTradeRoute(FArchive& Ar, FFlareTradeRouteSave& Data);
+	void SerializeTradeRouteSector(FArchive& Ar, FFlareTradeRouteSectorSave& Data);
+	void SerializeSectorKnowledge(FArchive& Ar, FFlareCompanySectorKnowledge& Data);
+	void SerializeTransactionLogEntry(FArchive& Ar, FFlareTransactionLogEntry& Data);
+	void SerializeCompanyAI(FArchive& Ar, FFlareCompanyAISave& Data);
+	void SerializeCompanyLicenses(FArchive& Ar, FFlareCompanyLicensesSave& Data);
+	void SerializeCompanyReputation(FArchive& Ar, FFlareCompanyReputationSave& Data);
+
+	void SerializeSector(FArchive& Ar, FFlareSectorSave& Data);
+	void SerializePeople(FArchive& Ar, FFlarePeopleSave& Data);
+	void SerializeBomb(FArchive& Ar, FFlareBombSave& Data);
+	void SerializeResourcePrice(FArchive& Ar, FFFlareResourcePrice& Data);
+	void SerializeFloatBuffer(FArchive& Ar, FFlareFloatBuffer& Data);
+	void SerializeBundle(FArchive& Ar, FFlareBundle& Data);
+
+	void SerializeTravel(FArchive& Ar, FFlareTravelSave& Data);
+
+
+	/*----------------------------------------------------
+		Low-level types
+	----------------------------------------------------*/
+
+	void SerializeName(FArchive& Ar, FName& Data);
+	void SerializeText(FArchive& Ar, FText& Data);
+	void SerializeBool(FArchive& Ar, bool& Data);
+	void SerializeFloat(FArchive& Ar, float& Data);
+	void SerializeVector(FArchive& Ar, FVector& Data);
+	void SerializeRotator(FArchive& Ar, FRotator& Data);
+	void SerializeColor(FArchive& Ar, FLinearColor& Data);
+	void SerializeTransform(FArchive& Ar, FTransform& Data);
+	void SerializeNameArray(FArchive& Ar, TArray<FName>& Data);
+
+	/** Read or write an element count, flagging the archive as corrupted on an impossible count */
+	int32 SerializeCount(FArchive& Ar, int32 Count);
+
+	UEnum* GetEnum(const TCHAR* EnumName);
+
+	template<typename TStruct>
+	void SerializeArray(FArchive& Ar, TArray<TStruct>& Data, void (UFlareSaveBinary::*SerializeElement)(FArchive&, TStruct&))
+	{
+		int32 Count = SerializeCount(Ar, Data.Num());
+		if (Ar.IsLoading())
+		{
+			Data.Empty(Count);
+			Data.SetNum(Count);
+		}
+
+		for (TStruct& Element : Data)
+		{
+			(this->*SerializeElement)(Ar, Element);
+		}
+	}
+
+	template<typename TEnum>
+	void SerializeEnum(FArchive& Ar, TEnum& Data, const TCHAR* EnumName)
+	{
+		UEnum* Enum = GetEnum(EnumName);
+		FName EntryName;
+
+		if (Ar.IsSaving())
+		{
+			if (Enum && (int32)Data >= 0 && (int32)Data < Enum->NumEnums())
+			{
+				EntryName = FName(*Enum->GetNameStringByIndex((int32)Data));
+			}
+			else
+			{
+				FLOGV("UFlareSaveBinary::SerializeEnum : invalid value %d for '%s'", (int32)Data, EnumName);
+				Ar.SetError();
+			}
+		}
+
+		SerializeName(Ar, EntryName);
+
+		if (Ar.IsLoading())
+		{
+			int32 Index = Enum ? Enum->GetIndexByName(EntryName) : INDEX_NONE;
+			if (Index == INDEX_NONE)
+			{
+				FLOGV("UFlareSaveBinary::SerializeEnum : unknown entry '%s' for '%s'", *EntryName.ToString(), EnumName);
+				Ar.SetError();
+			}
+			else
+			{
+				Data = (TEnum) Index;
+			}
+		}
+	}
+
+	template<typename TEnum>
+	void SerializeEnum(FArchive& Ar, TEnumAsByte<TEnum>& Data, const TCHAR* EnumName)
+	{
+		TEnum Value = Data.GetValue();
+		SerializeEnum(Ar, Value, EnumName);
+		Data = Value;
+	}
+
+
+	/*----------------------------------------------------
+		Protected data
+	----------------------------------------------------*/
+
+	/** Format version of the archive being read or written */
+	int32                                    Version;
+
+	/** Names already written, by index */
+	TMap<FName, int32>                       NameIndices;
+
+	/** Names already read, by index */
+	TArray<FName>                            Names;
+
+	/** Enums looked up by name */
+	TMap<FName, UEnum*>                      EnumCache;
+
+
+public:
+
+	/*----------------------------------------------------
+		Getters
+	----------------------------------------------------*/
+
+	/** Read a binary save file and uncompress it, returns the format version or INDEX_NONE */
+	static int32 ReadFile(const FString& FileName, TArray<uint8>& Payload);
+
+};
@@ -4,6 +4,9 @@
 
 #include "FlareSaveWriter.h"
 #include "FlareSaveReaderV1.h"
+#include "FlareSaveBinary.h"
+#include "FlareSaveStream.h"
+#include "../FlareGameTools.h"
 #include "../FlareGame.h"
 
 
@@ -23,7 +26,9 @@ UFlareSaveGameSystem::UFlareSaveGameSystem(const FObjectInitializer& ObjectIniti
 
 bool UFlareSaveGameSystem::DoesSaveGameExist(const FString SaveName)
 {
-	return IFileManager::Get().FileSize(*GetSaveGamePath(SaveName, true)) >= 0 || IFileManager::Get().FileSize(*GetSaveGamePath(SaveName, false)) >= 0;
+	return IFileManager::Get().FileSize(*GetBinarySaveGamePath(SaveName)) >= 0
+		|| IFileManager::Get().FileSize(*GetSaveGamePath(SaveName, true)) >= 0
+		|| IFileManager::Get().FileSize(*GetSaveGamePath(SaveName, false)) >= 0;
 }
 
 bool UFlareSaveGameSystem::SaveGame(const FString SaveName, UFlareSaveGame* SaveData)
@@ -32,7 +37,115 @@ bool UFlareSaveGameSystem::SaveGame(const FString SaveName, UFlareSaveGame* Save
 	SaveLock.Lock();
 	FLOGV("UFlareSaveGameSystem::SaveGame SaveName=%s", *SaveName);
 
+	// The other format is left untouched, loading picks the most recent file
+	if (UFlareGameTools::BinarySaves)
+	{
+		ret = WriteBinarySave(SaveName, SaveData);
+	}
+	else
+	{
+		ret = WriteJsonSave(SaveName, SaveData);
+	}
+
+	SaveLock.Unlock();
+
+	SaveListLock.Lock();
+	SaveList.Remove(SaveData);
+	SaveListLock.Unlock();
+
+	return ret;
+}
+
+UFlareSaveGame* UFlareSaveGameSystem::LoadGame(const FString SaveName, AFlareGame* Game)
+{
+	FLOGV("UFlareSaveGameSystem::LoadGame SaveName=%s", *SaveName);
+
+	// Both formats may exist, read the most recent first
+	FDateTime BinaryTime = IFileManager::Get().GetTimeStamp(*GetBinarySaveGamePath(SaveName));
+	FDateTime JsonTime = FMath::Max(IFileManager::Get().GetTimeStamp(*GetSaveGamePath(SaveName, true)),
+		IFileManager::Get().GetTimeStamp(*GetSaveGamePath(SaveName, false)));
+	bool BinaryFirst = BinaryTime > JsonTime;
+
+	UFlareSaveGame* SaveGame = BinaryFirst ? ReadBinarySave(SaveName) : ReadJsonSave(SaveName, Game);
+
+	if (!SaveGame)
+	{
+		SaveGame = BinaryFirst ? ReadJsonSave(SaveName, Game) : ReadBinarySave(SaveName);
+	}
+
+	return SaveGame;
+}
+
+bool UFlareSaveGameSystem::DeleteGame(const FString SaveName)
+{
+	bool Result = IFileManager::Get().Delete(*GetSaveGamePath(SaveName, false), true) | IFileManager::Get().Delete(*GetSaveGamePath(SaveName, true), true);
+	Result |= IFileManager::Get().Delete(*GetBinarySaveGamePath(SaveName), true);
+	return Result;
+}
+
+bool UFlareSaveGameSystem::ConvertGame(const FString SaveName, bool ToBinary)
+{
+	bool ret = false;
+	SaveLock.Lock();
+	FLOGV("UFlareSaveGameSystem::ConvertGame SaveName=%s ToBinary=%d", *SaveName, ToBinary);
+
+	UFlareSaveGame* SaveData = ToBinary ? ReadJsonSave(SaveName, NULL) : ReadBinarySave(SaveName);
+
+	if (SaveData == NULL)
+	{
+		FLOGV("UFlareSaveGameSystem::ConvertGame : no save to convert for '%s'", *SaveName);
+	}
+	else if (ToBinary)
+	{
+		ret = WriteBinarySave(SaveName, SaveData);
+	}
+	else
+	{
+		ret = WriteJsonSave(SaveName, SaveData);
+	}
+
+	SaveLock.Unlock();
+	return ret;
+}
+
+
+/*----------------------------------------------------
+	Formats
+----------------------------------------------------*/
+
+bool UFlareSaveGameSystem::WriteJsonSave(const FString SaveName, UFlareSaveGame* SaveData)
+{
+	bool ret = false;
+
 	UFlareSaveWriter* SaveWriter = NewObject<UFlareSaveWriter>(this, UFlareSaveWriter::StaticClass());
+
+	// Stream the save to disk one entity at a time
+	if (UFlareGameTools::StreamingSaves)
+	{
+		FFlareSaveStream Stream;
+		ret = Stream.Open(GetSaveGamePath(SaveName, true)) && SaveWriter->SaveGame(SaveData, Stream);
+
+		if (ret)
+		{
+			ret = Stream.Close();
+		}
+		else
+		{
+			Stream.Abort();
+		}
+
+		if (ret)
+		{
+			FLOG("UFlareSaveGameSystem::SaveGame : Save done");
+		}
+		else
+		{
+			FLOGV("Fail to stream save %s", *SaveName);
+		}
+
+		return ret;
+	}
+
 	TSharedRef<FJsonObject> JsonObject = SaveWriter->SaveGame(SaveData);
 
 	// Save the json object
@@ -72,19 +185,28 @@ bool UFlareSaveGameSystem::SaveGame(const FString SaveName, UFlareSaveGame* Save
 		ret = false;
 	}
 
-	SaveLock.Unlock();
+	return ret;
+}
 
-	SaveListLock.Lock();
-	SaveList.Remove(SaveData);
-	SaveListLock.Unlock();
+bool UFlareSaveGameSystem::WriteBinarySave(const FString SaveName, UFlareSaveGame* SaveData)
+{
+	UFlareSaveBinary* SaveBinary = NewObject<UFlareSaveBinary>(this, UFlareSaveBinary::StaticClass());
+	bool ret = SaveBinary->SaveGame(GetBinarySaveGamePath(SaveName), SaveData);
+
+	if (ret)
+	{
+		FLOG("UFlareSaveGameSystem::WriteBinarySave : Save done");
+	}
+	else
+	{
+		FLOGV("Fail to write binary save %s", *SaveName);
+	}
 
 	return ret;
 }
 
-UFlareSaveGame* UFlareSaveGameSystem::LoadGame(const FString SaveName, AFlareGame* Game)
+UFlareSaveGame* UFlareSaveGameSystem::ReadJsonSave(const FString SaveName, AFlareGame* Game)
 {
-	FLOGV("UFlareSaveGameSystem::LoadGame SaveName=%s", *SaveName);
-
 	UFlareSaveGame *SaveGame = NULL;
 
 	// Read the saveto a string
@@ -158,13 +280,24 @@ UFlareSaveGame* UFlareSaveGameSystem::LoadGame(const FString SaveName, AFlareGam
 	return SaveGame;
 }
 
-bool UFlareSaveGameSystem::DeleteGame(const FString SaveName)
+UFlareSaveGame* UFlareSaveGameSystem::ReadBinarySave(const FString SaveName)
 {
-	bool Result = IFileManager::Get().Delete(*GetSaveGamePath(SaveName, false), true) | IFileManager::Get().Delete(*GetSaveGamePath(SaveName, true), true);
-	return Result;
+	UFlareSaveBinary* SaveBinary = NewObject<UFlareSaveBinary>(this, UFlareSaveBinary::StaticClass());
+	UFlareSaveGame* SaveGame = SaveBinary->LoadGame(GetBinarySaveGamePath(SaveName));
+
+	if (SaveGame)
+	{
+		FLOGV("Save '%s' read", *GetBinarySaveGamePath(SaveName));
+	}
+
+	return SaveGame;
 }
 
 
+/*----------------------------------------------------
+	Save list
+----------------------------------------------------*/
+
 void UFlareSaveGameSystem::PushSaveData(UFlareSaveGame* SaveData)
 {
 	SaveListLock.Lock();
@@ -189,3 +322,8 @@ FString UFlareSaveGameSystem::GetSaveGamePath(const FString SaveName, bool compr
 		return FString::Printf(TEXT("%s/SaveGames/%s.json"), *FPaths::ProjectSavedDir(), *SaveName);
 	}
 }
+
+FString UFlareSaveGameSystem::GetBinarySaveGamePath(const FString SaveName)
+{
+	return FString::Printf(TEXT("%s/SaveGames/%s.hrsave"), *FPaths::ProjectSavedDir(), *SaveName);
+}
@@ -27,11 +27,26 @@ public:
 
 	virtual bool DeleteGame(const FString SaveName);
 
+	/** Convert a save between the JSON and binary formats, the source file is kept */
+	virtual bool ConvertGame(const FString SaveName, bool ToBinary);
+
 	/* Keep Save data reference for the async save*/
 	virtual void PushSaveData(UFlareSaveGame* SaveData);
 
 protected:
 
+	/*----------------------------------------------------
+		Formats
+	----------------------------------------------------*/
+
+	bool WriteJsonSave(const FString SaveName, UFlareSaveGame* SaveData);
+
+	bool WriteBinarySave(const FString SaveName, UFlareSaveGame* SaveData);
+
+	UFlareSaveGame* ReadJsonSave(const FString SaveName, AFlareGame* Game);
+
+	UFlareSaveGame* ReadBinarySave(const FString SaveName);
+
 
 	/*----------------------------------------------------
 		Protected data
@@ -54,4 +69,7 @@ public:
    /** Get the path to save game file for the given name, a platform _may_ be able to simply override this and no other functions above */
    static FString GetSaveGamePath(const FString SaveName, bool compressed);
 
+	/** Get the path to the binary save game file for the given name */
+	static FString GetBinarySaveGamePath(const FString SaveName);
+
 };
@@ -0,0 +1,171 @@
+
+#include "FlareSaveStream.h"
+#include "../../Flare.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "zlib.h"
+THIRD_PARTY_INCLUDES_END
+
+#define SAVE_STREAM_BUFFER_SIZE (64 * 1024)
+
+// 15 bits window, +16 for a gzip header and trailer
+#define SAVE_STREAM_GZIP_BIT_WINDOW 31
+
+
+/*----------------------------------------------------
+	Constructor
+----------------------------------------------------*/
+
+FFlareSaveStream::FFlareSaveStream()
+	: Stream(NULL)
+	, FileWriter(NULL)
+	, Error(false)
+{
+}
+
+FFlareSaveStream::~FFlareSaveStream()
+{
+	Abort();
+}
+
+
+/*----------------------------------------------------
+	Interface
+----------------------------------------------------*/
+
+bool FFlareSaveStream::Open(const FString& FileName)
+{
+	Abort();
+
+	TargetFileName = FileName;
+	TempFileName = FileName + TEXT(".tmp");
+	Error = false;
+
+	FileWriter = IFileManager::Get().CreateFileWriter(*TempFileName);
+	if (!FileWriter)
+	{
+		FLOGV("FFlareSaveStream::Open : fail to open '%s'", *TempFileName);
+		Error = true;
+		return false;
+	}
+
+	Stream = new z_stream;
+	FMemory::Memzero(Stream, sizeof(z_stream));
+	if (deflateInit2(Stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, SAVE_STREAM_GZIP_BIT_WINDOW, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+	{
+		FLOG("FFlareSaveStream::Open : fail to init compressor");
+		delete Stream;
+		Stream = NULL;
+		Abort();
+		Error = true;
+		return false;
+	}
+
+	OutputBuffer.SetNumUninitialized(SAVE_STREAM_BUFFER_SIZE);
+	return true;
+}
+
+void FFlareSaveStream::Write(const FString& Text)
+{
+	FTCHARToUTF8 Converter(*Text, Text.Len());
+	Write((const uint8*) Converter.Get(), Converter.Length());
+}
+
+void FFlareSaveStream::Write(const uint8* Data, int32 Size)
+{
+	if (Error || !Stream || Size <= 0)
+	{
+		return;
+	}
+
+	Stream->next_in = (Bytef*) Data;
+	Stream->avail_in = Size;
+	Deflate(Z_NO_FLUSH);
+}
+
+bool FFlareSaveStream::Close()
+{
+	if (!Stream)
+	{
+		return false;
+	}
+
+	Stream->next_in = NULL;
+	Stream->avail_in = 0;
+	Deflate(Z_FINISH);
+
+	deflateEnd(Stream);
+	delete Stream;
+	Stream = NULL;
+
+	bool Result = !Error && FileWriter->Close();
+	delete FileWriter;
+	FileWriter = NULL;
+
+	if (Result)
+	{
+		Result = IFileManager::Get().Move(*TargetFileName, *TempFileName, true);
+	}
+
+	if (!Result)
+	{
+		FLOGV("FFlareSaveStream::Close : fail to write '%s'", *TargetFileName);
+		IFileManager::Get().Delete(*TempFileName, false, false, true);
+		Error = true;
+	}
+
+	return Result;
+}
+
+void FFlareSaveStream::Abort()
+{
+	if (Stream)
+	{
+		deflateEnd(Stream);
+		delete Stream;
+		Stream = NULL;
+	}
+
+	if (FileWriter)
+	{
+		delete FileWriter;
+		FileWriter = NULL;
+		IFileManager::Get().Delete(*TempFileName, false, false, true);
+	}
+}
+
+
+/*----------------------------------------------------
+	Internals
+----------------------------------------------------*/
+
+void FFlareSaveStream::Deflate(int32 FlushMode)
+{
+	// Run until all input is consumed, or until the end of stream when finishing
+	int32 Result = Z_OK;
+	do
+	{
+		Stream->next_out = OutputBuffer.GetData();
+		Stream->avail_out = OutputBuffer.Num();
+
+		Result = deflate(Stream, FlushMode);
+		if (Result == Z_STREAM_ERROR)
+		{
+			FLOG("FFlareSaveStream::Deflate : compression failed");
+			Error = true;
+			return;
+		}
+
+		int32 OutputSize = OutputBuffer.Num() - Stream->avail_out;
+		if (OutputSize > 0)
+		{
+			FileWriter->Serialize(OutputBuffer.GetData(), OutputSize);
+			if (FileWriter->IsError())
+			{
+				Error = true;
+				return;
+			}
+		}
+	}
+	while (Stream->avail_out == 0 || (FlushMode == Z_FINISH && Result != Z_STREAM_END));
+}
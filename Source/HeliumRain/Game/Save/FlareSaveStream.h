@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+struct z_stream_s;
+
+
+/** Incremental gzip file writer.
+ *  Data is compressed as it comes and written to a temporary file, which replaces the target file on Close. */
+class HELIUMRAIN_API FFlareSaveStream
+{
+public:
+
+	/*----------------------------------------------------
+		Constructor
+	----------------------------------------------------*/
+
+	FFlareSaveStream();
+
+	~FFlareSaveStream();
+
+
+	/*----------------------------------------------------
+		Interface
+	----------------------------------------------------*/
+
+	/** Start writing to a file */
+	bool Open(const FString& FileName);
+
+	/** Compress and write UTF-8 text */
+	void Write(const FString& Text);
+
+	/** Compress and write raw bytes */
+	void Write(const uint8* Data, int32 Size);
+
+	/** Flush the compressor and move the file in place, false if anything failed */
+	bool Close();
+
+	/** Give up on the file */
+	void Abort();
+
+
+protected:
+
+	/** Run the compressor and write its output */
+	void Deflate(int32 FlushMode);
+
+
+	/*----------------------------------------------------
+		Protected data
+	----------------------------------------------------*/
+
+	struct z_stream_s*                       Stream;
+
+	FArchive*                                FileWriter;
+
+	TArray<uint8>                            OutputBuffer;
+
+	FString                                  TargetFileName;
+
+	FString                                  TempFileName;
+
+	bool                                     Error;
+
+
+public:
+
+	/*----------------------------------------------------
+		Getters
+	----------------------------------------------------*/
+
+	bool IsError() const
+	{
+		return Error;
+	}
+
+};
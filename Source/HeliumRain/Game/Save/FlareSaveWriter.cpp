@@ -3,6 +3,10 @@
 #include "../../Flare.h"
 #include "../FlareSaveGame.h"
 #include "Game/FlareGameTools.h"
+#include "FlareSaveStream.h"
+
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
 
 /*----------------------------------------------------
 	Constructor
@@ -14,6 +18,112 @@ UFlareSaveWriter::UFlareSaveWriter(const FObjectInitializer& ObjectInitializer)
 }
 
 TSharedRef<FJsonObject> UFlareSaveWriter::SaveGame(UFlareSaveGame* Data)
+{
+	TSharedRef<FJsonObject> JsonObject = SaveGameHeader(Data);
+	JsonObject->SetObjectField("World", SaveWorld(&Data->WorldData));
+
+	return JsonObject;
+}
+
+bool UFlareSaveWriter::SaveGame(UFlareSaveGame* Data, FFlareSaveStream& Stream)
+{
+	StreamObject(SaveGameHeader(Data), Stream, true);
+	Stream.Write(TEXT(",\"World\":"));
+	StreamWorld(&Data->WorldData, Stream);
+	Stream.Write(TEXT("}"));
+
+	return !Stream.IsError();
+}
+
+
+/*----------------------------------------------------
+	Streaming
+----------------------------------------------------*/
+
+void UFlareSaveWriter::StreamWorld(FFlareWorldSave* Data, FFlareSaveStream& Stream)
+{
+	StreamObject(SaveWorldHeader(Data), Stream, true);
+
+	Stream.Write(TEXT(",\"Companies\":["));
+	for(int i = 0; i < Data->CompanyData.Num(); i++)
+	{
+		if (i > 0)
+		{
+			Stream.Write(TEXT(","));
+		}
+		StreamCompany(&Data->CompanyData[i], Stream);
+	}
+
+	Stream.Write(TEXT("],\"Sectors\":["));
+	for(int i = 0; i < Data->SectorData.Num(); i++)
+	{
+		if (i > 0)
+		{
+			Stream.Write(TEXT(","));
+		}
+		StreamObject(SaveSector(&Data->SectorData[i]), Stream);
+	}
+
+	Stream.Write(TEXT("],\"Travels\":["));
+	for(int i = 0; i < Data->TravelData.Num(); i++)
+	{
+		if (i > 0)
+		{
+			Stream.Write(TEXT(","));
+		}
+		StreamObject(SaveTravel(&Data->TravelData[i]), Stream);
+	}
+
+	Stream.Write(TEXT("]}"));
+}
+
+void UFlareSaveWriter::StreamCompany(FFlareCompanySave* Data, FFlareSaveStream& Stream)
+{
+	StreamObject(SaveCompanyHeader(Data), Stream, true);
+	StreamSpacecraftArray(TEXT("Ships"), Data->ShipData, Stream);
+	StreamSpacecraftArray(TEXT("ChildStations"), Data->ChildStationData, Stream);
+	StreamSpacecraftArray(TEXT("Stations"), Data->StationData, Stream);
+	StreamSpacecraftArray(TEXT("DestroyedSpacecrafts"), Data->DestroyedSpacecraftData, Stream);
+	Stream.Write(TEXT("}"));
+}
+
+void UFlareSaveWriter::StreamSpacecraftArray(const TCHAR* Key, TArray<FFlareSpacecraftSave>& Data, FFlareSaveStream& Stream)
+{
+	Stream.Write(FString::Printf(TEXT(",\"%s\":["), Key));
+	for(int i = 0; i < Data.Num(); i++)
+	{
+		if (i > 0)
+		{
+			Stream.Write(TEXT(","));
+		}
+		StreamObject(SaveSpacecraft(&Data[i]), Stream);
+	}
+	Stream.Write(TEXT("]"));
+}
+
+void UFlareSaveWriter::StreamObject(TSharedRef<FJsonObject> Object, FFlareSaveStream& Stream, bool KeepOpen)
+{
+	StreamBuffer.Reset();
+	TSharedRef< TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>> > JsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&StreamBuffer);
+	FJsonSerializer::Serialize(Object, JsonWriter);
+	JsonWriter->Close();
+
+	// Drop the closing brace so that more fields can follow
+	if (KeepOpen)
+	{
+		FCHECK(Object->Values.Num() > 0);
+		StreamBuffer.RemoveFromEnd(TEXT("}"));
+	}
+
+	Stream.Write(StreamBuffer);
+}
+
+
+/*----------------------------------------------------
+	Generator
+----------------------------------------------------*/
+
+TSharedRef<FJsonObject> UFlareSaveWriter::SaveGameHeader(UFlareSaveGame* Data)
 {
 	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
 
@@ -27,16 +137,10 @@ TSharedRef<FJsonObject> UFlareSaveWriter::SaveGame(UFlareSaveGame* Data)
 	JsonObject->SetObjectField("PlayerCompanyDescription", SaveCompanyDescription(&Data->PlayerCompanyDescription));
 	JsonObject->SetStringField("CurrentImmatriculationIndex", FormatInt32(Data->CurrentImmatriculationIndex));
 	JsonObject->SetStringField("CurrentIdentifierIndex", FormatInt32(Data->CurrentIdentifierIndex));
-	JsonObject->SetObjectField("World", SaveWorld(&Data->WorldData));
-
 
 	return JsonObject;
 }
 
-/*----------------------------------------------------
-	Generator
-----------------------------------------------------*/
-
 TSharedRef<FJsonObject> UFlareSaveWriter::SavePlayer(FFlarePlayerSave* Data)
 {
 	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
@@ -202,17 +306,7 @@ TSharedRef<FJsonObject> UFlareSaveWriter::SaveCompanyDescription(FFlareCompanyDe
 
 TSharedRef<FJsonObject> UFlareSaveWriter::SaveWorld(FFlareWorldSave* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
-
-	JsonObject->SetStringField("Date", FormatInt64(Data->Date));
-
-	TArray< TSharedPtr<FJsonValue> > GlobalEvents;
-	GlobalEvents.Reserve(Data->GlobalEvents.Num());
-	for (int i = 0; i < Data->GlobalEvents.Num(); i++)
-	{
-		GlobalEvents.Add(MakeShareable(new FJsonValueObject(SaveWorldEvents(&Data->GlobalEvents[i]))));
-	}
-	JsonObject->SetArrayField("GlobalEvents", GlobalEvents);
+	TSharedRef<FJsonObject> JsonObject = SaveWorldHeader(Data);
 
 	TArray< TSharedPtr<FJsonValue> > Companies;
 	Companies.Reserve(Data->CompanyData.Num());
@@ -241,6 +335,23 @@ TSharedRef<FJsonObject> UFlareSaveWriter::SaveWorld(FFlareWorldSave* Data)
 	return JsonObject;
 }
 
+TSharedRef<FJsonObject> UFlareSaveWriter::SaveWorldHeader(FFlareWorldSave* Data)
+{
+	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+
+	JsonObject->SetStringField("Date", FormatInt64(Data->Date));
+
+	TArray< TSharedPtr<FJsonValue> > GlobalEvents;
+	GlobalEvents.Reserve(Data->GlobalEvents.Num());
+	for (int i = 0; i < Data->GlobalEvents.Num(); i++)
+	{
+		GlobalEvents.Add(MakeShareable(new FJsonValueObject(SaveWorldEvents(&Data->GlobalEvents[i]))));
+	}
+	JsonObject->SetArrayField("GlobalEvents", GlobalEvents);
+
+	return JsonObject;
+}
+
 TSharedRef<FJsonObject> UFlareSaveWriter::SaveWorldEvents(FFlareWorldGameEventSave* Data)
 {
 	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
@@ -251,6 +362,45 @@ TSharedRef<FJsonObject> UFlareSaveWriter::SaveWorldEvents(FFlareWorldGameEventSa
 }
 
 TSharedRef<FJsonObject> UFlareSaveWriter::SaveCompany(FFlareCompanySave* Data)
+{
+	TSharedRef<FJsonObject> JsonObject = SaveCompanyHeader(Data);
+
+	TArray< TSharedPtr<FJsonValue> > Ships;
+	Ships.Reserve(Data->ShipData.Num());
+	for(int i = 0; i < Data->ShipData.Num(); i++)
+	{
+		Ships.Add(MakeShareable(new FJsonValueObject(SaveSpacecraft(&Data->ShipData[i]))));
+	}
+	JsonObject->SetArrayField("Ships", Ships);
+
+	TArray< TSharedPtr<FJsonValue> > ChildStations;
+	ChildStations.Reserve(Data->ChildStationData.Num());
+	for(int i = 0; i < Data->ChildStationData.Num(); i++)
+	{
+		ChildStations.Add(MakeShareable(new FJsonValueObject(SaveSpacecraft(&Data->ChildStationData[i]))));
+	}
+	JsonObject->SetArrayField("ChildStations", ChildStations);
+
+	TArray< TSharedPtr<FJsonValue> > Stations;
+	Stations.Reserve(Data->StationData.Num());
+	for(int i = 0; i < Data->StationData.Num(); i++)
+	{
+		Stations.Add(MakeShareable(new FJsonValueObject(SaveSpacecraft(&Data->StationData[i]))));
+	}
+	JsonObject->SetArrayField("Stations", Stations);
+
+	TArray< TSharedPtr<FJsonValue> > DestroyedSpacecrafts;
+	DestroyedSpacecrafts.Reserve(Data->DestroyedSpacecraftData.Num());
+	for(int i = 0; i < Data->DestroyedSpacecraftData.Num(); i++)
+	{
+		DestroyedSpacecrafts.Add(MakeShareable(new FJsonValueObject(SaveSpacecraft(&Data->DestroyedSpacecraftData[i]))));
+	}
+	JsonObject->SetArrayField("DestroyedSpacecrafts", DestroyedSpacecrafts);
+
+	return JsonObject;
+}
+
+TSharedRef<FJsonObject> UFlareSaveWriter::SaveCompanyHeader(FFlareCompanySave* Data)
 {
 	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
 
@@ -299,38 +449,6 @@ TSharedRef<FJsonObject> UFlareSaveWriter::SaveCompany(FFlareCompanySave* Data)
 	}
 	JsonObject->SetArrayField("HostileCompanies", HostileCompanies);
 
-	TArray< TSharedPtr<FJsonValue> > Ships;
-	Ships.Reserve(Data->ShipData.Num());
-	for(int i = 0; i < Data->ShipData.Num(); i++)
-	{
-		Ships.Add(MakeShareable(new FJsonValueObject(SaveSpacecraft(&Data->ShipData[i]))));
-	}
-	JsonObject->SetArrayField("Ships", Ships);
-
-	TArray< TSharedPtr<FJsonValue> > ChildStations;
-	ChildStations.Reserve(Data->ChildStationData.Num());
-	for(int i = 0; i < Data->ChildStationData.Num(); i++)
-	{
-		ChildStations.Add(MakeShareable(new FJsonValueObject(SaveSpacecraft(&Data->ChildStationData[i]))));
-	}
-	JsonObject->SetArrayField("ChildStations", ChildStations);
-
-	TArray< TSharedPtr<FJsonValue> > Stations;
-	Stations.Reserve(Data->StationData.Num());
-	for(int i = 0; i < Data->StationData.Num(); i++)
-	{
-		Stations.Add(MakeShareable(new FJsonValueObject(SaveSpacecraft(&Data->StationData[i]))));
-	}
-	JsonObject->SetArrayField("Stations", Stations);
-
-	TArray< TSharedPtr<FJsonValue> > DestroyedSpacecrafts;
-	DestroyedSpacecrafts.Reserve(Data->DestroyedSpacecraftData.Num());
-	for(int i = 0; i < Data->DestroyedSpacecraftData.Num(); i++)
-	{
-		DestroyedSpacecrafts.Add(MakeShareable(new FJsonValueObject(SaveSpacecraft(&Data->DestroyedSpacecraftData[i]))));
-	}
-	JsonObject->SetArrayField("DestroyedSpacecrafts", DestroyedSpacecrafts);
-
 	TArray< TSharedPtr<FJsonValue> > Fleets;
 	Fleets.Reserve(Data->Fleets.Num());
 	for(int i = 0; i < Data->Fleets.Num(); i++)
@@ -44,6 +44,8 @@ struct FFFlareResourcePrice;
 struct FFlareTravelSave;
 struct FFlareFloatBuffer;
 
+class FFlareSaveStream;
+
 
 
 UCLASS()
@@ -55,11 +57,27 @@ public:
 
 	TSharedRef<FJsonObject> SaveGame(UFlareSaveGame* Data);
 
+	/** Write the save as JSON to a stream, one company, spacecraft, sector and travel at a time */
+	bool SaveGame(UFlareSaveGame* Data, FFlareSaveStream& Stream);
+
 protected:
+
+	/*----------------------------------------------------
+	  Streaming
+	----------------------------------------------------*/
+
+	void StreamWorld(FFlareWorldSave* Data, FFlareSaveStream& Stream);
+	void StreamCompany(FFlareCompanySave* Data, FFlareSaveStream& Stream);
+	void StreamSpacecraftArray(const TCHAR* Key, TArray<FFlareSpacecraftSave>& Data, FFlareSaveStream& Stream);
+
+	/** Serialize an object to the stream, leaving it open for more fields if KeepOpen is set */
+	void StreamObject(TSharedRef<FJsonObject> Object, FFlareSaveStream& Stream, bool KeepOpen = false);
+
 	/*----------------------------------------------------
 	  Generator
 	----------------------------------------------------*/
 
+	TSharedRef<FJsonObject> SaveGameHeader(UFlareSaveGame* Data);
 	TSharedRef<FJsonObject> SavePlayer(FFlarePlayerSave* Data);
 	TSharedRef<FJsonObject> SaveQuest(FFlareQuestSave* Data);
 	TSharedRef<FJsonObject> SaveQuestProgress(FFlareQuestProgressSave* Data);
@@ -68,9 +86,11 @@ protected:
 
 	TSharedRef<FJsonObject> SaveCompanyDescription(FFlareCompanyDescription* Data);
 	TSharedRef<FJsonObject> SaveWorld(FFlareWorldSave* Data);
+	TSharedRef<FJsonObject> SaveWorldHeader(FFlareWorldSave* Data);
 
 	TSharedRef<FJsonObject> SaveWorldEvents(FFlareWorldGameEventSave* Data);
 	TSharedRef<FJsonObject> SaveCompany(FFlareCompanySave* Data);
+	TSharedRef<FJsonObject> SaveCompanyHeader(FFlareCompanySave* Data);
 
 	TSharedRef<FJsonObject> SaveSpacecraft(FFlareSpacecraftSave* Data);
 	TSharedRef<FJsonObject> SavePilot(FFlareShipPilotSave* Data);
@@ -117,6 +137,8 @@ protected:
 		Protected data
 	----------------------------------------------------*/
 
+	/** Text of the object being streamed */
+	FString                                  StreamBuffer;
 
 
 public:
@@ -35,6 +35,7 @@ public class HeliumRain : ModuleRules
         );
         
         PrivateDependencyModuleNames.Add("OnlineSubsystem");
+        AddEngineThirdPartyPrivateStaticDependencies(Target, "zlib");
         DynamicallyLoadedModuleNames.Add("OnlineSubsystemSteam");
     }
 }
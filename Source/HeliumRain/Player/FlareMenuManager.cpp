@@ -62,6 +62,7 @@ AFlareMenuManager::AFlareMenuManager(const class FObjectInitializer& PCIP)
 	, MenuIsOpen(false)
 	, FadeFromBlack(true)
 	, NotifyExitSector(false)
+	, NotificationsDeferred(false)
 	, FadeDuration(0.3)
 	, SkirmishCountdownDuration(10.50)
 	, SkirmishCountdownTimer(-1)
@@ -521,6 +522,34 @@ bool AFlareMenuManager::Notify(FText Text, FText Info, FName Tag, EFlareNotifica
 {
 	if (MainOverlay.IsValid())
 	{
+		if (NotificationsDeferred)
+		{
+			// Threats still interrupt a fast-forward
+			if (Type == EFlareNotification::NT_Military)
+			{
+				OrbitMenu->RequestStopFastForward();
+			}
+
+			if (Tag != NAME_None)
+			{
+				DeferredNotifications.RemoveAll([Tag](const FFlareDeferredNotification& Notification)
+				{
+					return Notification.Tag == Tag;
+				});
+			}
+
+			FFlareDeferredNotification Notification;
+			Notification.Text = Text;
+			Notification.Info = Info;
+			Notification.Tag = Tag;
+			Notification.Type = Type;
+			Notification.NotificationTimeout = NotificationTimeout;
+			Notification.TargetMenu = TargetMenu;
+			Notification.TargetInfo = TargetInfo;
+			DeferredNotifications.Add(Notification);
+			return true;
+		}
+
 		if (!UFlareGameTools::FastFastForward && Type != EFlareNotification::NT_NewQuest)
 		{
 			OrbitMenu->RequestStopFastForward();
@@ -530,8 +559,37 @@ bool AFlareMenuManager::Notify(FText Text, FText Info, FName Tag, EFlareNotifica
 	return false;
 }
 
+void AFlareMenuManager::SetNotificationsDeferred(bool Deferred)
+{
+	NotificationsDeferred = Deferred;
+
+	if (!Deferred && DeferredNotifications.Num() > 0)
+	{
+		FLOGV("AFlareMenuManager::SetNotificationsDeferred : showing %d notifications", DeferredNotifications.Num());
+
+		TArray<FFlareDeferredNotification> Notifications = MoveTemp(DeferredNotifications);
+
+		for (const FFlareDeferredNotification& Notification : Notifications)
+		{
+			if (MainOverlay.IsValid())
+			{
+				Notifier->Notify(Notification.Text, Notification.Info, Notification.Tag, Notification.Type,
+					Notification.NotificationTimeout, Notification.TargetMenu, Notification.TargetInfo);
+			}
+		}
+	}
+}
+
 void AFlareMenuManager::ClearNotifications(FName Tag)
 {
+	if (Tag != NAME_None)
+	{
+		DeferredNotifications.RemoveAll([Tag](const FFlareDeferredNotification& Notification)
+		{
+			return Notification.Tag == Tag;
+		});
+	}
+
 	if (MainOverlay.IsValid())
 	{
 		Notifier->ClearNotifications(Tag, false);
@@ -540,6 +598,8 @@ void AFlareMenuManager::ClearNotifications(FName Tag)
 
 void AFlareMenuManager::FlushNotifications()
 {
+	DeferredNotifications.Empty();
+
 	if (MainOverlay.IsValid())
 	{
 		Notifier->FlushNotifications();
@@ -51,6 +51,18 @@ class AFlareGame;
 // Menu state
 typedef TPair<EFlareMenu::Type, FFlareMenuParameterData> TFlareMenuData;
 
+/** Notification held back until notifications are shown again */
+struct FFlareDeferredNotification
+{
+	FText                                   Text;
+	FText                                   Info;
+	FName                                   Tag;
+	EFlareNotification::Type                Type;
+	float                                   NotificationTimeout;
+	EFlareMenu::Type                        TargetMenu;
+	FFlareMenuParameterData                 TargetInfo;
+};
+
 
 /*----------------------------------------------------
 	Menu manager code
@@ -121,6 +133,9 @@ public:
 	/** Remove all notifications from the screen */
 	void FlushNotifications();
 
+	/** Hold notifications back, only keeping the latest of each tag, and show them when no longer deferred */
+	void SetNotificationsDeferred(bool Deferred);
+
 	/** Show the confirmation overlay */
 	void Confirm(FText Title, FText Text, FSimpleDelegate OnConfirmed, FSimpleDelegate OnCancel = FSimpleDelegate(), FSimpleDelegate OnIgnore = FSimpleDelegate());
 
@@ -417,6 +432,7 @@ protected:
 	bool                                    FadeFromBlack;
 	bool                                    SkipNextFade;
 	bool                                    NotifyExitSector;
+	bool                                    NotificationsDeferred;
 	float                                   FadeDuration;
 	float                                   FadeTimer;
 	float                                   SkirmishCountdownDuration;
@@ -426,6 +442,7 @@ protected:
 	TArray<TFlareMenuData>                  MenuHistory;
 	SFlareSpacecraftInfo*                   CurrentSpacecraftInfo;
 	FVector2D                               JoystickCursorPosition;
+	TArray<FFlareDeferredNotification>      DeferredNotifications;
 
 	// Menu tools
 	TSharedPtr<SBorder>                     Fader;
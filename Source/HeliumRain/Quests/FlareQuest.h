@@ -80,9 +80,8 @@ public:
 
 	virtual FText FormatTags(FText Message);
 
-	virtual int32 GetReservedCapacity(UFlareSimulatedSpacecraft* Station, FFlareResourceDescription* Resource) { return 0; };
-
-	virtual int32 GetReservedQuantity(UFlareSimulatedSpacecraft* Station, FFlareResourceDescription* Resource) { return 0; };
+	/** Cargo held at stations while the quest is available or ongoing, must not change once the quest is loaded */
+	virtual void GetReservations(TArray<FFlareQuestReservation>& OutReservations) {};
 
 
 	/*----------------------------------------------------
@@ -1727,7 +1727,7 @@ bool UFlareQuestConditionDockAt::IsCompleted()
 	}
 
 	bool InActiveSector = GetGame()->GetActiveSector() && GetGame()->GetActiveSector()->GetSimulatedSector() == TargetStation->GetCurrentSector();
-	if (InActiveSector)
+	if (InActiveSector && TargetStation->GetActive())
 	{
 		for (AFlareSpacecraft* Ship : TargetStation->GetActive()->GetDockingSystem()->GetDockedShips())
 		{
@@ -1281,22 +1281,9 @@ bool UFlareQuestGeneratedResourceSale::Load(UFlareQuestGenerator* Parent, const
 	return true;
 }
 
-int32 UFlareQuestGeneratedResourceSale::GetReservedQuantity(UFlareSimulatedSpacecraft* TargetStation, FFlareResourceDescription* TargetResource)
+void UFlareQuestGeneratedResourceSale::GetReservations(TArray<FFlareQuestReservation>& OutReservations)
 {
-	UFlareSimulatedSpacecraft* Station = QuestManager->GetGame()->GetGameWorld()->FindSpacecraft(InitData.GetName("station"));
-	// TODO Cache
-
-	if (Station == TargetStation)
-	{
-		FFlareResourceDescription* Resource = QuestManager->GetGame()->GetResourceCatalog()->Get(InitData.GetName("resource"));
-		if (Resource == TargetResource)
-		{
-			int32 Quantity = InitData.GetInt32("quantity");
-			return Quantity;
-		}
-	}
-
-	return 0;
+	OutReservations.Add(FFlareQuestReservation(InitData.GetName("station"), InitData.GetName("resource"), InitData.GetInt32("quantity"), 0));
 }
 
 /*----------------------------------------------------
@@ -1508,22 +1495,9 @@ bool UFlareQuestGeneratedResourcePurchase::Load(UFlareQuestGenerator* Parent, co
 	return true;
 }
 
-int32 UFlareQuestGeneratedResourcePurchase::GetReservedCapacity(UFlareSimulatedSpacecraft* TargetStation, FFlareResourceDescription* TargetResource)
+void UFlareQuestGeneratedResourcePurchase::GetReservations(TArray<FFlareQuestReservation>& OutReservations)
 {
-	UFlareSimulatedSpacecraft* Station = QuestManager->GetGame()->GetGameWorld()->FindSpacecraft(InitData.GetName("station"));
-	// TODO Cache
-
-	if (Station == TargetStation)
-	{
-		FFlareResourceDescription* Resource = QuestManager->GetGame()->GetResourceCatalog()->Get(InitData.GetName("resource"));
-		if (Resource == TargetResource)
-		{
-			int32 Quantity = InitData.GetInt32("quantity");
-			return Quantity;
-		}
-	}
-
-	return 0;
+	OutReservations.Add(FFlareQuestReservation(InitData.GetName("station"), InitData.GetName("resource"), 0, InitData.GetInt32("quantity")));
 }
 
 /*----------------------------------------------------
@@ -1793,41 +1767,15 @@ bool UFlareQuestGeneratedResourceTrade::Load(UFlareQuestGenerator* Parent, const
 	return true;
 }
 
-int32 UFlareQuestGeneratedResourceTrade::GetReservedCapacity(UFlareSimulatedSpacecraft* TargetStation, FFlareResourceDescription* TargetResource)
+void UFlareQuestGeneratedResourceTrade::GetReservations(TArray<FFlareQuestReservation>& OutReservations)
 {
-	UFlareSimulatedSpacecraft* Station2 = QuestManager->GetGame()->GetGameWorld()->FindSpacecraft(InitData.GetName("station2"));
-	// TODO Cache
-
-	if (Station2 == TargetStation)
-	{
-		FFlareResourceDescription* Resource = QuestManager->GetGame()->GetResourceCatalog()->Get(InitData.GetName("resource"));
-		if (Resource == TargetResource)
-		{
-			int32 Quantity = InitData.GetInt32("quantity");
-			return Quantity;
-		}
-	}
+	FName Resource = InitData.GetName("resource");
+	int32 Quantity = InitData.GetInt32("quantity");
 
-	return 0;
+	OutReservations.Add(FFlareQuestReservation(InitData.GetName("station1"), Resource, Quantity, 0));
+	OutReservations.Add(FFlareQuestReservation(InitData.GetName("station2"), Resource, 0, Quantity));
 }
 
-int32 UFlareQuestGeneratedResourceTrade::GetReservedQuantity(UFlareSimulatedSpacecraft* TargetStation, FFlareResourceDescription* TargetResource)
-{
-	UFlareSimulatedSpacecraft* Station1 = QuestManager->GetGame()->GetGameWorld()->FindSpacecraft(InitData.GetName("station1"));
-	// TODO Cache
-
-	if (Station1 == TargetStation)
-	{
-		FFlareResourceDescription* Resource = QuestManager->GetGame()->GetResourceCatalog()->Get(InitData.GetName("resource"));
-		if (Resource == TargetResource)
-		{
-			int32 Quantity = InitData.GetInt32("quantity");
-			return Quantity;
-		}
-	}
-
-	return 0;
-}
 /*----------------------------------------------------
 	Generated station defense quest
 ----------------------------------------------------*/
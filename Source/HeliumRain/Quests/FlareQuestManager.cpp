@@ -39,6 +39,9 @@ void UFlareQuestManager::Load(const FFlareQuestSave& Data)
 
 	QuestData = Data;
 
+	Reservations.Empty();
+	QuestReservations.Empty();
+
 	ActiveQuestIdentifiers.Empty();
 	for (int QuestProgressIndex = 0; QuestProgressIndex <Data.QuestProgresses.Num(); QuestProgressIndex++)
 	{
@@ -186,6 +189,7 @@ void UFlareQuestManager::AddQuest(UFlareQuest* Quest)
 	}
 
 	Quests.Add(Quest);
+	UpdateReservations(Quest);
 }
 
 
@@ -540,6 +544,7 @@ void UFlareQuestManager::OnQuestSuccess(UFlareQuest* Quest)
 	FLOGV("Quest %s is now successful", *Quest->GetIdentifier().ToString())
 	OngoingQuests.Remove(Quest);
 	OldQuests.Add(Quest);
+	UpdateReservations(Quest);
 
 	// Quest successful notification
 	if (Quest->GetQuestCategory() != EFlareQuestCategory::TUTORIAL)
@@ -571,6 +576,7 @@ void UFlareQuestManager::OnQuestFail(UFlareQuest* Quest, bool Notify)
 	AvailableQuests.Remove(Quest);
 	PendingQuests.Remove(Quest);
 	OldQuests.Add(Quest);
+	UpdateReservations(Quest);
 
 	// Quest failed notification
 	if (Notify && Quest->GetQuestCategory() != EFlareQuestCategory::TUTORIAL)
@@ -598,6 +604,7 @@ void UFlareQuestManager::OnQuestAvailable(UFlareQuest* Quest)
 	FLOGV("Quest %s is now available", *Quest->GetIdentifier().ToString())
 	PendingQuests.Remove(Quest);
 	AvailableQuests.Add(Quest);
+	UpdateReservations(Quest);
 
 	// New quest notification
 	if (Quest->GetQuestCategory() != EFlareQuestCategory::TUTORIAL && Quest->GetQuestCategory() != EFlareQuestCategory::SECONDARY)
@@ -619,6 +626,7 @@ void UFlareQuestManager::OnQuestOngoing(UFlareQuest* Quest)
 	FLOGV("Quest %s is now ongoing", *Quest->GetIdentifier().ToString())
 	AvailableQuests.Remove(Quest);
 	OngoingQuests.Add(Quest);
+	UpdateReservations(Quest);
 	
 	if (!SelectedQuest)
 	{
@@ -629,36 +637,69 @@ void UFlareQuestManager::OnQuestOngoing(UFlareQuest* Quest)
 
 int32 UFlareQuestManager::GetReservedCapacity(UFlareSimulatedSpacecraft* Station, FFlareResourceDescription* Resource)
 {
-	int32 ReservedCapacity = 0;
-
-	for(UFlareQuest* Quest: OngoingQuests)
+	if (!Station || !Resource)
 	{
-		ReservedCapacity += Quest->GetReservedCapacity(Station, Resource);
+		return 0;
 	}
 
-	for(UFlareQuest* Quest: AvailableQuests)
+	FFlareQuestReservation* Reservation = Reservations.Find(TPair<FName, FName>(Station->GetImmatriculation(), Resource->Identifier));
+	return (Reservation ? Reservation->Capacity : 0);
+}
+
+int32 UFlareQuestManager::GetReservedQuantity(UFlareSimulatedSpacecraft* Station, FFlareResourceDescription* Resource)
+{
+	if (!Station || !Resource)
 	{
-		ReservedCapacity += Quest->GetReservedCapacity(Station, Resource);
+		return 0;
 	}
 
-	return ReservedCapacity;
+	FFlareQuestReservation* Reservation = Reservations.Find(TPair<FName, FName>(Station->GetImmatriculation(), Resource->Identifier));
+	return (Reservation ? Reservation->Quantity : 0);
 }
 
-int32 UFlareQuestManager::GetReservedQuantity(UFlareSimulatedSpacecraft* Station, FFlareResourceDescription* Resource)
+void UFlareQuestManager::UpdateReservations(UFlareQuest* Quest)
 {
-	int32 ReservedQuantity = 0;
+	bool IsReserving = AvailableQuests.Contains(Quest) || OngoingQuests.Contains(Quest);
+	TArray<FFlareQuestReservation>* CountedReservations = QuestReservations.Find(Quest);
 
-	for(UFlareQuest* Quest: OngoingQuests)
+	// Quest became active
+	if (IsReserving && !CountedReservations)
 	{
-		ReservedQuantity += Quest->GetReservedQuantity(Station, Resource);
+		TArray<FFlareQuestReservation> NewReservations;
+		Quest->GetReservations(NewReservations);
+
+		for (const FFlareQuestReservation& Reservation : NewReservations)
+		{
+			TPair<FName, FName> Key(Reservation.Station, Reservation.Resource);
+			FFlareQuestReservation& Total = Reservations.FindOrAdd(Key);
+			Total.Station = Reservation.Station;
+			Total.Resource = Reservation.Resource;
+			Total.Quantity += Reservation.Quantity;
+			Total.Capacity += Reservation.Capacity;
+		}
+
+		QuestReservations.Add(Quest, NewReservations);
 	}
 
-	for(UFlareQuest* Quest: AvailableQuests)
+	// Quest is over
+	else if (!IsReserving && CountedReservations)
 	{
-		ReservedQuantity += Quest->GetReservedQuantity(Station, Resource);
-	}
+		for (const FFlareQuestReservation& Reservation : *CountedReservations)
+		{
+			TPair<FName, FName> Key(Reservation.Station, Reservation.Resource);
+			FFlareQuestReservation* Total = Reservations.Find(Key);
+			FCHECK(Total);
+
+			Total->Quantity -= Reservation.Quantity;
+			Total->Capacity -= Reservation.Capacity;
+			if (Total->Quantity == 0 && Total->Capacity == 0)
+			{
+				Reservations.Remove(Key);
+			}
+		}
 
-	return ReservedQuantity;
+		QuestReservations.Remove(Quest);
+	}
 }
 
 /*----------------------------------------------------
@@ -867,6 +908,8 @@ bool UFlareQuestManager::IsTradeQuestUseStation(UFlareSimulatedSpacecraft* Stati
 
 bool UFlareQuestManager::IsUnderMilitaryContract(UFlareSimulatedSector* Sector,  UFlareCompany* Company, bool IncludeCache)
 {
+	FScopeLock Lock(&MilitaryCacheLock);
+
 	if(IsUnderMilitaryContractNoCache(Sector, Company))
 	{
 		for(IsUnderMilitaryContractCacheEntry& CacheEntry : IsUnderMilitaryContractCache)
@@ -918,6 +961,8 @@ bool UFlareQuestManager::IsUnderMilitaryContract(UFlareSimulatedSector* Sector,
 
 bool UFlareQuestManager::IsMilitaryTarget(UFlareSimulatedSpacecraft const* Spacecraft, bool IncludeCache)
 {
+	FScopeLock Lock(&MilitaryCacheLock);
+
 	if(IsMilitaryTargetNoCache(Spacecraft))
 	{
 		for(IsMilitaryTargetCacheEntry& CacheEntry : IsMilitaryTargetCache)
@@ -137,6 +137,26 @@ struct FFlareQuestSave
 	int64 NextGeneratedQuestIndex;
 };
 
+/** Cargo held by quests at a station */
+struct FFlareQuestReservation
+{
+	FFlareQuestReservation(FName InStation = NAME_None, FName InResource = NAME_None, int32 InQuantity = 0, int32 InCapacity = 0)
+		: Station(InStation)
+		, Resource(InResource)
+		, Quantity(InQuantity)
+		, Capacity(InCapacity)
+	{}
+
+	FName                                    Station;
+	FName                                    Resource;
+
+	/** Stock kept for the quest */
+	int32                                    Quantity;
+
+	/** Free space kept for the quest */
+	int32                                    Capacity;
+};
+
 
 /** Quest system manager */
 UCLASS()
@@ -186,6 +206,13 @@ public:
 
 	int32 GetReservedQuantity(UFlareSimulatedSpacecraft* Station, FFlareResourceDescription* Resource);
 
+protected:
+
+	/** Add or remove the reservations of a quest as it becomes active or inactive */
+	void UpdateReservations(UFlareQuest* Quest);
+
+public:
+
    /*----------------------------------------------------
 	   Callback
    ----------------------------------------------------*/
@@ -286,6 +313,15 @@ protected:
 	TArray<IsUnderMilitaryContractCacheEntry> IsUnderMilitaryContractCache;
 	TArray<IsMilitaryTargetCacheEntry> IsMilitaryTargetCache;
 
+	/** Battles of different sectors can fill the caches at the same time */
+	FCriticalSection MilitaryCacheLock;
+
+	/** Cargo reserved by available and ongoing quests, by station and resource */
+	TMap<TPair<FName, FName>, FFlareQuestReservation> Reservations;
+
+	/** Reservations counted for each available or ongoing quest */
+	TMap<UFlareQuest*, TArray<FFlareQuestReservation>> QuestReservations;
+
 public:
 
 	/*----------------------------------------------------
@@ -79,7 +79,7 @@ bool PilotHelper::FindMostDangerousCollision(AActor*& MostDangerousCandidateActo
 											 FVector& MostDangerousLocation,
 											 float& MostDangerousTimeToHit,
 											 float& MostDangerousInterceptDepth,
-											 AFlareSpacecraft* Ship, AnticollisionConfig IgnoreConfig, float SpeedLimit)
+											 AFlareSpacecraft* Ship, AnticollisionConfig IgnoreConfig, float SpeedLimit, bool UsePredictedHostility)
 {
 	SCOPE_CYCLE_COUNTER(STAT_PilotHelper_AnticollisionCorrection);
 
@@ -88,57 +88,85 @@ bool PilotHelper::FindMostDangerousCollision(AActor*& MostDangerousCandidateActo
 	TArray<TFlareCollisionCandidate> Candidates;
 	TFlareCollisionCandidate Candidate;
 
-	TArray<AActor*> ColliderActorList;
-	UGameplayStatics::GetAllActorsOfClass(Ship->GetWorld(), AFlareCollider::StaticClass(), ColliderActorList);
-	Candidates.Reserve(ActiveSector->GetAsteroids().Num() + ActiveSector->GetMeteorites().Num() + ColliderActorList.Num());
+	// Input data for danger processing
+	FBox ShipBox = Ship->GetComponentsBoundingBox();
+	FVector CurrentVelocity = Ship->GetLinearVelocity() * 100;
+	FVector CurrentLocation = (ShipBox.Max + ShipBox.Min) / 2.0;
+	float CurrentSize = FMath::Max(ShipBox.GetExtent().Size(), 1.0f);
+	float MaxRelevanceDistance = 200 * CurrentSize;
 
-	// Select dangerous ships
-	for (auto SpacecraftCandidate : ActiveSector->GetSpacecrafts())
-	{
-		if (SpacecraftCandidate && SpacecraftCandidate != Ship
-		 && SpacecraftCandidate != IgnoreConfig.SpacecraftToIgnore
-		 && !(IgnoreConfig.IgnoreAllStations && SpacecraftCandidate->IsStation())
-		 && !Ship->GetDockingSystem()->IsGrantedShip(SpacecraftCandidate)
-		 && !Ship->GetDockingSystem()->IsDockedShip(SpacecraftCandidate)
-		 && !(Ship->GetSize() == EFlarePartSize::L
-			  && SpacecraftCandidate->GetSize() == EFlarePartSize::S
-			  && IsTargetDangerous(PilotTarget(SpacecraftCandidate))
-			  && SpacecraftCandidate->IsHostile(Ship->GetCompany()))
-		&& !(IgnoreConfig.SpacecraftToIgnore && IgnoreConfig.SpacecraftToIgnore->IsStation() && IgnoreConfig.SpacecraftToIgnore->GetParent()->IsComplexElement() && SpacecraftCandidate->GetParent() == IgnoreConfig.SpacecraftToIgnore->GetParent()->GetComplexMaster())
-		&& !(IgnoreConfig.SpacecraftToIgnore && IgnoreConfig.SpacecraftToIgnore->IsStation() && IgnoreConfig.SpacecraftToIgnore->GetParent()->IsComplex() && SpacecraftCandidate->GetParent()->GetComplexMaster() == IgnoreConfig.SpacecraftToIgnore->GetParent())
-		)
-		{
-			Candidate.Key = SpacecraftCandidate;
-			Candidate.Value = SpacecraftCandidate->Airframe->GetPhysicsLinearVelocity();
-			Candidates.Add(Candidate);
-		}
-	}
+	// Only bodies close enough to be relevant
+	TArray<FFlareBroadphaseBody> Bodies;
+	ActiveSector->GetBroadphase().QueryRadius(CurrentLocation, MaxRelevanceDistance,
+		EFlareBroadphaseBody::Spacecraft | EFlareBroadphaseBody::Asteroid | EFlareBroadphaseBody::Meteorite | EFlareBroadphaseBody::Collider, Bodies);
+	Candidates.Reserve(Bodies.Num());
 
-	// Select dangerous asteroids
-	for (auto AsteroidCandidate : ActiveSector->GetAsteroids())
+	for (const FFlareBroadphaseBody& Body : Bodies)
 	{
-		Candidate.Key = AsteroidCandidate;
-		Candidate.Value = AsteroidCandidate->GetAsteroidComponent()->GetPhysicsLinearVelocity();
-		Candidates.Add(Candidate);
-	}
-
-	// Select dangerous meteorites
-	for (auto MeteoriteCandidate : ActiveSector->GetMeteorites())
-	{
-		if(!MeteoriteCandidate->IsBroken())
+		switch (Body.Type)
 		{
-			Candidate.Key = MeteoriteCandidate;
-			Candidate.Value = MeteoriteCandidate->GetMeteoriteComponent()->GetPhysicsLinearVelocity();
-			Candidates.Add(Candidate);
-		}
-	}
+			// Select dangerous ships
+			case EFlareBroadphaseBody::Spacecraft:
+			{
+				AFlareSpacecraft* SpacecraftCandidate = Cast<AFlareSpacecraft>(Body.Actor);
+				if (SpacecraftCandidate && SpacecraftCandidate != Ship
+				 && SpacecraftCandidate != IgnoreConfig.SpacecraftToIgnore
+				 && !(IgnoreConfig.IgnoreAllStations && SpacecraftCandidate->IsStation())
+				 && !Ship->GetDockingSystem()->IsGrantedShip(SpacecraftCandidate)
+				 && !Ship->GetDockingSystem()->IsDockedShip(SpacecraftCandidate)
+				 && !(Ship->GetSize() == EFlarePartSize::L
+					  && SpacecraftCandidate->GetSize() == EFlarePartSize::S
+					  && IsTargetDangerous(PilotTarget(SpacecraftCandidate))
+					  && (UsePredictedHostility ? ActiveSector->IsPredictedHostile(SpacecraftCandidate, Ship->GetCompany()) : SpacecraftCandidate->IsHostile(Ship->GetCompany())))
+				&& !(IgnoreConfig.SpacecraftToIgnore && IgnoreConfig.SpacecraftToIgnore->IsStation() && IgnoreConfig.SpacecraftToIgnore->GetParent()->IsComplexElement() && SpacecraftCandidate->GetParent() == IgnoreConfig.SpacecraftToIgnore->GetParent()->GetComplexMaster())
+				&& !(IgnoreConfig.SpacecraftToIgnore && IgnoreConfig.SpacecraftToIgnore->IsStation() && IgnoreConfig.SpacecraftToIgnore->GetParent()->IsComplex() && SpacecraftCandidate->GetParent()->GetComplexMaster() == IgnoreConfig.SpacecraftToIgnore->GetParent())
+				)
+				{
+					Candidate.Key = SpacecraftCandidate;
+					Candidate.Value = SpacecraftCandidate->Airframe->GetPhysicsLinearVelocity();
+					Candidates.Add(Candidate);
+				}
+			}
+			break;
 
-	// Select dangerous colliders
-	for (auto ColliderCandidate : ColliderActorList)
-	{
-		Candidate.Key = Cast<AFlareCollider>(ColliderCandidate);
-		Candidate.Value = FVector::ZeroVector;
-		Candidates.Add(Candidate);
+			// Select dangerous asteroids
+			case EFlareBroadphaseBody::Asteroid:
+			{
+				AFlareAsteroid* AsteroidCandidate = Cast<AFlareAsteroid>(Body.Actor);
+				if (AsteroidCandidate)
+				{
+					Candidate.Key = AsteroidCandidate;
+					Candidate.Value = AsteroidCandidate->GetAsteroidComponent()->GetPhysicsLinearVelocity();
+					Candidates.Add(Candidate);
+				}
+			}
+			break;
+
+			// Select dangerous meteorites
+			case EFlareBroadphaseBody::Meteorite:
+			{
+				AFlareMeteorite* MeteoriteCandidate = Cast<AFlareMeteorite>(Body.Actor);
+				if (MeteoriteCandidate && !MeteoriteCandidate->IsBroken())
+				{
+					Candidate.Key = MeteoriteCandidate;
+					Candidate.Value = MeteoriteCandidate->GetMeteoriteComponent()->GetPhysicsLinearVelocity();
+					Candidates.Add(Candidate);
+				}
+			}
+			break;
+
+			// Select dangerous colliders
+			case EFlareBroadphaseBody::Collider:
+			{
+				Candidate.Key = Body.Actor;
+				Candidate.Value = FVector::ZeroVector;
+				Candidates.Add(Candidate);
+			}
+			break;
+
+			default:
+			break;
+		}
 	}
 
 	// No candidate found, return
@@ -147,13 +175,6 @@ bool PilotHelper::FindMostDangerousCollision(AActor*& MostDangerousCandidateActo
 		return false;
 	}
 
-	// Input data for danger processing
-	FBox ShipBox = Ship->GetComponentsBoundingBox();
-	FVector CurrentVelocity = Ship->GetLinearVelocity() * 100;
-	FVector CurrentLocation = (ShipBox.Max + ShipBox.Min) / 2.0;
-	float CurrentSize = FMath::Max(ShipBox.GetExtent().Size(), 1.0f);
-	float MaxRelevanceDistance = 200 * CurrentSize;
-
 // Output data
 	MostDangerousCandidateActor = NULL;
 
@@ -188,6 +209,18 @@ bool PilotHelper::IsAnticollisionImminent(AFlareSpacecraft* Ship, float Preventi
 	return false;
 }
 
+PilotHelper::CollisionPrediction PilotHelper::PredictCollision(AFlareSpacecraft* Ship, float PreventionDuration, AnticollisionConfig IgnoreConfig, float SpeedLimit, bool UsePredictedHostility)
+{
+	CollisionPrediction Prediction;
+	Prediction.PreventionDuration = PreventionDuration;
+	Prediction.TimeToHit = PreventionDuration;
+
+	Prediction.HaveCollision = FindMostDangerousCollision(Prediction.CandidateActor, Prediction.Location, Prediction.TimeToHit, Prediction.InterceptDepth,
+														  Ship, IgnoreConfig, SpeedLimit, UsePredictedHostility);
+
+	return Prediction;
+}
+
 FVector PilotHelper::AnticollisionCorrection(AFlareSpacecraft* Ship, FVector InitialVelocity, float PreventionDuration, AnticollisionConfig Config, float SpeedLimit, bool& IsIntersecting, AActor*& MostDangerousCandidateActor)
 {
 	SCOPE_CYCLE_COUNTER(STAT_PilotHelper_AnticollisionCorrection);
@@ -199,15 +232,19 @@ FVector PilotHelper::AnticollisionCorrection(AFlareSpacecraft* Ship, FVector Ini
 	}
 #endif
 
-	// Output data
-	FVector MostDangerousLocation;
-	float MostDangerousTimeToHit = PreventionDuration;
-	float MostDangerousIntersectDepth;
+	CollisionPrediction Prediction = PredictCollision(Ship, PreventionDuration, Config, SpeedLimit);
+	return AnticollisionCorrection(Ship, InitialVelocity, Prediction, Config, IsIntersecting, MostDangerousCandidateActor);
+}
 
-	bool HaveCollision = FindMostDangerousCollision(MostDangerousCandidateActor, MostDangerousLocation, MostDangerousTimeToHit,MostDangerousIntersectDepth,
-													Ship, Config, SpeedLimit);
+FVector PilotHelper::AnticollisionCorrection(AFlareSpacecraft* Ship, FVector InitialVelocity, CollisionPrediction const& Prediction, AnticollisionConfig Config, bool& IsIntersecting, AActor*& MostDangerousCandidateActor)
+{
+	// Output data
+	FVector MostDangerousLocation = Prediction.Location;
+	float MostDangerousTimeToHit = Prediction.TimeToHit;
+	float PreventionDuration = Prediction.PreventionDuration;
+	MostDangerousCandidateActor = Prediction.CandidateActor;
 
-	if(!HaveCollision)
+	if(!Prediction.HaveCollision)
 	{
 #ifdef DEBUG_ANTICOLLISION
 		if (Ship->IsPlayerShip())
@@ -218,6 +255,13 @@ FVector PilotHelper::AnticollisionCorrection(AFlareSpacecraft* Ship, FVector Ini
 		return InitialVelocity;
 	}
 
+	// The candidate may have been destroyed since the prediction
+	if (MostDangerousCandidateActor && (!IsValid(MostDangerousCandidateActor) || !MostDangerousCandidateActor->GetRootComponent()))
+	{
+		MostDangerousCandidateActor = NULL;
+		return InitialVelocity;
+	}
+
 	// Avoid the most dangerous target
 	if (MostDangerousCandidateActor)
 	{
@@ -425,37 +469,17 @@ PilotHelper::PilotTarget PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, stru
 	bool HasSmallSalvager = Ship->GetParent()->GetWeaponsSystem()->IsDamageTypeInAvailableWeaponDamageTypes(EFlareShellDamageType::LightSalvage);
 	bool HasLargeSalvager = Ship->GetParent()->GetWeaponsSystem()->IsDamageTypeInAvailableWeaponDamageTypes(EFlareShellDamageType::HeavySalvage);
 
-	for (AFlareSpacecraft* ShipCandidate :Ship->GetGame()->GetActiveSector()->GetSpacecrafts())
+	// Hostile, living spacecrafts inside the sector limits, shared by the whole company this tick
+	for (const FFlareTargetCandidate& Candidate : Ship->GetGame()->GetActiveSector()->GetTargetCandidates(Ship->GetCompany()))
 	{
-		if (!IsValid(ShipCandidate))
-		{
-			continue;
-		}
+		AFlareSpacecraft* ShipCandidate = Candidate.Spacecraft;
 
 		if (Preferences.IgnoreList.Contains(PilotTarget(ShipCandidate)))
 		{
 			continue;
 		}
 
-		if (!ShipCandidate->IsHostile(Ship->GetCompany()))
-		{
-			// Ignore not hostile ships
-			continue;
-		}
-
-		if (!ShipCandidate->GetParent()->GetDamageSystem()->IsAlive())
-		{
-			// Ignore destroyed ships
-			continue;
-		}
-
-		if (ShipCandidate->GetActorLocation().Size() > ShipCandidate->GetGame()->GetActiveSector()->GetSectorLimits())
-		{
-			// Ignore out limit ships
-			continue;
-		}
-
-		if (Preferences.IgnoreStation && ShipCandidate->IsStation())
+		if (Preferences.IgnoreStation && Candidate.IsStation)
 		{
 			continue;
 		}
@@ -468,34 +492,26 @@ PilotHelper::PilotTarget PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, stru
 
 		StateScore = Preferences.TargetStateWeight;
 
-		if (ShipCandidate->GetParent()->GetSize() == EFlarePartSize::L)
+		if (Candidate.Size == EFlarePartSize::L)
 		{
 			StateScore *= Preferences.IsLarge;
 		}
 
-		else if (ShipCandidate->GetParent()->GetSize() == EFlarePartSize::S)
+		else if (Candidate.Size == EFlarePartSize::S)
 		{
 			StateScore *= Preferences.IsSmall;
 		}
 
-		if (ShipCandidate->GetParent()->IsStation())
+		if (Candidate.IsStation)
 		{
-			if (Ship->GetCompany()->IsPlayerCompany() || (ShipCandidate->GetCompany()->IsPlayerCompany() && ShipCandidate->GetCompany()->GetRetaliation() > 0))
-			{
-				// All non player company, attack player station if there is retaliation
-				StateScore *= Preferences.IsStation;
-			}
-			else
-			{
-				StateScore *= 0;
-			}
+			StateScore *= Candidate.CanTargetStation ? Preferences.IsStation : 0;
 		}
 		else
 		{
 			StateScore *= Preferences.IsNotStation;
 		}
 
-		if (ShipCandidate->GetParent()->IsMilitary())
+		if (Candidate.IsMilitary)
 		{
 			StateScore *= Preferences.IsMilitary;
 		}
@@ -504,7 +520,7 @@ PilotHelper::PilotTarget PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, stru
 			StateScore *= Preferences.IsNotMilitary;
 		}
 
-		if (IsTargetDangerous(PilotTarget(ShipCandidate)))
+		if (Candidate.IsDangerous)
 		{
 			StateScore *= Preferences.IsDangerous;
 		}
@@ -513,7 +529,7 @@ PilotHelper::PilotTarget PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, stru
 			StateScore *= Preferences.IsNotDangerous;
 		}
 
-		if (ShipCandidate->GetParent()->GetDamageSystem()->IsStranded())
+		if (Candidate.IsStranded)
 		{
 			StateScore *= Preferences.IsStranded;
 		}
@@ -522,11 +538,11 @@ PilotHelper::PilotTarget PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, stru
 			StateScore *= Preferences.IsNotStranded;
 		}
 
-		if (ShipCandidate->GetParent()->GetDamageSystem()->IsUncontrollable() && ShipCandidate->GetParent()->GetDamageSystem()->IsDisarmed())
+		if (Candidate.IsUncontrollable && Candidate.IsDisarmed)
 		{
-			if (ShipCandidate->IsMilitary())
+			if (Candidate.IsMilitary)
 			{
-				if (ShipCandidate->GetSize() == EFlarePartSize::S)
+				if (Candidate.Size == EFlarePartSize::S)
 				{
 					StateScore *= Preferences.IsUncontrollableSmallMilitary;
 				}
@@ -546,21 +562,14 @@ PilotHelper::PilotTarget PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, stru
 		}
 
 		// Divise by 25 the stateScore per current incoming missile
-
-		int32 IncomingBombs = ShipCandidate->GetIncomingActiveBombQuantity();
-		if (IncomingBombs > 0)
+		if (Candidate.IncomingBombs > 0)
 		{
-			StateScore /= (25 * IncomingBombs);
+			StateScore /= (25 * Candidate.IncomingBombs);
 		}
 
-//		if(ShipCandidate->GetParent()->IsHarpooned())
-		if(ShipCandidate->GetParent()->GetCapturePointsMap().Num() > 0)	
+		// Harpooned uncontrollable ships are never candidates
+		if (Candidate.IsHarpooned)
 		{
-			if(ShipCandidate->GetParent()->GetDamageSystem()->IsUncontrollable())
-			{
-				// Never target harponned uncontrollable ships
-				continue;
-			}
 			StateScore *=  Preferences.IsHarpooned;
 		}
 
@@ -568,14 +577,14 @@ PilotHelper::PilotTarget PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, stru
 			StateScore *=  Preferences.LastTargetWeight;
 		}
 
-		if (ShipCandidate->GetDescription()->IsUncapturable)
+		if (Candidate.IsUncapturable)
 		{
-			if (ShipCandidate->GetSize() == EFlarePartSize::L && HasLargeSalvager)
+			if (Candidate.Size == EFlarePartSize::L && HasLargeSalvager)
 			{
 				StateScore *= 0.50f;
 			}
 
-			else if (ShipCandidate->GetSize() == EFlarePartSize::S && HasSmallSalvager)
+			else if (Candidate.Size == EFlarePartSize::S && HasSmallSalvager)
 			{
 				StateScore *= 0.50f;
 			}
@@ -591,7 +600,7 @@ PilotHelper::PilotTarget PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, stru
 			DistanceScore = Preferences.DistanceWeight * (1.f - (Distance / Preferences.MaxDistance));
 		}
 
-		if (Preferences.AttackTarget && IsTargetDangerous(PilotTarget(ShipCandidate)) && ShipCandidate->GetPilot()->GetPilotTarget().Is(Preferences.AttackTarget))
+		if (Preferences.AttackTarget && Candidate.IsDangerous && ShipCandidate->GetPilot()->GetPilotTarget().Is(Preferences.AttackTarget))
 		{
 			AttackTargetScore = Preferences.AttackTargetWeight;
 		}
@@ -600,7 +609,7 @@ PilotHelper::PilotTarget PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, stru
 			AttackTargetScore = 0.0f;
 		}
 
-		if(IsTargetDangerous(PilotTarget(ShipCandidate)) && ShipCandidate->GetPilot()->GetPilotTarget().Is(Ship))
+		if(Candidate.IsDangerous && ShipCandidate->GetPilot()->GetPilotTarget().Is(Ship))
 		{
 			StateScore *= Preferences.AttackMeWeight;
 		}
@@ -637,9 +646,14 @@ PilotHelper::PilotTarget PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, stru
 		}
 	}
 
-	for (AFlareBomb* BombCandidate :Ship->GetGame()->GetActiveSector()->GetBombs())
+	// Bombs beyond MaxBombDistance are never targeted
+	TArray<FFlareBroadphaseBody> BombBodies;
+	Ship->GetGame()->GetActiveSector()->GetBroadphase().QueryRadius(Preferences.BaseLocation, Preferences.MaxBombDistance, EFlareBroadphaseBody::Bomb, BombBodies);
+
+	for (const FFlareBroadphaseBody& BombBody : BombBodies)
 	{
-		if (BombCandidate->IsSafeDestroying())
+		AFlareBomb* BombCandidate = Cast<AFlareBomb>(BombBody.Actor);
+		if (!IsValid(BombCandidate) || BombCandidate->IsSafeDestroying())
 		{
 			continue;
 		}
@@ -123,11 +123,30 @@ struct PilotHelper
 
 
 
+	/** Result of a collision search, computed ahead of the trajectory correction */
+	struct CollisionPrediction
+	{
+		CollisionPrediction(): HaveCollision(false), CandidateActor(nullptr), Location(FVector::ZeroVector), TimeToHit(0), InterceptDepth(0), PreventionDuration(0) {}
+		bool HaveCollision;
+		AActor* CandidateActor;
+		FVector Location;
+		float TimeToHit;
+		float InterceptDepth;
+		float PreventionDuration;
+	};
+
 	/** Correct trajectory to avoid incoming ships */
 	static FVector AnticollisionCorrection(AFlareSpacecraft* Ship, FVector InitialVelocity, float PreventionDuration, AnticollisionConfig IgnoreConfig, float SpeedLimit, bool& IsIntersecting, AActor*& MostDangerousCandidateActor);
 
+	/** Correct trajectory to avoid incoming ships, using a collision search that was already done */
+	static FVector AnticollisionCorrection(AFlareSpacecraft* Ship, FVector InitialVelocity, CollisionPrediction const& Prediction, AnticollisionConfig IgnoreConfig, bool& IsIntersecting, AActor*& MostDangerousCandidateActor);
+
+	/** Run the collision search only, without touching the ship.
+	 *  Safe to call from worker threads with UsePredictedHostility, once UFlareSector::PredictPilotCollisions has built the broadphase and hostilities. */
+	static CollisionPrediction PredictCollision(AFlareSpacecraft* Ship, float PreventionDuration, AnticollisionConfig IgnoreConfig, float SpeedLimit, bool UsePredictedHostility = false);
+
 	static bool FindMostDangerousCollision(AActor*& MostDangerousCandidateActor, FVector& MostDangerousLocation, float& MostDangerousTimeToHit, float& MostDangerousInterseptDepth,
-										   AFlareSpacecraft* Ship, AnticollisionConfig IgnoreConfig, float SpeedLimit);
+										   AFlareSpacecraft* Ship, AnticollisionConfig IgnoreConfig, float SpeedLimit, bool UsePredictedHostility = false);
 
 	static bool IsAnticollisionImminent(AFlareSpacecraft* Ship, float PreventionDuration, float SpeedLimit);
 	static bool IsSectorExitImminent(AFlareSpacecraft* Ship, float PreventionDuration);
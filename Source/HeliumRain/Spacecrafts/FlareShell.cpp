@@ -33,6 +33,7 @@ AFlareShell::AFlareShell(const class FObjectInitializer& PCIP) : Super(PCIP)
 	PrimaryActorTick.TickGroup = TG_PrePhysics;
 	SetActorTickInterval(0.025f);
 	ManualTurret = false;
+	SimulationIndex = INDEX_NONE;
 }
  
 /*----------------------------------------------------
@@ -66,10 +67,9 @@ void AFlareShell::Initialize(UFlareWeapon* Weapon, const FFlareSpacecraftCompone
 	float AmmoVelocity = Description->WeaponCharacteristics.GunCharacteristics.AmmoVelocity;
 	float KineticEnergy = Description->WeaponCharacteristics.GunCharacteristics.KineticEnergy;
 	
-	ShellVelocity = ParentVelocity + ShootDirection * AmmoVelocity * 100;
+	FVector ShellVelocity = ParentVelocity + ShootDirection * AmmoVelocity * 100;
 	ShellMass = 2 * KineticEnergy * 1000 / FMath::Square(AmmoVelocity); // ShellPower is in Kilo-Joule, reverse kinetic energy equation
 
-	LastLocation = GetActorLocation();
 	// Spawn the flight effects
 	if (TracerShell)
 	{
@@ -97,6 +97,11 @@ void AFlareShell::Initialize(UFlareWeapon* Weapon, const FFlareSpacecraftCompone
 
 	ManualTurret = ParentWeapon->GetSpacecraft()->GetWeaponsSystem()->GetActiveWeaponType() == EFlareWeaponGroupType::WG_TURRET;
 	LocalSector = ParentWeapon->GetSpacecraft()->GetGame()->GetActiveSector();
+
+	// Flight is simulated by the sector, the actor only ticks to process detonations
+	SetActorTickEnabled(false);
+	LocalSector->GetShellSimulation().AddShell(this, GetActorLocation(), ShellVelocity,
+		Description->WeaponCharacteristics.FuzeType == EFlareShellFuzeType::Proximity);
 }
 
 void AFlareShell::Tick(float DeltaSeconds)
@@ -104,35 +109,18 @@ void AFlareShell::Tick(float DeltaSeconds)
 	if (IsDetonating)
 	{
 		ProcessCurrentDetonations();
-		return;
 	}
+}
 
-	if(IsSafeDestroyingRunning)
-	{
-		return;
-	}
-/*
-	if (LastTraceHandle._Data.FrameNumber != 0)
-	{
-		FTraceDatum OutData;
-		if (GetWorld()->QueryTraceData(LastTraceHandle, OutData))
-		{
-			// Clear out handle so next tick we don't enter
-			LastTraceHandle._Data.FrameNumber = 0;
-			// trace is finished, do stuff with results
-			DoWorkWithTraceResults(OutData);
-		}
-	}
-*/
-	FVector ActorLocation = GetActorLocation();
-	FVector NextActorLocation = ActorLocation + ShellVelocity * DeltaSeconds;
-	SetActorLocationAndRotation(NextActorLocation, ShellVelocity.Rotation(), false);
+void AFlareShell::UpdateFlightVisuals(FVector Location, FVector Velocity)
+{
+	SetActorLocationAndRotation(Location, Velocity.Rotation(), false);
 
 	// 1 at 100m or less
 	float Scale = 1;
 	float BaseDistance = 10000.f;
 	float MinScale = 0.1f;
-	if(PC->GetShipPawn())
+	if(PC && PC->GetShipPawn())
 	{
 		float LifeRatio = GetLifeSpan() / InitialLifeSpan;
 
@@ -143,7 +131,7 @@ void AFlareShell::Tick(float DeltaSeconds)
 			LifeRatioScale = LifeRatio * 10.f;
 		}
 
-		float Distance = (NextActorLocation - PC->GetShipPawn()->GetActorLocation()).Size();
+		float Distance = (Location - PC->GetShipPawn()->GetActorLocation()).Size();
 		if(Distance > BaseDistance)
 		{
 			Scale = (Distance / BaseDistance) * ((1.f-MinScale) * BaseDistance / Distance +MinScale) * LifeRatioScale;
@@ -151,37 +139,6 @@ void AFlareShell::Tick(float DeltaSeconds)
 	}
 
 	SetActorRelativeScale3D(FVector(0.6 + Scale * 0.4 , Scale, Scale));
-
-	if (ShellDescription)
-	{
-
-		FHitResult HitResult(ForceInit);
-		//TODO get async trace going without left over projectiles
-//		RequestTrace(ActorLocation, NextActorLocation);
-
-		if (Trace(ActorLocation, NextActorLocation, HitResult))
-//		if(PreviousHitResult.GetActor() != nullptr)
-		{
-			OnImpact(HitResult, ShellVelocity);
-//			OnImpact(PreviousHitResult, ShellVelocity);
-		}
-
-		if (ShellDescription->WeaponCharacteristics.FuzeType == EFlareShellFuzeType::Proximity)
-		{
-			//FLOGV("%s SecureTime: %f ActiveTime: %f",*GetName(), SecureTime, ActiveTime);
-
-
-			if (SecureTime > 0)
-			{
-				SecureTime -= DeltaSeconds;
-			}
-			else if (ActiveTime > 0)
-			{
-				CheckFuze(ActorLocation, NextActorLocation);
-				ActiveTime -= DeltaSeconds;
-			}
-		}
-	}
 }
 
 void AFlareShell::CheckFuze(FVector ActorLocation, FVector NextActorLocation)
@@ -217,7 +174,7 @@ void AFlareShell::CheckFuze(FVector ActorLocation, FVector NextActorLocation)
 		//FLOGV("Proximity fuze near ship for %s",*GetHumanReadableName());
 
 
-		FVector ShellDirection = ShellVelocity.GetUnsafeNormal();
+		FVector ShellDirection = (NextActorLocation - ActorLocation).GetUnsafeNormal();
 		FVector CandidateOffset = TargetCandidate.GetActorLocation() - ActorLocation;
 		FVector NextCandidateOffset = TargetCandidate.GetActorLocation() - NextActorLocation;
 
@@ -307,55 +264,40 @@ void AFlareShell::CheckFuze(FVector ActorLocation, FVector NextActorLocation)
 		}
 	};
 
-	// Check targets against every actor in the level, using index-based, not for-range, because this can affect the container
+	// Check targets near the shell path, in the sector order
+	TArray<FFlareBroadphaseBody> Bodies;
+	LocalSector->GetBroadphase().QuerySegment(ActorLocation, NextActorLocation, FMath::Sqrt(NearThresoldSquared),
+		EFlareBroadphaseBody::Spacecraft | EFlareBroadphaseBody::Bomb | EFlareBroadphaseBody::Meteorite, Bodies);
 
 	PilotHelper::PilotTarget FuzeTarget;
-	UFlareSector* CurrentSector = LocalSector;
-	for (int32 Index = 0; Index < CurrentSector->GetSpacecrafts().Num(); Index++)
+	for (const FFlareBroadphaseBody& Body : Bodies)
 	{
 		if (IsDetonating || IsSafeDestroyingRunning)
 		{
 			break;
 		}
-		AFlareSpacecraft* Checker = CurrentSector->GetSpacecrafts()[Index];
-		if (Checker)
-		{
-			FuzeTarget.Clear();
-			FuzeTarget.SetSpacecraft(Checker);
-			CheckTarget(FuzeTarget);
-		}
-	}
-
-	for (int32 Index = 0; Index < CurrentSector->GetBombs().Num(); Index++)
-	{
-		if (IsDetonating || IsSafeDestroyingRunning)
-		{
-			break;
-		}
-
-		AFlareBomb* Checker = CurrentSector->GetBombs()[Index];
-		if (Checker)
-		{
-			FuzeTarget.Clear();
-			FuzeTarget.SetBomb(Checker);
-			CheckTarget(FuzeTarget);
-		}
-	}
 
-	for (int32 Index = 0; Index < CurrentSector->GetMeteorites().Num(); Index++)
-	{
-		if (IsDetonating || IsSafeDestroyingRunning)
+		if (!IsValid(Body.Actor))
 		{
-			break;
+			continue;
 		}
 
-		AFlareMeteorite* Checker = CurrentSector->GetMeteorites()[Index];
-		if (Checker)
+		FuzeTarget.Clear();
+		switch (Body.Type)
 		{
-			FuzeTarget.Clear();
-			FuzeTarget.SetMeteorite(Checker);
-			CheckTarget(FuzeTarget);
+			case EFlareBroadphaseBody::Spacecraft:
+				FuzeTarget.SetSpacecraft(Cast<AFlareSpacecraft>(Body.Actor));
+				break;
+			case EFlareBroadphaseBody::Bomb:
+				FuzeTarget.SetBomb(Cast<AFlareBomb>(Body.Actor));
+				break;
+			case EFlareBroadphaseBody::Meteorite:
+				FuzeTarget.SetMeteorite(Cast<AFlareMeteorite>(Body.Actor));
+				break;
+			default:
+				break;
 		}
+		CheckTarget(FuzeTarget);
 	}
 }
 
@@ -384,8 +326,8 @@ void AFlareShell::OnImpact(const FHitResult& HitResult, const FVector& HitVeloci
 			if (RemainingVelocity > 0)
 			{
 				DestroyProjectile = false;
-				FVector BounceDirection = ShellVelocity.GetUnsafeNormal().MirrorByVector(HitResult.ImpactNormal);
-				ShellVelocity = BounceDirection * RemainingVelocity * 100;
+				FVector BounceDirection = HitVelocity.GetUnsafeNormal().MirrorByVector(HitResult.ImpactNormal);
+				LocalSector->GetShellSimulation().SetMotion(this, HitResult.Location, BounceDirection * RemainingVelocity * 100);
 				SetActorLocation(HitResult.Location);
 			}
 			else
@@ -408,17 +350,17 @@ void AFlareShell::OnImpact(const FHitResult& HitResult, const FVector& HitVeloci
 					float ImpulseForce = 1000 * ShellDescription->WeaponCharacteristics.ExplosionPower * ShellDescription->WeaponCharacteristics.AmmoDamageRadius;
 
 					// Physics impulse
-					Spacecraft->Airframe->AddImpulseAtLocation( ShellVelocity.GetUnsafeNormal(), HitResult.Location);
+					Spacecraft->Airframe->AddImpulseAtLocation( HitVelocity.GetUnsafeNormal(), HitResult.Location);
 				}
 				else if (Asteroid)
 				{
 					float ImpulseForce = 1000 * ShellDescription->WeaponCharacteristics.ExplosionPower * ShellDescription->WeaponCharacteristics.AmmoDamageRadius;
-					Asteroid->GetAsteroidComponent()->AddImpulseAtLocation( ShellVelocity.GetUnsafeNormal(), HitResult.Location);
+					Asteroid->GetAsteroidComponent()->AddImpulseAtLocation( HitVelocity.GetUnsafeNormal(), HitResult.Location);
 				}
 				else if (Meteorite)
 				{
 					float ImpulseForce = 1000 * ShellDescription->WeaponCharacteristics.ExplosionPower * ShellDescription->WeaponCharacteristics.AmmoDamageRadius;
-					Meteorite->GetMeteoriteComponent()->AddImpulseAtLocation( ShellVelocity.GetUnsafeNormal(), HitResult.Location);
+					Meteorite->GetMeteoriteComponent()->AddImpulseAtLocation( HitVelocity.GetUnsafeNormal(), HitResult.Location);
 					Meteorite->ApplyDamage(ShellDescription->WeaponCharacteristics.ExplosionPower,
 										   ShellDescription->WeaponCharacteristics.AmmoDamageRadius, HitResult.Location, EFlareDamage::DAM_HEAT, ParentWeapon->GetSpacecraft()->GetParent(), GetName());
 				}
@@ -477,6 +419,7 @@ void AFlareShell::DetonateAt(FVector DetonatePoint)
 	DetonatePoint);
 
 	IsDetonating = true;
+	SetActorTickEnabled(true);
 	DetonationSpacecraftCandidates.Empty();
 	DetonationBombCandidates.Empty();
 	DetonationMeteoriteCandidates.Empty();
@@ -969,6 +912,11 @@ void AFlareShell::SafeDestroy()
 {
 	if (!IsSafeDestroyingRunning)
 	{
+		if (LocalSector && SimulationIndex != INDEX_NONE)
+		{
+			LocalSector->GetShellSimulation().RemoveShell(this);
+		}
+
 		IsSafeDestroyingRunning = true;
 		this->SetActorHiddenInGame(true);
 		this->SetActorEnableCollision(false);
@@ -1050,8 +998,10 @@ UFlareWeapon* AFlareShell::GetParentWeapon()
 
 void AFlareShell::SetFuzeTimer(float TargetSecureTime, float TargetActiveTime)
 {
-	SecureTime = TargetSecureTime;
-	ActiveTime = TargetActiveTime;
+	if (LocalSector)
+	{
+		LocalSector->GetShellSimulation().SetFuzeTimer(this, TargetSecureTime, TargetActiveTime);
+	}
 }
 
 void AFlareShell::SetPause(bool Pause)
@@ -41,6 +41,9 @@ public:
 
 	virtual void SetFuzeTimer(float TargetSecureTime, float TargetActiveTime);
 
+	/** Move the shell actor to its simulated location */
+	void UpdateFlightVisuals(FVector Location, FVector Velocity);
+
 	virtual void CheckFuze(FVector ActorLocation, FVector NextActorLocation);
 
 	virtual void SafeDestroy();
@@ -94,15 +97,14 @@ protected:
 	float                                    ImpactEffectScale;
 
 	// Shell data
-	FVector                                        ShellVelocity;
 	const FFlareSpacecraftComponentDescription*    ShellDescription;
-	FVector                                        LastLocation;	
 	float                                          ShellMass;
 	bool                                           TracerShell;
 	bool                                           Armed;
 	float                                          MinEffectiveDistance;
-	float                                          SecureTime;
-	float                                          ActiveTime;
+
+	/** Index in the sector shell simulation, while flying */
+	int32                                          SimulationIndex;
 
 	// References
 	UPROPERTY()
@@ -123,4 +125,14 @@ protected:
 
 public:
 	UFlareWeapon* GetParentWeapon();
+
+	int32 GetSimulationIndex() const
+	{
+		return SimulationIndex;
+	}
+
+	void SetSimulationIndex(int32 Index)
+	{
+		SimulationIndex = Index;
+	}
 };
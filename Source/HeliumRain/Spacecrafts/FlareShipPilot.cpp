@@ -8,6 +8,7 @@
 
 #include "../Game/FlareCompany.h"
 #include "../Game/FlareGame.h"
+#include "../Game/FlareSector.h"
 #include "../Game/AI/FlareCompanyAI.h"
 #include "../Quests/FlareQuest.h"
 #include "../Quests/FlareQuestStep.h"
@@ -101,6 +102,7 @@ void UFlareShipPilot::Initialize(const FFlareShipPilotSave* Data, UFlareCompany*
 	AttackAngle = FMath::FRandRange(0, 360);
 	LeaderShip = Ship;
 	LastNewCollisionVector = 0;
+	PredictedCollisionFrame = 0;
 
 	PilotTarget = Ship->GetCurrentTarget();
 }
@@ -263,7 +265,7 @@ void UFlareShipPilot::ArmedStationPilot(float DeltaSeconds)
 	else
 	{
 		TimeUntilNextHostileTargetSwitch -= DeltaSeconds;
-		if (TimeUntilNextHostileTargetSwitch <= 0)
+		if (TimeUntilNextHostileTargetSwitch <= 0 && CanSearchTarget())
 		{
 			FindBestHostileTarget(EFlareCombatTactic::AttackMilitary);
 		}
@@ -275,6 +277,17 @@ void UFlareShipPilot::ArmedStationPilot(float DeltaSeconds)
 	}
 }
 
+bool UFlareShipPilot::CanSearchTarget()
+{
+	// Pilots without a target always search, others share the sector budget and may wait for a later tick
+	if (!PilotTarget.IsValid())
+	{
+		return true;
+	}
+
+	return Ship->GetGame()->GetActiveSector()->ConsumeTargetSearch();
+}
+
 void UFlareShipPilot::ClearTarget()
 {
 	PilotTarget.Clear();
@@ -336,7 +349,7 @@ void UFlareShipPilot::MilitaryPilot(float DeltaSeconds)
 		TimeUntilNextComponentSwitch -= DeltaSeconds;
 		TimeUntilNextHostileTargetSwitch -= DeltaSeconds;
 
-		if (TimeUntilNextHostileTargetSwitch <= 0)
+		if (TimeUntilNextHostileTargetSwitch <= 0 && CanSearchTarget())
 		{
 			//todo: Add neccessary events so that target checks out-side of combat are no longer required
 			if (!LeaderShip || LeaderShip->GetParent()->GetDamageSystem()->IsDisarmed())
@@ -1365,6 +1378,25 @@ void UFlareShipPilot::IdlePilot(float DeltaSeconds)
     //FLOGV("%s Leader ship LinearTargetVelocity=%s", *LinearTargetVelocity.ToString());
 }
 
+bool UFlareShipPilot::IsCollisionPredictionNeeded(float DeltaSeconds) const
+{
+	float TickRate = (Ship->GetSize() == EFlarePartSize::L) ? PILOT_AI_TICKRATE_LARGE : PILOT_AI_TICKRATE_SMALL;
+
+	return PreviousTick + DeltaSeconds >= TickRate
+		&& LastNewCollisionVector - DeltaSeconds <= 0
+		&& !Ship->IsStation()
+		&& !Ship->GetParent()->GetDamageSystem()->IsUncontrollable()
+		&& !Ship->GetNavigationSystem()->IsDocked();
+}
+
+void UFlareShipPilot::PredictCollision()
+{
+	float PreventionDuration = RequiredAntiCollisionPreviousTick ? Ship->GetPreferedAnticollisionTime() : Ship->GetCautiousAnticollisionTime();
+
+	PredictedCollision = PilotHelper::PredictCollision(Ship, PreventionDuration, PilotHelper::AnticollisionConfig(), PILOT_ANTICOLLISION_SPEED, true);
+	PredictedCollisionFrame = GFrameCounter;
+}
+
 FVector UFlareShipPilot::TryAnticollisionCorrection(AFlareSpacecraft* TargetShip, FVector InitialVelocity, PilotHelper::AnticollisionConfig IgnoreConfig,float DeltaSeconds)
 {
 	SCOPE_CYCLE_COUNTER(STAT_FlareShipPilot_TryAntiCollision);
@@ -1374,8 +1406,23 @@ FVector UFlareShipPilot::TryAnticollisionCorrection(AFlareSpacecraft* TargetShip
 	{
 		AActor* MostDangerousCandidateActor = NULL;
 		bool IsIntersecting = false;
+		float PreventionDuration = RequiredAntiCollisionPreviousTick ? TargetShip->GetPreferedAnticollisionTime() : TargetShip->GetCautiousAnticollisionTime();
+		FVector CollisionAlteredVector;
 
-		FVector CollisionAlteredVector = PilotHelper::AnticollisionCorrection(TargetShip, LinearTargetVelocity, RequiredAntiCollisionPreviousTick ? TargetShip->GetPreferedAnticollisionTime() : TargetShip->GetCautiousAnticollisionTime(), IgnoreConfig, PILOT_ANTICOLLISION_SPEED, IsIntersecting, MostDangerousCandidateActor);
+		// Use the search done by the sector this frame if it matches this request
+		if (PredictedCollisionFrame == GFrameCounter
+		 && TargetShip == Ship
+		 && IgnoreConfig.SpacecraftToIgnore == NULL
+		 && !IgnoreConfig.IgnoreAllStations
+		 && PredictedCollision.PreventionDuration == PreventionDuration)
+		{
+			CollisionAlteredVector = PilotHelper::AnticollisionCorrection(TargetShip, LinearTargetVelocity, PredictedCollision, IgnoreConfig, IsIntersecting, MostDangerousCandidateActor);
+		}
+		else
+		{
+			CollisionAlteredVector = PilotHelper::AnticollisionCorrection(TargetShip, LinearTargetVelocity, PreventionDuration, IgnoreConfig, PILOT_ANTICOLLISION_SPEED, IsIntersecting, MostDangerousCandidateActor);
+		}
+		PredictedCollisionFrame = 0;
 
 //		if (MostDangerousCandidateActor && IsIntersecting)
 		PreviousAntiCollisionVector = CollisionAlteredVector;
@@ -27,6 +27,12 @@ public:
 
 	virtual void TickPilot(float DeltaSeconds);
 
+	/** Check whether the next tick will search for collisions */
+	bool IsCollisionPredictionNeeded(float DeltaSeconds) const;
+
+	/** Search for collisions ahead of the next tick. Only reads the sector, so that pilots can run this in parallel. */
+	void PredictCollision();
+
 	/** Initialize this pilot and register the master ship object */
 	virtual void Initialize(const FFlareShipPilotSave* Data, UFlareCompany* Company, AFlareSpacecraft* OwnerShip);
 
@@ -43,6 +49,9 @@ protected:
 
 	virtual void ArmedStationPilot(float DeltaSeconds);
 
+	/** Check if a full target search can run now, or should wait for a later tick */
+	bool CanSearchTarget();
+
 	virtual void MilitaryPilot(float DeltaSeconds);
 
 	virtual void CargoPilot(float DeltaSeconds);
@@ -174,6 +183,10 @@ protected:
 	float										 CollisionVectorReactionTimeFast;
 	float										 CollisionVectorReactionTimeSlow;
 
+	// Collision search done ahead of the tick, only valid during the frame it was done in
+	PilotHelper::CollisionPrediction             PredictedCollision;
+	uint64                                       PredictedCollisionFrame;
+
 	UPROPERTY()
 	AFlareSpacecraft*							 LeaderShip;
 
@@ -620,6 +620,13 @@ void UFlareSimulatedSpacecraft::Reload()
 {
 	Save();
 	Load(SpacecraftData);
+
+	// Factories may have changed
+	if (IsStation() && CurrentSector)
+	{
+		CurrentSector->InvalidateTradeStationIndex();
+	}
+	Game->GetGameWorld()->InvalidateEconomySnapshot();
 }
 
 void UFlareSimulatedSpacecraft::SetImmatriculationReplacementTo(FName NewImmatriculationValue)
@@ -2587,6 +2594,9 @@ void UFlareSimulatedSpacecraft::UpdateShipyardProduction()
 		return;
 	}
 
+	// Ship orders change the shipyard needs
+	Game->GetGameWorld()->InvalidateEconomySnapshot();
+
 	TArray<int32> IndexToRemove;
 
 	int32 Index = 0;
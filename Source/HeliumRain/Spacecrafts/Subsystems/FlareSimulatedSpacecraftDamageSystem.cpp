@@ -358,17 +358,33 @@ float UFlareSimulatedSpacecraftDamageSystem::Refill(FFlareSpacecraftComponentDes
 float UFlareSimulatedSpacecraftDamageSystem::ApplyDamage(FFlareSpacecraftComponentDescription* ComponentDescription,
 						  FFlareSpacecraftComponentSave* ComponentData,
 						  float Energy, EFlareDamage::Type DamageType, UFlareSimulatedSpacecraft* DamageSource)
+{
+	FFlareComponentDamage Damage = ApplyComponentDamage(ComponentDescription, ComponentData, Energy, DamageType, DamageSource);
+	ApplyDamageConsequences(Damage);
+	return Damage.GetInflictedDamageRatio();
+}
+
+FFlareComponentDamage UFlareSimulatedSpacecraftDamageSystem::ApplyComponentDamage(FFlareSpacecraftComponentDescription* ComponentDescription,
+						  FFlareSpacecraftComponentSave* ComponentData,
+						  float Energy, EFlareDamage::Type DamageType, UFlareSimulatedSpacecraft* DamageSource)
 {
 	SCOPE_CYCLE_COUNTER(STAT_FlareSimulatedDamageSystem_ApplyDamage);
 
-	float InflictedDamageRatio = 0;
+	FFlareComponentDamage Damage;
+	Damage.ComponentDescription = ComponentDescription;
+	Damage.ComponentData = ComponentData;
+	Damage.Energy = Energy;
+	Damage.EffectiveEnergy = 0;
+	Damage.DamageType = DamageType;
+	Damage.DamageSource = DamageSource;
 
 	// Apply damage
-	float StateBeforeDamage = GetDamageRatio(ComponentDescription, ComponentData);
+	Damage.StateBeforeDamage = GetDamageRatio(ComponentDescription, ComponentData);
+	Damage.StateAfterDamage = Damage.StateBeforeDamage;
 
-	if (StateBeforeDamage == 0)
+	if (Damage.StateBeforeDamage == 0)
 	{
-		return 0;
+		return Damage;
 	}
 
 	float EffectiveEnergy;
@@ -397,87 +413,97 @@ float UFlareSimulatedSpacecraftDamageSystem::ApplyDamage(FFlareSpacecraftCompone
 	{
 		ComponentData->Damage = MaxHitPoints;
 	}
-	float StateAfterDamage = GetDamageRatio(ComponentDescription, ComponentData);
-	InflictedDamageRatio = StateBeforeDamage - StateAfterDamage;
+	Damage.EffectiveEnergy = EffectiveEnergy;
+	Damage.StateAfterDamage = GetDamageRatio(ComponentDescription, ComponentData);
 	SetDamageDirty(ComponentDescription);
 
-	if (EffectiveEnergy > 0)
+	LastDamageCause = DamageCause(DamageSource, DamageType);
+
+	return Damage;
+}
+
+void UFlareSimulatedSpacecraftDamageSystem::ApplyDamageConsequences(const FFlareComponentDamage& Damage)
+{
+	if (Damage.EffectiveEnergy <= 0)
+	{
+		return;
+	}
+
+	float InflictedDamageRatio = Damage.GetInflictedDamageRatio();
+	float EffectiveEnergy = Damage.EffectiveEnergy;
+	EFlareDamage::Type DamageType = Damage.DamageType;
+	UFlareSimulatedSpacecraft* DamageSource = Damage.DamageSource;
+
+	CombatLog::SpacecraftComponentDamaged(Spacecraft, Damage.ComponentData, Damage.ComponentDescription, Damage.Energy, EffectiveEnergy, DamageType, Damage.StateBeforeDamage, Damage.StateAfterDamage);
+
+	// This ship has been damaged and someone is to blame
+	if (DamageSource != NULL && DamageSource->GetCompany() != Spacecraft->GetCompany())
 	{
-		CombatLog::SpacecraftComponentDamaged(Spacecraft, ComponentData, ComponentDescription, Energy, EffectiveEnergy, DamageType, StateBeforeDamage, StateAfterDamage);
+		UFlareCompany* PlayerCompany = Spacecraft->GetGame()->GetPC()->GetCompany();
+		float ReputationCost = 0.f;
 
-		// This ship has been damaged and someone is to blame
-		if (DamageSource != NULL && DamageSource->GetCompany() != Spacecraft->GetCompany())
+		if (Spacecraft->IsStation())
 		{
-			UFlareCompany* PlayerCompany = Spacecraft->GetGame()->GetPC()->GetCompany();
-			float ReputationCost = 0.f;
-
-			if (Spacecraft->IsStation())
+			if(DamageType != EFlareDamage::DAM_Collision)
 			{
-				if(DamageType != EFlareDamage::DAM_Collision)
-				{
-					ReputationCost = -InflictedDamageRatio * 100;
-				}
-				// Retaliation
-				if(DamageSource->GetCompany() == PlayerCompany)
-				{
-					PlayerCompany->AddRetaliation(EffectiveEnergy);
-				}
-				else if(Spacecraft->GetCompany() == PlayerCompany)
-				{
-					PlayerCompany->RemoveRetaliation(EffectiveEnergy);
-				}
+				ReputationCost = -InflictedDamageRatio * 100;
 			}
-			else
+			// Retaliation
+			if(DamageSource->GetCompany() == PlayerCompany)
+			{
+				PlayerCompany->AddRetaliation(EffectiveEnergy);
+			}
+			else if(Spacecraft->GetCompany() == PlayerCompany)
 			{
-				ReputationCost = -InflictedDamageRatio * 2;
+				PlayerCompany->RemoveRetaliation(EffectiveEnergy);
 			}
+		}
+		else
+		{
+			ReputationCost = -InflictedDamageRatio * 2;
+		}
 
 
-			if (ReputationCost != 0
-				&& DamageSource->IsResponsible(DamageType)
-				&& !Spacecraft->GetGame()->IsSkirmish()
-				&& Spacecraft->GetCompany() != PlayerCompany
-				&& Spacecraft->GetCompany() != Spacecraft->GetGame()->GetScenarioTools()->Pirates)
+		if (ReputationCost != 0
+			&& DamageSource->IsResponsible(DamageType)
+			&& !Spacecraft->GetGame()->IsSkirmish()
+			&& Spacecraft->GetCompany() != PlayerCompany
+			&& Spacecraft->GetCompany() != Spacecraft->GetGame()->GetScenarioTools()->Pirates)
+		{
+			UFlareSimulatedSpacecraft* PlayerShip = Spacecraft->GetGame()->GetPC()->GetPlayerShip();
+			// Being shot by enemies is pretty much expected
+			if (!Spacecraft->IsHostile(DamageSource->GetCompany(), true))
 			{
-				UFlareSimulatedSpacecraft* PlayerShip = Spacecraft->GetGame()->GetPC()->GetPlayerShip();
-				// Being shot by enemies is pretty much expected
-				if (!Spacecraft->IsHostile(DamageSource->GetCompany(), true))
-				{
-					// If it's a betrayal, lower attacker's reputation on everyone, give rep to victim
+				// If it's a betrayal, lower attacker's reputation on everyone, give rep to victim
 
-					// Lower attacker's reputation on victim
-					Spacecraft->GetCompany()->GivePlayerReputationToOthers(ReputationCost/2);
-					Spacecraft->GetCompany()->GivePlayerReputation(ReputationCost);
+				// Lower attacker's reputation on victim
+				Spacecraft->GetCompany()->GivePlayerReputationToOthers(ReputationCost/2);
+				Spacecraft->GetCompany()->GivePlayerReputation(ReputationCost);
 
-					Spacecraft->GetGame()->GetPC()->Notify(LOCTEXT("NeutralAttack", "Neutrality violation"),
-						   FText::Format(LOCTEXT("NeutralAttackDescription", "Attacking neutral properties ({0}) will have diplomatic consequences."), UFlareGameTools::DisplaySpacecraftName(Spacecraft)),
-						   FName("neutrality-violation"),
-						   EFlareNotification::NT_Military);
+				Spacecraft->GetGame()->GetPC()->Notify(LOCTEXT("NeutralAttack", "Neutrality violation"),
+					   FText::Format(LOCTEXT("NeutralAttackDescription", "Attacking neutral properties ({0}) will have diplomatic consequences."), UFlareGameTools::DisplaySpacecraftName(Spacecraft)),
+					   FName("neutrality-violation"),
+					   EFlareNotification::NT_Military);
 
 
-				}
-				else if(Spacecraft->IsActive() && Spacecraft->GetActive()->IsInActiveSector() && Spacecraft->GetActive()->GetTimeSinceUncontrollable() > (PlayerShip == DamageSource ? 5.f : 10.f) && !Spacecraft->GetGame()->GetQuestManager()->IsAllowedToDestroy(Spacecraft))
-				{
-					// If an attack on a prisoner, lower attacker's reputation on everyone, give rep to victim
+			}
+			else if(Spacecraft->IsActive() && Spacecraft->GetActive()->IsInActiveSector() && Spacecraft->GetActive()->GetTimeSinceUncontrollable() > (PlayerShip == DamageSource ? 5.f : 10.f) && !Spacecraft->GetGame()->GetQuestManager()->IsAllowedToDestroy(Spacecraft))
+			{
+				// If an attack on a prisoner, lower attacker's reputation on everyone, give rep to victim
 
-					// Lower attacker's reputation on victim
-					Spacecraft->GetCompany()->GivePlayerReputationToOthers(ReputationCost/5);
-					Spacecraft->GetCompany()->GivePlayerReputation(ReputationCost/5);
+				// Lower attacker's reputation on victim
+				Spacecraft->GetCompany()->GivePlayerReputationToOthers(ReputationCost/5);
+				Spacecraft->GetCompany()->GivePlayerReputation(ReputationCost/5);
 
-					Spacecraft->GetGame()->GetPC()->Notify(LOCTEXT("PrisonerAttack", "Attacking prisoners"),
-						   FText::Format(LOCTEXT("PrisonerAttackDescription", "Attacking uncontrollable ships ({0}) will have diplomatic consequences."), UFlareGameTools::DisplaySpacecraftName(Spacecraft)),
-						   FName("prisoner-attack"),
-						   EFlareNotification::NT_Military);
-				}
+				Spacecraft->GetGame()->GetPC()->Notify(LOCTEXT("PrisonerAttack", "Attacking prisoners"),
+					   FText::Format(LOCTEXT("PrisonerAttackDescription", "Attacking uncontrollable ships ({0}) will have diplomatic consequences."), UFlareGameTools::DisplaySpacecraftName(Spacecraft)),
+					   FName("prisoner-attack"),
+					   EFlareNotification::NT_Military);
 			}
 		}
-
-		Spacecraft->GetCompany()->InvalidateCompanyValueCache();
 	}
 
-	LastDamageCause = DamageCause(DamageSource, DamageType);
-
-	return InflictedDamageRatio;
+	Spacecraft->GetCompany()->InvalidateCompanyValueCache();
 }
 
 float UFlareSimulatedSpacecraftDamageSystem::GetTemperature() const
@@ -31,6 +31,23 @@ struct FFlareSpacecraftComponentDescription;
 class UFlareCompany;
 class UFlareSimulatedSpacecraft;
 
+/** Damage applied to a component, with what is needed to apply its consequences later */
+struct FFlareComponentDamage
+{
+	FFlareSpacecraftComponentDescription*       ComponentDescription;
+	FFlareSpacecraftComponentSave*              ComponentData;
+	float                                       Energy;
+	float                                       EffectiveEnergy;
+	float                                       StateBeforeDamage;
+	float                                       StateAfterDamage;
+	EFlareDamage::Type                          DamageType;
+	UFlareSimulatedSpacecraft*                  DamageSource;
+
+	float GetInflictedDamageRatio() const
+	{
+		return StateBeforeDamage - StateAfterDamage;
+	}
+};
 
 /** Spacecraft damage system class */
 UCLASS()
@@ -110,6 +127,14 @@ public:
 	virtual float ApplyDamage(FFlareSpacecraftComponentDescription* ComponentDescription,
 							  FFlareSpacecraftComponentSave* ComponentData,
 							  float Energy, EFlareDamage::Type DamageType, UFlareSimulatedSpacecraft* DamageSource);
+
+	/** Apply damage to this component only, without touching anything outside of this spacecraft */
+	FFlareComponentDamage ApplyComponentDamage(FFlareSpacecraftComponentDescription* ComponentDescription,
+											   FFlareSpacecraftComponentSave* ComponentData,
+											   float Energy, EFlareDamage::Type DamageType, UFlareSimulatedSpacecraft* DamageSource);
+
+	/** Log the damage and apply reputation, retaliation and company value changes */
+	void ApplyDamageConsequences(const FFlareComponentDamage& Damage);
 	
 	bool IsPowered(FFlareSpacecraftComponentSave* ComponentToPowerData) const;
 
@@ -14,6 +14,9 @@
 
 #define LOCTEXT_NAMESPACE "FlareOrbitalMenu"
 
+// Time spent simulating days in each frame of a batched fast forward
+#define FAST_FORWARD_BATCH_FRAME_TIME 0.1
+
 
 /*----------------------------------------------------
 	Construct
@@ -30,6 +33,8 @@ void SFlareOrbitalMenu::Construct(const FArguments& InArgs)
 	// FF setup
 	FastForwardPeriod = 0.5f;
 	FastForwardStopRequested = false;
+	FastForwardBatchDays = 0;
+	FastForwardBatchDone = 0;
 
 	// Build structure
 	ChildSlot
@@ -158,6 +163,23 @@ void SFlareOrbitalMenu::Construct(const FArguments& InArgs)
 					.IsDisabled(this, &SFlareOrbitalMenu::IsFastForwardDisabled)
 					.HelpText(LOCTEXT("FastForwardInfo", "Wait for the next event - Travels, production, building will be accelerated"))
 				]
+
+				// Batched fast forward
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.HAlign(HAlign_Right)
+				.VAlign(VAlign_Top)
+				.Padding(Theme.SmallContentPadding)
+				[
+					SAssignNew(FastForwardBatch, SFlareButton)
+					.Width(4.5)
+					.Toggle(true)
+					.Text(this, &SFlareOrbitalMenu::GetFastForwardBatchText)
+					.Icon(FFlareStyleSet::GetIcon("FastForward"))
+					.OnClicked(this, &SFlareOrbitalMenu::OnFastForwardBatchClicked)
+					.IsDisabled(this, &SFlareOrbitalMenu::IsFastForwardBatchDisabled)
+					.HelpText(LOCTEXT("FastForwardBatchInfo", "Skip several days at once - Only military events will interrupt, other notifications are shown at the end"))
+				]
 			]
 		
 			// Planetarium body
@@ -385,14 +407,18 @@ void SFlareOrbitalMenu::StopFastForward()
 	TimeSinceFastForward = 0;
 	FastForwardStopRequested = false;
 	FastForwardAuto->SetActive(false);
+	FastForwardBatch->SetActive(false);
 
 	if (FastForwardActive)
 	{
 		FLOG("Stop fast forward");
 		FastForwardActive = false;
+		FastForwardBatchDays = 0;
+		FastForwardBatchDone = 0;
 		Game->SaveGame(MenuManager->GetPC(), true);
 		Game->ActivateCurrentSector();
 		OrbitalFleetsInfo->Update();
+		MenuManager->SetNotificationsDeferred(false);
 	}
 }
 
@@ -432,6 +458,14 @@ void SFlareOrbitalMenu::UpdateSectorBattleStates()
 	}
 }
 
+void SFlareOrbitalMenu::CheckSectorStateChanges()
+{
+	for (UFlareSimulatedSector* Sector : MenuManager->GetPC()->GetCompany()->GetKnownSectors())
+	{
+		MenuManager->GetPC()->CheckSectorStateChanges(Sector);
+	}
+}
+
 void SFlareOrbitalMenu::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
 {
 	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
@@ -442,12 +476,31 @@ void SFlareOrbitalMenu::Tick(const FGeometry& AllottedGeometry, const double InC
 		TimeSinceFastForward += InDeltaTime;
 		if (FastForwardActive)
 		{
-			for (UFlareSimulatedSector* Sector : MenuManager->GetPC()->GetCompany()->GetKnownSectors())
+			CheckSectorStateChanges();
+
+			if (FastForwardBatchDays > 0)
 			{
-				MenuManager->GetPC()->CheckSectorStateChanges(Sector);
-			}
+				// Simulate days back-to-back for a part of the frame, refresh the UI once
+				double StartTime = FPlatformTime::Seconds();
+				while (!FastForwardStopRequested && FastForwardBatchDone < FastForwardBatchDays
+					&& FPlatformTime::Seconds() - StartTime < FAST_FORWARD_BATCH_FRAME_TIME)
+				{
+					MenuManager->GetGame()->GetGameWorld()->FastForward();
+					FastForwardBatchDone++;
+
+					// Battles raise a military notification that stops the batch on the day they start
+					CheckSectorStateChanges();
+				}
+
+				TimeSinceFastForward = 0;
+				RefreshTrackedButtons();
 
-			if (!FastForwardStopRequested && (TimeSinceFastForward > FastForwardPeriod || UFlareGameTools::FastFastForward))
+				if (FastForwardBatchDone >= FastForwardBatchDays)
+				{
+					RequestStopFastForward();
+				}
+			}
+			else if (!FastForwardStopRequested && (TimeSinceFastForward > FastForwardPeriod || UFlareGameTools::FastFastForward))
 			{
 				MenuManager->GetGame()->GetGameWorld()->FastForward();
 				TimeSinceFastForward = 0;
@@ -702,7 +755,7 @@ const FSlateBrush* SFlareOrbitalMenu::GetFastForwardIcon() const
 
 bool SFlareOrbitalMenu::IsFastForwardDisabled() const
 {
-	if (IsEnabled())
+	if (IsEnabled() && FastForwardBatchDays == 0)
 	{
 		UFlareWorld* GameWorld = MenuManager->GetGame()->GetGameWorld();
 		
@@ -715,6 +768,37 @@ bool SFlareOrbitalMenu::IsFastForwardDisabled() const
 	return true;
 }
 
+FText SFlareOrbitalMenu::GetFastForwardBatchText() const
+{
+	if (!IsEnabled())
+	{
+		return FText();
+	}
+
+	if (FastForwardBatchDays > 0)
+	{
+		return FText::Format(LOCTEXT("FastForwardBatchProgressFormat", "Skipping... ({0} / {1})"),
+			FText::AsNumber(FastForwardBatchDone),
+			FText::AsNumber(FastForwardBatchDays));
+	}
+	else
+	{
+		return FText::Format(LOCTEXT("FastForwardBatchFormat", "Skip {0} days"),
+			FText::AsNumber(UFlareGameTools::FastForwardBatchDays));
+	}
+}
+
+bool SFlareOrbitalMenu::IsFastForwardBatchDisabled() const
+{
+	if (IsEnabled())
+	{
+		// Running batch can be stopped, automatic fast forward can't be turned into a batch
+		return FastForwardActive && FastForwardBatchDays == 0;
+	}
+
+	return true;
+}
+
 FText SFlareOrbitalMenu::GetDateText() const
 {
 	if (IsEnabled())
@@ -935,6 +1019,45 @@ void SFlareOrbitalMenu::OnFastForwardCanceled()
 	FastForwardAuto->SetActive(false);
 }
 
+void SFlareOrbitalMenu::OnFastForwardBatchClicked()
+{
+	if (FastForwardBatch->IsActive())
+	{
+		// Confirm and go on
+		bool CanGoAhead = MenuManager->GetPC()->ConfirmFastForward(FSimpleDelegate::CreateSP(this, &SFlareOrbitalMenu::OnFastForwardBatchConfirmed), FSimpleDelegate::CreateSP(this, &SFlareOrbitalMenu::OnFastForwardBatchCanceled), true);
+		if (CanGoAhead)
+		{
+			OnFastForwardBatchConfirmed();
+		}
+	}
+	else
+	{
+		RequestStopFastForward();
+	}
+}
+
+void SFlareOrbitalMenu::OnFastForwardBatchConfirmed()
+{
+	OnFastForwardConfirmed(true);
+
+	if (FastForwardActive)
+	{
+		FLOGV("Start batched fast forward of %d days", UFlareGameTools::FastForwardBatchDays);
+		FastForwardBatchDays = UFlareGameTools::FastForwardBatchDays;
+		FastForwardBatchDone = 0;
+		MenuManager->SetNotificationsDeferred(true);
+	}
+	else
+	{
+		FastForwardBatch->SetActive(false);
+	}
+}
+
+void SFlareOrbitalMenu::OnFastForwardBatchCanceled()
+{
+	FastForwardBatch->SetActive(false);
+}
+
 EVisibility SFlareOrbitalMenu::IsEventsVisible() const
 {
 	return ShowEventsButton->IsActive() ? EVisibility::Visible : EVisibility::Collapsed;
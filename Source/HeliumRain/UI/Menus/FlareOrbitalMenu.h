@@ -66,6 +66,9 @@ public:
 	void UpdateSectorBattleStates();
 	void UpdateSectorStates();
 
+	/** Notify battle state changes in known sectors, military notifications request a stop */
+	void CheckSectorStateChanges();
+
 	/** Get the display mode */
 	EFlareOrbitalMode::Type GetDisplayMode() const;
 
@@ -113,6 +116,12 @@ protected:
 	/** Visibility setting for the fast-forward feature */
 	bool IsFastForwardDisabled() const;
 
+	/** Get the text for the batched fast-forward, with its progress */
+	FText GetFastForwardBatchText() const;
+
+	/** Visibility setting for the batched fast-forward */
+	bool IsFastForwardBatchDisabled() const;
+
 	/** Get the current date */
 	FText GetDateText() const;
 
@@ -153,6 +162,15 @@ protected:
 	/** Cancel fast forward */
 	void OnFastForwardCanceled();
 
+	/** Check if we can fast forward several days */
+	void OnFastForwardBatchClicked();
+
+	/** Fast forward several days without stopping for events */
+	void OnFastForwardBatchConfirmed();
+
+	/** Cancel the batched fast forward */
+	void OnFastForwardBatchCanceled();
+
 protected:
 
 	/*----------------------------------------------------
@@ -171,6 +189,8 @@ protected:
 	bool                                        OrbitalFleetsUpdateRequested;
 	float                                       FastForwardPeriod;
 	float                                       TimeSinceFastForward;
+	int32                                       FastForwardBatchDays;
+	int32                                       FastForwardBatchDone;
 
 	TEnumAsByte<EFlareOrbitalMode::Type>        DisplayMode;
 	TEnumAsByte<EFlareOrbitalMode::Type>        PreviousDisplayMode;
@@ -182,6 +202,7 @@ protected:
 	TSharedPtr<SFlarePlanetaryBox>              HelaBox;
 	TSharedPtr<SFlarePlanetaryBox>              AdenaBox;
 	TSharedPtr<SFlareButton>                    FastForwardAuto;
+	TSharedPtr<SFlareButton>                    FastForwardBatch;
 	TSharedPtr<SFlareTradeRouteInfo>            TradeRouteInfo;
 	TSharedPtr<SFlareAutomatedFleetsInfo>       AutomatedFleetsInfo;
 	TSharedPtr<SFlareOrbitalFleetInfo>          OrbitalFleetsInfo;
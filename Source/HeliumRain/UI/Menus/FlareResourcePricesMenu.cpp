@@ -306,6 +306,7 @@ void SFlareResourcePricesMenu::Enter(UFlareSimulatedSector* Sector)
 	FLOG("SFlareResourcePricesMenu::Enter");
 	SetEnabled(true);
 	SetVisibility(EVisibility::Visible);
+	MenuManager->GetGame()->GetGameWorld()->InvalidateEconomySnapshot();
 
 	// Defaults
 	IsCurrentSortDescending = false;
@@ -334,7 +335,9 @@ void SFlareResourcePricesMenu::GenerateResourceList()
 		bool Result = false;
 
 		// Get sorting data
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(this->TargetSector, IncludeTradingHubsButton->IsActive());
+		UFlareWorld* World = this->MenuManager->GetGame()->GetGameWorld();
+		const WorldHelper::FlareResourceStats& Stats1 = World->GetSectorResourceStats(this->TargetSector, &R1.Data, IncludeTradingHubsButton->IsActive());
+		const WorldHelper::FlareResourceStats& Stats2 = World->GetSectorResourceStats(this->TargetSector, &R2.Data, IncludeTradingHubsButton->IsActive());
 		int64 ResourcePrice1 = this->TargetSector->GetResourcePrice(&R1.Data, EFlareResourcePriceContext::Default);
 		int64 ResourcePrice2 = this->TargetSector->GetResourcePrice(&R2.Data, EFlareResourcePriceContext::Default);
 		int64 LastResourcePrice1 = this->TargetSector->GetResourcePrice(&R1.Data, EFlareResourcePriceContext::Default, 30);
@@ -349,16 +352,16 @@ void SFlareResourcePricesMenu::GenerateResourceList()
 			Result = R1.Data.DisplayIndex > R2.Data.DisplayIndex;
 			break;
 		case EFlareEconomySort::ES_Production:
-			Result = (Stats[&R1.Data].Production > Stats[&R2.Data].Production);
+			Result = (Stats1.Production > Stats2.Production);
 			break;
 		case EFlareEconomySort::ES_Consumption:
-			Result = (Stats[&R1.Data].Consumption > Stats[&R2.Data].Consumption);
+			Result = (Stats1.Consumption > Stats2.Consumption);
 			break;
 		case EFlareEconomySort::ES_Stock:
-			Result = (Stats[&R1.Data].Stock > Stats[&R2.Data].Stock);
+			Result = (Stats1.Stock > Stats2.Stock);
 			break;
 		case EFlareEconomySort::ES_Needs:
-			Result = (Stats[&R1.Data].Capacity > Stats[&R2.Data].Capacity);
+			Result = (Stats1.Capacity > Stats2.Capacity);
 			break;
 		case EFlareEconomySort::ES_Price:
 			Result = ResourcePrice1 > ResourcePrice2;
@@ -637,9 +640,9 @@ FText SFlareResourcePricesMenu::GetResourceProductionInfo(FFlareResourceDescript
 		FNumberFormattingOptions Format;
 		Format.MaximumFractionalDigits = 1;
 
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(TargetSector, IncludeTradingHubsButton->IsActive());
+		const WorldHelper::FlareResourceStats& Stats = MenuManager->GetGame()->GetGameWorld()->GetSectorResourceStats(TargetSector, Resource, IncludeTradingHubsButton->IsActive());
 		return FText::Format(LOCTEXT("ResourceMainProductionFormat", "{0}"),
-			FText::AsNumber(Stats[Resource].Production, &Format));
+			FText::AsNumber(Stats.Production, &Format));
 	}
 
 	return FText();
@@ -652,9 +655,9 @@ FText SFlareResourcePricesMenu::GetResourceConsumptionInfo(FFlareResourceDescrip
 		FNumberFormattingOptions Format;
 		Format.MaximumFractionalDigits = 1;
 
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(TargetSector, IncludeTradingHubsButton->IsActive());
+		const WorldHelper::FlareResourceStats& Stats = MenuManager->GetGame()->GetGameWorld()->GetSectorResourceStats(TargetSector, Resource, IncludeTradingHubsButton->IsActive());
 		return FText::Format(LOCTEXT("ResourceMainConsumptionFormat", "{0}"),
-			FText::AsNumber(Stats[Resource].Consumption, &Format));
+			FText::AsNumber(Stats.Consumption, &Format));
 	}
 
 	return FText();
@@ -664,9 +667,9 @@ FText SFlareResourcePricesMenu::GetResourceStockInfo(FFlareResourceDescription*
 {
 	if (TargetSector)
 	{
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(TargetSector, IncludeTradingHubsButton->IsActive());
+		const WorldHelper::FlareResourceStats& Stats = MenuManager->GetGame()->GetGameWorld()->GetSectorResourceStats(TargetSector, Resource, IncludeTradingHubsButton->IsActive());
 		return FText::Format(LOCTEXT("ResourceMainStockFormat", "{0}"),
-			FText::AsNumber(Stats[Resource].Stock));
+			FText::AsNumber(Stats.Stock));
 	}
 
 	return FText();
@@ -678,9 +681,9 @@ FText SFlareResourcePricesMenu::GetResourceCapacityInfo(FFlareResourceDescriptio
 	if (TargetSector)
 	{
 
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(TargetSector, IncludeTradingHubsButton->IsActive());
+		const WorldHelper::FlareResourceStats& Stats = MenuManager->GetGame()->GetGameWorld()->GetSectorResourceStats(TargetSector, Resource, IncludeTradingHubsButton->IsActive());
 		return FText::Format(LOCTEXT("ResourceMainCapacityFormat", "{0}"),
-			FText::AsNumber(Stats[Resource].Capacity));
+			FText::AsNumber(Stats.Capacity));
 	}
 
 	return FText();
@@ -1347,6 +1347,7 @@ void SFlareWorldEconomyMenu::Enter(FFlareResourceDescription* Resource, UFlareSi
 	FLOG("SFlareWorldEconomyMenu::Enter");
 	SetEnabled(true);
 	SetVisibility(EVisibility::Visible);
+	MenuManager->GetGame()->GetGameWorld()->InvalidateEconomySnapshot();
 
 	if (Resource)
 	{
@@ -1362,8 +1363,6 @@ void SFlareWorldEconomyMenu::Enter(FFlareResourceDescription* Resource, UFlareSi
 		CompanyList.Add(Company);
 	}
 
-	WorldStats = WorldHelper::ComputeWorldResourceStats(MenuManager->GetGame(), IncludeTradingHubsButton->IsActive());
-
 	// Update resource selector
 	ResourceSelector->RefreshOptions();
 	StationResourceSelector->RefreshOptions();
@@ -1587,8 +1586,9 @@ void SFlareWorldEconomyMenu::GenerateSectorList()
 		bool Result = false;
 
 		// Get sorting data
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats1 = SectorHelper::ComputeSectorResourceStats(&S1, IncludeTradingHubsButton->IsActive());
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats2 = SectorHelper::ComputeSectorResourceStats(&S2, IncludeTradingHubsButton->IsActive());
+		UFlareWorld* World = this->MenuManager->GetGame()->GetGameWorld();
+		const WorldHelper::FlareResourceStats& Stats1 = World->GetSectorResourceStats(&S1, this->TargetResource, IncludeTradingHubsButton->IsActive());
+		const WorldHelper::FlareResourceStats& Stats2 = World->GetSectorResourceStats(&S2, this->TargetResource, IncludeTradingHubsButton->IsActive());
 		int64 ResourcePrice1 = S1.GetResourcePrice(TargetResource, EFlareResourcePriceContext::Default);
 		int64 ResourcePrice2 = S2.GetResourcePrice(TargetResource, EFlareResourcePriceContext::Default);
 		int64 LastResourcePrice1 = S1.GetResourcePrice(TargetResource, EFlareResourcePriceContext::Default, 30);
@@ -1603,16 +1603,16 @@ void SFlareWorldEconomyMenu::GenerateSectorList()
 			Result = S1.GetSectorName().ToString() > S2.GetSectorName().ToString();
 			break;
 		case EFlareEconomySort::ES_Production:
-			Result = (Stats1[this->TargetResource].Production > Stats2[this->TargetResource].Production);
+			Result = (Stats1.Production > Stats2.Production);
 			break;
 		case EFlareEconomySort::ES_Consumption:
-			Result = (Stats1[this->TargetResource].Consumption > Stats2[this->TargetResource].Consumption);
+			Result = (Stats1.Consumption > Stats2.Consumption);
 			break;
 		case EFlareEconomySort::ES_Stock:
-			Result = (Stats1[this->TargetResource].Stock > Stats2[this->TargetResource].Stock);
+			Result = (Stats1.Stock > Stats2.Stock);
 			break;
 		case EFlareEconomySort::ES_Needs:
-			Result = (Stats1[this->TargetResource].Capacity > Stats2[this->TargetResource].Capacity);
+			Result = (Stats1.Capacity > Stats2.Capacity);
 			break;
 		case EFlareEconomySort::ES_Price:
 			Result = ResourcePrice1 > ResourcePrice2;
@@ -1985,40 +1985,39 @@ FText SFlareWorldEconomyMenu::GetResourceInfo() const
 {
 	if (TargetResource)
 	{
-		if (WorldStats.Contains(TargetResource))
-		{
-			FNumberFormattingOptions Format;
-			Format.MaximumFractionalDigits = 1;
+		const WorldHelper::FlareResourceStats& WorldStats = MenuManager->GetGame()->GetGameWorld()->GetWorldResourceStats(TargetResource, IncludeTradingHubsButton->IsActive());
 
-			// Balance info
-			FText BalanceText;
-			float Balance = WorldStats[TargetResource].Balance;
-			if (Balance > 0)
-			{
-				BalanceText = FText::Format(LOCTEXT("BalanceInfoPlusFormat", "+{0} / day"),
-					FText::AsNumber(Balance, &Format));
-			}
-			else
-			{
-				BalanceText = FText::Format(LOCTEXT("BalanceInfoNegFormat", "{0} / day"),
-					FText::AsNumber(Balance, &Format));
-			}
-			
-			FText Part1 = FText::Format(LOCTEXT("StockInfoFormatPart1", "\u2022Transport fee: {0} credits\n\u2022 Worldwide stock: {1}\n\u2022 Worldwide needs: {2}\n"),
-										UFlareGameTools::DisplayMoney(TargetResource->TransportFee),
-										FText::AsNumber(WorldStats[TargetResource].Stock),
-										FText::AsNumber(WorldStats[TargetResource].Capacity));
-			FText Part2 = FText::Format(LOCTEXT("StockInfoFormatPart2", "\u2022 Worldwide production: {0} / day\n\u2022 Worldwide usage: {1} / day\n"),
-										FText::AsNumber(WorldStats[TargetResource].Production, &Format),
-										FText::AsNumber(WorldStats[TargetResource].Consumption, &Format));
-
-			// Generate info
-			return FText::Format(LOCTEXT("StockInfoFormat",
-					"{0}{1}\u2022 Balance: {2}"),
-				Part1,
-				Part2,
-				BalanceText);
+		FNumberFormattingOptions Format;
+		Format.MaximumFractionalDigits = 1;
+
+		// Balance info
+		FText BalanceText;
+		float Balance = WorldStats.Balance;
+		if (Balance > 0)
+		{
+			BalanceText = FText::Format(LOCTEXT("BalanceInfoPlusFormat", "+{0} / day"),
+				FText::AsNumber(Balance, &Format));
 		}
+		else
+		{
+			BalanceText = FText::Format(LOCTEXT("BalanceInfoNegFormat", "{0} / day"),
+				FText::AsNumber(Balance, &Format));
+		}
+		
+		FText Part1 = FText::Format(LOCTEXT("StockInfoFormatPart1", "\u2022Transport fee: {0} credits\n\u2022 Worldwide stock: {1}\n\u2022 Worldwide needs: {2}\n"),
+									UFlareGameTools::DisplayMoney(TargetResource->TransportFee),
+									FText::AsNumber(WorldStats.Stock),
+									FText::AsNumber(WorldStats.Capacity));
+		FText Part2 = FText::Format(LOCTEXT("StockInfoFormatPart2", "\u2022 Worldwide production: {0} / day\n\u2022 Worldwide usage: {1} / day\n"),
+									FText::AsNumber(WorldStats.Production, &Format),
+									FText::AsNumber(WorldStats.Consumption, &Format));
+
+		// Generate info
+		return FText::Format(LOCTEXT("StockInfoFormat",
+				"{0}{1}\u2022 Balance: {2}"),
+			Part1,
+			Part2,
+			BalanceText);
 	}
 
 	return FText();
@@ -2106,9 +2105,9 @@ FText SFlareWorldEconomyMenu::GetResourceProductionInfo(UFlareSimulatedSector* S
 		FNumberFormattingOptions Format;
 		Format.MaximumFractionalDigits = 1;
 
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(Sector, IncludeTradingHubsButton->IsActive());
+		const WorldHelper::FlareResourceStats& Stats = MenuManager->GetGame()->GetGameWorld()->GetSectorResourceStats(Sector, TargetResource, IncludeTradingHubsButton->IsActive());
 		return FText::Format(LOCTEXT("ResourceMainProductionFormat", "{0}"),
-			FText::AsNumber(Stats[TargetResource].Production, &Format));
+			FText::AsNumber(Stats.Production, &Format));
 	}
 
 	return FText();
@@ -2121,9 +2120,9 @@ FText SFlareWorldEconomyMenu::GetResourceConsumptionInfo(UFlareSimulatedSector*
 		FNumberFormattingOptions Format;
 		Format.MaximumFractionalDigits = 1;
 
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(Sector, IncludeTradingHubsButton->IsActive());
+		const WorldHelper::FlareResourceStats& Stats = MenuManager->GetGame()->GetGameWorld()->GetSectorResourceStats(Sector, TargetResource, IncludeTradingHubsButton->IsActive());
 		return FText::Format(LOCTEXT("ResourceMainConsumptionFormat", "{0}"),
-			FText::AsNumber(Stats[TargetResource].Consumption, &Format));
+			FText::AsNumber(Stats.Consumption, &Format));
 	}
 
 	return FText();
@@ -2133,9 +2132,9 @@ FText SFlareWorldEconomyMenu::GetResourceStockInfo(UFlareSimulatedSector* Sector
 {
 	if (TargetResource)
 	{
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(Sector, IncludeTradingHubsButton->IsActive());
+		const WorldHelper::FlareResourceStats& Stats = MenuManager->GetGame()->GetGameWorld()->GetSectorResourceStats(Sector, TargetResource, IncludeTradingHubsButton->IsActive());
 		return FText::Format(LOCTEXT("ResourceMainStockFormat", "{0}"),
-			FText::AsNumber(Stats[TargetResource].Stock));
+			FText::AsNumber(Stats.Stock));
 	}
 
 	return FText();
@@ -2147,9 +2146,9 @@ FText SFlareWorldEconomyMenu::GetResourceCapacityInfo(UFlareSimulatedSector* Sec
 	if (TargetResource)
 	{
 
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(Sector, IncludeTradingHubsButton->IsActive());
+		const WorldHelper::FlareResourceStats& Stats = MenuManager->GetGame()->GetGameWorld()->GetSectorResourceStats(Sector, TargetResource, IncludeTradingHubsButton->IsActive());
 		return FText::Format(LOCTEXT("ResourceMainCapacityFormat", "{0}"),
-			FText::AsNumber(Stats[TargetResource].Capacity));
+			FText::AsNumber(Stats.Capacity));
 	}
 
 	return FText();
@@ -2363,7 +2362,6 @@ void SFlareWorldEconomyMenu::OnOpenSectorPrices(UFlareSimulatedSector* Sector)
 void SFlareWorldEconomyMenu::OnIncludeTradingHubsToggle()
 {
 	GenerateSectorList();
-	WorldStats = WorldHelper::ComputeWorldResourceStats(MenuManager->GetGame(), IncludeTradingHubsButton->IsActive());
 }
 
 #undef LOCTEXT_NAMESPACE
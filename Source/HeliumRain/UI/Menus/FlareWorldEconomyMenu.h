@@ -202,8 +202,6 @@ protected:
 	TArray<UFlareCompany*>						    TargetCompanies;
 	TSharedPtr<STextBlock>						    SelectedCompaniesText;
 
-	TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> WorldStats;
-
 	// Slate data
 	TSharedPtr<SVerticalBox>                        SectorList;
 	TSharedPtr<SVerticalBox>                        SectorPopList;